@@ -32,6 +32,7 @@
 #include "duckdb/function/scalar_function.hpp"
 #include <duckdb/parser/parsed_data/create_scalar_function_info.hpp>
 #include "PixelsReader.h"
+#include "pixels-common/pixels.pb.h"
 
 
 namespace duckdb
@@ -42,7 +43,13 @@ namespace duckdb
         std::shared_ptr <PixelsReader> initialPixelsReader;
         std::shared_ptr <TypeDescription> fileSchema;
         vector <string> files;
-        atomic <int> curFileId;
+        // the file tail of each file, nullptr if it can not be read
+        vector <std::shared_ptr<pixels::proto::FileTail>> fileTails;
+        // the sum of the number of rows of the files
+        idx_t totalRows;
+        // the number of row groups of each file, -1 if it is unknown
+        vector<int> fileRGNums;
+        atomic <int> curMorselId;
     };
 
 }
@@ -32,6 +32,7 @@
 #include <duckdb/parser/parsed_data/create_scalar_function_info.hpp>
 #include "PixelsReader.h"
 #include "physical/StorageArrayScheduler.h"
+#include <thread>
 
 namespace duckdb
 {
@@ -52,11 +53,9 @@ namespace duckdb
         //! Signal to other threads that a file failed to open, letting every thread abort.
         bool error_opening_file = false;
 
+        //! Hands out the morsels, i.e., the row group ranges of the files, to the threads
         std::shared_ptr <StorageArrayScheduler> storageArrayScheduler;
 
-        //! Index of file currently up for scanning
-        vector <idx_t> file_index;
-
         //! Batch index of the next row group to be scanned
         idx_t batch_index;
 
@@ -64,6 +63,21 @@ namespace duckdb
 
         TableFilterSet *filters;
 
+        //! Prefetches the row group footers into the footer cache while the scan runs
+        std::thread footer_prefetch_thread;
+
+        //! Stops the footer prefetch when the scan ends before it
+        std::atomic<bool> footer_prefetch_cancelled{false};
+
+        ~PixelsReadGlobalState() override
+        {
+            footer_prefetch_cancelled = true;
+            if (footer_prefetch_thread.joinable())
+            {
+                footer_prefetch_thread.join();
+            }
+        }
+
         idx_t MaxThreads() const override
         {
             return max_threads;
@@ -32,28 +32,39 @@
 #include <duckdb/parser/parsed_data/create_scalar_function_info.hpp>
 #include "PixelsReader.h"
 #include "reader/PixelsRecordReader.h"
+#include "reader/FilterColumnStat.h"
+#include <deque>
 
 namespace duckdb
 {
 
+    //! A morsel whose reader is opened and whose row groups are being read ahead
+    struct PixelsReadAheadMorsel
+    {
+        std::shared_ptr <PixelsReader> reader;
+        std::shared_ptr <PixelsRecordReader> recordReader;
+        std::string file_name;
+        idx_t batch_index;
+        //! the BufferPool buffer the morsel is read into
+        int buffer_id;
+    };
+
     struct PixelsReadLocalState : public LocalTableFunctionState
     {
         PixelsReadLocalState()
         {
-            curr_file_index = 0;
-            next_file_index = 0;
             curr_batch_index = 0;
-            next_batch_index = 0;
+            curr_buffer_id = -1;
+            read_ahead_depth = 1;
+            read_ahead_max_depth = 1;
+            read_ahead_ready_num = 0;
             rowOffset = 0;
             currPixelsRecordReader = nullptr;
-            nextPixelsRecordReader = nullptr;
             vectorizedRowBatch = nullptr;
             currReader = nullptr;
-            nextReader = nullptr;
         }
 
         std::shared_ptr <PixelsRecordReader> currPixelsRecordReader;
-        std::shared_ptr <PixelsRecordReader> nextPixelsRecordReader;
         // this is used for storing row batch results.
         std::shared_ptr <VectorizedRowBatch> vectorizedRowBatch;
         int deviceID;
@@ -61,13 +72,20 @@ namespace duckdb
         vector <column_t> column_ids;
         vector <string> column_names;
         std::shared_ptr <PixelsReader> currReader;
-        std::shared_ptr <PixelsReader> nextReader;
-        idx_t curr_file_index;
-        idx_t next_file_index;
         idx_t curr_batch_index;
-        idx_t next_batch_index;
-        std::string next_file_name;
         std::string curr_file_name;
+        int curr_buffer_id;
+        //! the morsels read ahead of the current one, in the order they are scanned
+        std::deque <PixelsReadAheadMorsel> read_ahead_morsels;
+        //! the BufferPool buffers that hold neither the current morsel nor a morsel read ahead
+        std::vector<int> free_buffer_ids;
+        //! the number of morsels to keep in flight, adapted to how long the scan waits for them
+        int read_ahead_depth;
+        int read_ahead_max_depth;
+        //! the number of consecutive morsels that were read completely before they were scanned
+        int read_ahead_ready_num;
+        //! the order of the filter columns learned by the record readers of the morsels of this thread
+        std::shared_ptr <FilterColumnStats> filter_column_stats;
     };
 
 }
@@ -49,6 +49,7 @@
 #include "physical/StorageFactory.h"
 #include "PixelsReaderImpl.h"
 #include "PixelsReaderBuilder.h"
+#include "PixelsFooterPrefetcher.h"
 #include <iostream>
 #include <future>
 #include <thread>
@@ -118,7 +119,8 @@ namespace duckdb
                                             bool is_init_state = false);
 
         static PixelsReaderOption
-        GetPixelsReaderOption(PixelsReadLocalState &local_state, PixelsReadGlobalState &global_state);
+        GetPixelsReaderOption(PixelsReadLocalState &local_state, PixelsReadGlobalState &global_state,
+                              const StorageArrayScheduler::Morsel &morsel, const std::shared_ptr<PixelsReader> &reader);
 
     private:
         static void TransformDuckdbType(const std::shared_ptr <TypeDescription> &type,
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_FOOTERINDEXEXECUTOR_H
+#define PIXELS_FOOTERINDEXEXECUTOR_H
+
+#include <executor/CommandExecutor.h>
+
+/**
+ * Build or update the footer index of a directory of pxl files, which the scans read but never write.
+ */
+class FooterIndexExecutor : public CommandExecutor
+{
+public:
+    void execute(const bpo::variables_map &ns, const std::string &command) override;
+};
+#endif //PIXELS_FOOTERINDEXEXECUTOR_H
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include <executor/FooterIndexExecutor.h>
+#include <PixelsFooterIndex.h>
+#include <chrono>
+#include <iostream>
+
+void FooterIndexExecutor::execute(const bpo::variables_map &ns, const std::string &command)
+{
+    std::string directory = ns["directory"].as<std::string>();
+
+    auto startTime = std::chrono::system_clock::now();
+    if (PixelsFooterIndex::build(directory))
+    {
+        std::cout << command << " is successful" << std::endl;
+    }
+    else
+    {
+        std::cout << command << " failed" << std::endl;
+    }
+    auto endTime = std::chrono::system_clock::now();
+    std::chrono::duration<double> elapsedSeconds = endTime - startTime;
+    std::cout << "The footer index of " << directory << " is built in "
+              << elapsedSeconds.count() << " seconds." << std::endl;
+}
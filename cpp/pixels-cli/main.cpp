@@ -28,6 +28,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/program_options.hpp>
 #include <executor/LoadExecutor.h>
+#include <executor/FooterIndexExecutor.h>
 
 namespace bpo = boost::program_options;
 
@@ -74,7 +75,8 @@ int main()
                       "STAT\n" <<
                       "QUERY\n" <<
                       "COPY\n" <<
-                      "FILE_META\n";
+                      "FILE_META\n" <<
+                      "FOOTER_INDEX\n";
             std::cout << "{command} -h to show the usage of a command.\nexit / quit / -q to exit.\n";
             continue;
         }
@@ -132,6 +134,33 @@ int main()
             loadExecutor->execute(vm, command);
             // } catch
         }
+        else if (command == "FOOTER_INDEX")
+        {
+            bpo::options_description desc("Pixels FOOTER_INDEX");
+            desc.add_options()
+                    ("help,h", "show this help message and exit")
+                    ("directory,d", bpo::value<std::string>()->required(),
+                     "specify the directory of the pxl files to build or update the footer index of");
+
+            bpo::variables_map vm;
+            try
+            {
+                bpo::store(bpo::parse_command_line(argv.size(), argv.data(), desc), vm);
+                if (vm.count("help"))
+                {
+                    std::cout << desc << std::endl;
+                    continue;
+                }
+                bpo::notify(vm);
+            }
+            catch (const bpo::error &e)
+            {
+                std::cerr << "Error parsing options: " << e.what() << "\n";
+                continue;
+            }
+            FooterIndexExecutor footerIndexExecutor;
+            footerIndexExecutor.execute(vm, command);
+        }
         else if (command == "QUERY")
         {
             std::cout << "Not implemented yet." << std::endl;
@@ -123,9 +123,19 @@ public:
         }
     };
 
-    static void Initialize(std::vector<uint32_t> colIds,
+    /**
+     * Prepare the current buffer for the chunks of a row group. The buffer is taken from the
+     * BufferPoolArena when the first row group is read into it, and taken again if a row group
+     * does not fit in it, sized from the chunks of that row group.
+     * @param bytes the length of the chunk of each column
+     * @param mayWait whether to wait for the other scans if the memory budget is used up
+     * @return false if the buffer has to be taken from the arena and mayWait is false but the
+     * memory budget is used up, in which case the row group must not be read
+     */
+    static bool Initialize(std::vector<uint32_t> colIds,
                            std::vector<uint64_t> bytes,
-                           std::vector<std::string> columnNames);
+                           std::vector<std::string> columnNames,
+                           bool mayWait = true);
 
     static void InitializeBuffers();
 
@@ -134,14 +144,59 @@ public:
 
     static int64_t GetBufferId();
 
+    /**
+     * @return the number of buffers of each thread, which is one more than the number of row
+     * groups a scan thread may read ahead. It is 2 if pixels.readahead.enabled is false, and
+     * otherwise pixels.readahead.depth + 1 and at least 2. The buffers only take memory from the
+     * BufferPoolArena when a row group is read into them or they are reserved.
+     */
+    static int GetBufferCount();
+
+    /**
+     * Take the memory of a buffer from the BufferPoolArena before a row group is read into it,
+     * as much as the largest buffer of this thread, without waiting for the other scans.
+     * @return true if the buffer has its memory, false if the memory budget is used up
+     */
+    static bool Reserve(int bufferId);
+
     static void Switch();
 
+    /**
+     * Make the buffer the current one, into which the next row group is read.
+     */
+    static void Switch(int bufferId);
+
     static void Reset();
 
+    /**
+     * Drop the buffers of this thread, so that their memory goes back to the BufferPoolArena
+     * for the other scans. The buffers must no longer be registered to the io_uring of the
+     * thread. The next Initialize allocates the buffers again.
+     */
+    static void Release();
+
+    /**
+     * Drop the memory of one buffer of this thread, e.g., a buffer that no morsel is read into
+     * while the memory budget is used up. It is taken again by the next Initialize of the buffer.
+     */
+    static void Release(int bufferId);
+
     static std::shared_ptr<BufferPoolEntry> AddNewBuffer(size_t size);
 
+    /**
+     * @return the bytes a chunk of this many bytes takes in a buffer, with the slices that
+     * let the column readers read past its end
+     */
+    static size_t GetSliceSize(uint64_t byte, const std::string &columnName);
+
     static int getRingIndex(uint32_t colId);
 
+    /**
+     * @return the index of the buffer that the column is read into in the registered
+     * buffer table of the io_uring, i.e., the buffer index of its read requests
+     */
+    static int getBufferIndex(uint32_t colId);
+
     static std::shared_ptr<ByteBuffer> AllocateNewBuffer(
         std::shared_ptr<BufferPoolManagedEntry> currentBufferManagedEntry,
         uint32_t colId, uint64_t byte, std::string columnName);
@@ -161,15 +216,13 @@ public:
                std::hash<std::thread::id>{}(tid), globalUsedSize,
                globalFreeSize);
 
-        // Print thread-local statistics for Buffer0
-        printf("Thread %zu -> Buffer0 usage: %zu, Buffer count: %d\n",
-               std::hash<std::thread::id>{}(tid), threadLocalUsedSize[0],
-               threadLocalBufferCount[0]);
-
-        // Print thread-local statistics for Buffer1
-        printf("Thread %zu -> Buffer1 usage: %zu, Buffer count: %d\n",
-               std::hash<std::thread::id>{}(tid), threadLocalUsedSize[1],
-               threadLocalBufferCount[1]);
+        // Print thread-local statistics for each buffer
+        for (size_t idx = 0; idx < threadLocalUsedSize.size(); idx++)
+        {
+            printf("Thread %zu -> Buffer%zu usage: %zu, Buffer count: %d\n",
+                   std::hash<std::thread::id>{}(tid), idx, threadLocalUsedSize[idx],
+                   threadLocalBufferCount[idx]);
+        }
     }
 private:
     BufferPool() = default;
@@ -178,26 +231,27 @@ private:
 
     // thread local
     static thread_local bool isInitialized;
-    static thread_local std::vector<std::shared_ptr<BufferPoolEntry>>
-    registeredBuffers[2];
+    static thread_local std::vector<std::vector<std::shared_ptr<BufferPoolEntry>>>
+    registeredBuffers;
     static thread_local long globalUsedSize;
     static thread_local long globalFreeSize;
     static thread_local std::shared_ptr<DirectIoLib> directIoLib;
-    static thread_local int nextRingIndex;
-    static thread_local std::shared_ptr<BufferPoolEntry>
-    nextEmptyBufferPoolEntry[2];
+    // the index in the registered buffer table of the next buffer added to the pool,
+    // the first GetBufferCount() indexes are taken by the first buffer of each buffer id
+    static thread_local int nextBufferIndex;
+    static thread_local std::vector<std::shared_ptr<BufferPoolEntry>>
+    nextEmptyBufferPoolEntry;
     static thread_local int colCount;
     static thread_local int currBufferIdx;
-    static thread_local int nextBufferIdx;
-    static thread_local std::map<uint32_t, std::shared_ptr<ByteBuffer>>
-    buffersAllocated[2];
+    static thread_local std::vector<std::map<uint32_t, std::shared_ptr<ByteBuffer>>>
+    buffersAllocated;
     friend class DirectUringRandomAccessFile;
 
-    static thread_local std::unordered_map<
-        uint32_t, std::shared_ptr<BufferPoolManagedEntry>>
-    ringBufferMap[2];
+    static thread_local std::vector<std::unordered_map<
+        uint32_t, std::shared_ptr<BufferPoolManagedEntry>>>
+    ringBufferMap;
 
-    static thread_local size_t threadLocalUsedSize[2];
-    static thread_local int threadLocalBufferCount[2];
+    static thread_local std::vector<size_t> threadLocalUsedSize;
+    static thread_local std::vector<int> threadLocalBufferCount;
 };
 #endif // DUCKDB_BUFFERPOOL_H
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_BUFFERPOOLARENA_H
+#define PIXELS_BUFFERPOOLARENA_H
+
+#include "physical/natives/ByteBuffer.h"
+#include "physical/natives/DirectIoLib.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * The memory of the BufferPool buffers of all the scan threads in the process, bounded by a byte
+ * budget. The memory is allocated in aligned slabs, whose sizes are rounded up to size classes
+ * so that a slab released by one scan can be reused by another. A thread keeps a few released
+ * slabs of each size class in its magazine and takes them back without locking. When the budget
+ * is used up, the slabs idle in the magazines of all the threads are moved to the free lists and
+ * the idle slabs of the other size classes are freed, and if that is not enough the allocation
+ * waits for other scans to release their slabs.
+ */
+class BufferPoolArena : public std::enable_shared_from_this<BufferPoolArena>
+{
+public:
+    // the smallest size class, the classes are powers of two and three quarter steps between them
+    static constexpr size_t MIN_CLASS_SHIFT = 20;
+    static constexpr size_t MIN_CLASS_SIZE = 1UL << MIN_CLASS_SHIFT;
+    // the released slabs of each size class kept by a thread
+    static constexpr size_t MAGAZINE_SIZE = 2;
+
+    static std::shared_ptr<BufferPoolArena> Instance();
+
+    /**
+     * @param budget the bytes of the slabs allocated, in use or idle
+     * @param waitMillis the interval at which a waiting allocation looks for idle slabs in the
+     * magazines again, as a slab released into a magazine does not wake it up
+     * @param blockSize the alignment of the slabs
+     */
+    BufferPoolArena(size_t budget, long waitMillis, int blockSize);
+
+    /**
+     * @return a buffer of size bytes in a slab of the arena, which goes back to the arena when
+     * the buffer is released. It waits until other scans release enough slabs if the budget is
+     * used up, and only throws if the buffer is larger than the whole budget.
+     */
+    std::shared_ptr<ByteBuffer> allocate(size_t size);
+
+    /**
+     * @return a buffer like allocate, or nullptr if the budget is used up, without waiting
+     */
+    std::shared_ptr<ByteBuffer> tryAllocate(size_t size);
+
+    static size_t getClassSize(size_t size);
+
+    size_t getBudget() const;
+
+    // the bytes of the slabs allocated, in use or idle
+    size_t getReservedBytes();
+
+    // the number of allocations waiting for other scans to release their slabs
+    int getWaiterNum() const;
+
+private:
+    // the size classes up to 2^64 bytes, one below MIN_CLASS_SIZE and four in each power of two
+    static constexpr int CLASS_NUM = 1 + 4 * (64 - MIN_CLASS_SHIFT);
+
+    struct CachedSlab
+    {
+        std::shared_ptr<ByteBuffer> slab;
+        size_t classSize;
+    };
+
+    struct Magazine
+    {
+        std::shared_ptr<BufferPoolArena> arena;
+        // only the owner thread puts a slab into an empty slot, the owner thread and the threads
+        // draining the magazine take the slabs by exchanging the slots with nullptr
+        std::array<std::atomic<CachedSlab *>, CLASS_NUM * MAGAZINE_SIZE> slots{};
+
+        ~Magazine();
+    };
+
+    std::shared_ptr<ByteBuffer> allocate(size_t size, bool mayWait);
+
+    void release(std::shared_ptr<ByteBuffer> slab, size_t classSize);
+
+    static int getClassIndex(size_t classSize);
+
+    // take a slab of the size class from the magazine of this thread, or nullptr
+    std::shared_ptr<ByteBuffer> takeFromMagazine(size_t classSize);
+
+    // move the slabs of a magazine to the free lists, called with the lock of the arena held. It
+    // returns true if any slab was moved
+    bool flushMagazine(Magazine &magazine);
+
+    // move the slabs of the magazines of all the threads to the free lists, called with the lock
+    // of the arena held. It returns true if any slab was moved
+    bool drainMagazines();
+
+    // free the idle slabs of the other size classes until there is room for classSize bytes,
+    // called with the lock held
+    bool trimFor(size_t classSize);
+
+    static thread_local Magazine magazine;
+    // set when the magazine of this thread is destroyed, the buffers released later on thread
+    // exit go to the free lists
+    static thread_local bool isMagazineClosed;
+
+    const size_t budget;
+    const long waitMillis;
+    std::shared_ptr<DirectIoLib> directIoLib;
+    std::mutex mutex;
+    std::condition_variable released;
+    size_t reservedBytes;
+    std::atomic<int> waiters;
+    // the idle slabs by their size class
+    std::map<size_t, std::vector<std::shared_ptr<ByteBuffer>>> freeSlabs;
+    // the magazines of the threads that have released a slab of this arena into their magazine
+    std::unordered_set<Magazine *> magazines;
+};
+#endif // PIXELS_BUFFERPOOLARENA_H
@@ -36,6 +36,8 @@ public:
     explicit BufferPoolEntry(size_t size, int slice_size,
                              std::shared_ptr<DirectIoLib> directLib, int offset,
                              int ringIndex);
+    // an entry of the memory already taken from the arena
+    BufferPoolEntry(std::shared_ptr<ByteBuffer> buffer, int offset, int ringIndex);
     size_t getSize() const;
     std::shared_ptr<Bitmap> getBitmap() const;
     std::shared_ptr<ByteBuffer> getBuffer() const;
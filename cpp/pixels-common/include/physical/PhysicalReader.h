@@ -44,6 +44,11 @@ public:
 //    virtual void readFully(char * buffer, int offset, int length) = 0;
     virtual std::string getName() = 0;
 
+    /**
+     * @return the path of the file, which identifies the file in the process
+     */
+    virtual std::string getPath() = 0;
+
     /**
      * If direct I/O is supported, {@link #readFully(int)} will directly read from the file
      * without going through the OS cache. This is currently supported on LocalFS.
@@ -30,32 +30,65 @@
 #define DUCKDB_STORAGEARRAYSCHEDULER_H
 
 #include "utils/ConfigFactory.h"
+#include <deque>
 #include <vector>
 #include <mutex>
 #include <unordered_map>
 
+/**
+ * Hands out the row groups of the files to the scan threads. The files are split into morsels of
+ * a few row groups, and the morsels of the files on each storage device are kept in a queue of
+ * the device. Each thread takes the morsels from the queue of its own device in order, and steals
+ * the last morsels of the device with the most remaining morsels once its own queue is empty, so
+ * that no thread sits idle while another device still has work.
+ */
 class StorageArrayScheduler
 {
 public:
-    StorageArrayScheduler(std::vector <std::string> &files, int threadNum);
+    /**
+     * A range of row groups of a file, which is the unit of work of a scan thread.
+     */
+    struct Morsel
+    {
+        std::string fileName;
+        int rgStart;
+        // -1 means all the row groups from rgStart
+        int rgLen;
+        // the position of the morsel in the order of the files and their row groups
+        uint64_t batchId;
+    };
+
+    /**
+     * @param files the files to scan, in the order of the batch ids of their morsels
+     * @param fileRGNums the number of row groups of each file, or -1 if it is unknown, in which
+     * case the file is one morsel
+     * @param fileRGIncluded whether each row group of each file is to be scanned, the row groups
+     * excluded by their statistics break the morsels and are not handed out. It is empty for
+     * the files whose row groups are all scanned
+     * @param morselRGNum the largest number of row groups in a morsel
+     */
+    StorageArrayScheduler(std::vector <std::string> &files, std::vector<int> &fileRGNums,
+                          std::vector <std::vector<bool>> &fileRGIncluded, int morselRGNum);
 
     int acquireDeviceId();
 
     int getDeviceSum();
 
-    std::string getFileName(int deviceID, int fileID);
-
-    uint64_t getFileSum(int deviceID);
-
-    int getMaxFileSum();
+    uint64_t getMorselSum();
 
-    int getBatchID(int deviceID, int fileID);
+    /**
+     * Take the next morsel from the queue of the device, or steal one from another device if
+     * the queue is empty.
+     * @return false if there is no morsel left on any device
+     */
+    bool nextMorsel(int deviceID, Morsel &morsel);
 
 private:
     std::mutex m;
     int currentDeviceID;
     int devicesNum;
-    std::vector <std::vector<std::string>> filesVector;
+    uint64_t morselSum;
+    std::vector <std::deque<Morsel>> morselQueues;
 };
 
 #endif //DUCKDB_STORAGEARRAYSCHEDULER_H
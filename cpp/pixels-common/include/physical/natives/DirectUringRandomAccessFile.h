@@ -32,12 +32,22 @@
 #include "DirectIoLib.h"
 #include "physical/BufferPool.h"
 #include "unordered_set"
+#include <atomic>
+#include <map>
+#include <unordered_map>
 #include <mutex>
 #include "utils/MutexTracker.h"
 
 class DirectUringRandomAccessFile : public DirectRandomAccessFile
 {
 public:
+    // the slots of the sparse registered buffer table of the ring of a thread
+    static constexpr int REGISTERED_BUFFER_TABLE_SIZE = 1024;
+    // the slots of the sparse registered file table of the ring of a thread
+    static constexpr int REGISTERED_FILE_TABLE_SIZE = 1024;
+    // the completions reaped from the completion queue at once
+    static constexpr int COMPLETION_BATCH_SIZE = 256;
+
     explicit DirectUringRandomAccessFile(const std::string& file);
 
     static void RegisterBuffer(std::vector<std::shared_ptr<ByteBuffer>> buffers);
@@ -50,6 +60,12 @@ public:
 
     static bool RegisterMoreBuffer(int index, std::vector<std::shared_ptr<ByteBuffer>> buffers);
 
+    /**
+     * Clear the slot of a buffer in the registered buffer table before its memory goes back to
+     * the BufferPoolArena.
+     */
+    static void UnregisterBuffer(int index);
+
     std::shared_ptr<ByteBuffer> readAsync(int length, std::shared_ptr<ByteBuffer> buffer, int index, int ringIndex,
                                           int startOffset);
 
@@ -61,9 +77,31 @@ public:
 
     static struct io_uring* getRing(int index);
 
+    void close() override;
+
     ~DirectUringRandomAccessFile();
 
 private:
+    // a read in flight, kept until it completes so that it can be submitted again
+    // after a short read or -EAGAIN
+    struct PendingRead
+    {
+        uint64_t readId;
+        // the slot in the registered file table if fixedFile, otherwise the file descriptor
+        int fd;
+        bool fixedFile;
+        uint8_t* buf;
+        uint32_t length;
+        uint64_t offset;
+        int bufIndex;
+        // the bytes that must be read, less than length when the aligned read passes the end of file
+        uint32_t required;
+    };
+
+    static void prepareRead(struct io_uring* ring, uint64_t requestId, const PendingRead& read);
+
+    int getFixedFileSlot();
+
     // thread_local
     static std::mutex mutex_;
     static thread_local bool isRegistered;
@@ -71,7 +109,30 @@ private:
     // static TrackedMutex g_mutex;
     static thread_local std::vector<struct io_uring*> ringVector;
     static thread_local std::vector<struct iovec*> iovecsVector;
+    // the buffers of the buffer pool registered to ring 0, by their index in the buffer table
+    static thread_local std::vector<struct iovec> bufferTable;
+    // whether the buffer table is registered sparse, so that buffers can be added in place,
+    // otherwise the whole table is registered again to add buffers
+    static thread_local bool isSparseTable;
     static thread_local uint32_t iovecSize;
     static thread_local std::vector<long> offsetsVector;
+    // the completions reaped on behalf of other files, by the read id of the file and the ring index
+    static thread_local std::map<std::pair<uint64_t, int>, uint32_t> reapedCompletions;
+    // the errors of the reads of other files reaped on their behalf, by the read id of the file
+    static thread_local std::unordered_map<uint64_t, std::string> failedReads;
+    static std::atomic<uint64_t> nextReadId;
+    // the reads in flight on the rings of the thread, by the user data of their requests
+    static thread_local std::unordered_map<uint64_t, PendingRead> pendingReads;
+    static thread_local uint64_t nextRequestId;
+    // the registered file table of ring 0, fileTableId is 0 if it is not registered
+    static thread_local bool isFileTableTried;
+    static thread_local uint64_t fileTableId;
+    static thread_local std::vector<int> freeFileSlots;
+    static std::atomic<uint64_t> nextFileTableId;
+    // tags the requests of this file, so that the files read ahead on the same ring reap their own completions
+    uint64_t readId;
+    // the slot of this file in the registered file table fixedFileTableId, or -1
+    int fixedFileSlot;
+    uint64_t fixedFileTableId;
 };
 #endif // DUCKDB_DIRECTURINGRANDOMACCESSFILE_H
@@ -23,6 +23,8 @@
  * @create 2023-05-25
  */
 #include "physical/BufferPool.h"
+#include "physical/BufferPool/BufferPoolArena.h"
+#include <algorithm>
 #include <chrono>
 #include <duckdb/storage/buffer/buffer_pool.hpp>
 #include <iostream>
@@ -52,32 +54,31 @@ std::mutex BufferPool::bufferPoolMutex;
 
 // thread_local
 thread_local bool BufferPool::isInitialized;
-thread_local std::vector<std::shared_ptr<BufferPoolEntry>>
-BufferPool::registeredBuffers[2];
+thread_local std::vector<std::vector<std::shared_ptr<BufferPoolEntry>>>
+BufferPool::registeredBuffers;
 thread_local long BufferPool::globalFreeSize = 0;
 thread_local long BufferPool::globalUsedSize = 0;
 thread_local std::shared_ptr<DirectIoLib> BufferPool::directIoLib;
-thread_local int BufferPool::nextRingIndex = 1;
-thread_local std::shared_ptr<BufferPoolEntry>
-BufferPool::nextEmptyBufferPoolEntry[2] = {nullptr, nullptr};
+thread_local int BufferPool::nextBufferIndex = 0;
+thread_local std::vector<std::shared_ptr<BufferPoolEntry>>
+BufferPool::nextEmptyBufferPoolEntry;
 thread_local std::vector<BufferPoolEntry> globalBuffers;
 thread_local int BufferPool::colCount = 0;
-// The currBufferIdx is set to 1. When executing the first file, this value is 0
-// since we call switch function first.
-thread_local int BufferPool::currBufferIdx = 1;
-thread_local int BufferPool::nextBufferIdx = 0;
-
-thread_local std::map<uint32_t, std::shared_ptr<ByteBuffer>>
-BufferPool::buffersAllocated[2];
-thread_local std::unordered_map<
-    uint32_t, std::shared_ptr<BufferPool::BufferPoolManagedEntry>>
-BufferPool::ringBufferMap[2];
-thread_local size_t BufferPool::threadLocalUsedSize[2] = {0, 0};
-thread_local int BufferPool::threadLocalBufferCount[2] = {0, 0};
-
-void BufferPool::Initialize(std::vector<uint32_t> colIds,
+// The scan switches to the buffer of a row group before reading it
+thread_local int BufferPool::currBufferIdx = 0;
+
+thread_local std::vector<std::map<uint32_t, std::shared_ptr<ByteBuffer>>>
+BufferPool::buffersAllocated;
+thread_local std::vector<std::unordered_map<
+    uint32_t, std::shared_ptr<BufferPool::BufferPoolManagedEntry>>>
+BufferPool::ringBufferMap;
+thread_local std::vector<size_t> BufferPool::threadLocalUsedSize;
+thread_local std::vector<int> BufferPool::threadLocalBufferCount;
+
+bool BufferPool::Initialize(std::vector<uint32_t> colIds,
                             std::vector<uint64_t> bytes,
-                            std::vector<std::string> columnNames)
+                            std::vector<std::string> columnNames,
+                            bool mayWait)
 {
     assert(colIds.size() == bytes.size());
     int fsBlockSize = std::stoi(ConfigFactory::Instance().getProperty("localfs.block.size"));
@@ -92,62 +93,102 @@ void BufferPool::Initialize(std::vector<uint32_t> colIds,
     // give the maximal column size, which is stored in csv reader
     if (!BufferPool::isInitialized)
     {
-        currBufferIdx = 0;
-        nextBufferIdx = 1;
         directIoLib = std::make_shared<DirectIoLib>(fsBlockSize);
         BufferPool::InitializeBuffers();
-        for (int i = 0; i < colIds.size(); i++)
+        if (isFixedSize && !columnSizePath.empty())
+        {
+            csvReader = std::make_shared<ColumnSizeCSVReader>(columnSizePath);
+        }
+        BufferPool::isInitialized = true;
+    }
+
+    // the buffer is taken from the arena when the first row group is read into it, and taken
+    // again if a row group does not fit in it, sized from the chunks of that row group
+    size_t newBytes = 0;
+    size_t allBytes = 0;
+    for (int i = 0; i < colIds.size(); i++)
+    {
+        size_t sliceSize = GetSliceSize(bytes.at(i), columnNames.at(colIds.at(i)));
+        allBytes += sliceSize;
+        auto entry = ringBufferMap[currBufferIdx].find(colIds.at(i));
+        if (entry == ringBufferMap[currBufferIdx].end() ||
+            entry->second->getStatus() != BufferPoolManagedEntry::State::AllocatedAndInUse ||
+            entry->second->getCurrentSize() < bytes.at(i) + directIoLib->getBlockSize())
         {
-            uint32_t colId = colIds.at(i);
-            if (isFixedSize)
+            newBytes += sliceSize;
+        }
+    }
+    auto &buffers = registeredBuffers[currBufferIdx];
+    if (buffers.empty() || buffers[0]->getNextFreeIndex() + newBytes > buffers[0]->getSize())
+    {
+        // lay out the columns of this row group from the start of the buffer
+        ringBufferMap[currBufferIdx].clear();
+        buffersAllocated[currBufferIdx].clear();
+        nextEmptyBufferPoolEntry[currBufferIdx] = nullptr;
+        threadLocalUsedSize[currBufferIdx] = 0;
+        threadLocalBufferCount[currBufferIdx] = 0;
+        if (buffers.empty() || buffers[0]->getSize() < allBytes)
+        {
+            // give the smaller buffer back to the arena before taking a larger one
+            Release(currBufferIdx);
+            size_t size = allBytes + EXTRA_POOL_SIZE;
+            auto arena = BufferPoolArena::Instance();
+            auto memory = mayWait ? arena->allocate(size) : arena->tryAllocate(size);
+            if (memory == nullptr)
             {
-                if (!columnSizePath.empty())
-                {
-                    csvReader = std::make_shared<ColumnSizeCSVReader>(columnSizePath);
-                }
+                return false;
             }
-            auto byte = bytes.at(i);
-            BufferPool::ringBufferMap[currBufferIdx][colId] =
-                std::make_shared<BufferPoolManagedEntry>(
-                    registeredBuffers[currBufferIdx][0], 0, byte, 0);
+            // the first buffer of each buffer id takes its buffer id as its index in the
+            // registered buffer table
+            buffers.emplace_back(std::make_shared<BufferPoolEntry>(memory, currBufferIdx, 0));
+            globalFreeSize += size;
         }
-        BufferPool::colCount = colIds.size();
-        BufferPool::isInitialized = true;
+        else
+        {
+            for (size_t i = 1; i < buffers.size(); i++)
+            {
+                ::DirectUringRandomAccessFile::UnregisterBuffer(buffers[i]->getOffsetInBuffers());
+                globalFreeSize -= buffers[i]->getSize();
+            }
+            buffers.resize(1);
+            buffers[0]->reset();
+        }
+        buffers[0]->setInUse(true);
     }
-    else
+    for (int i = 0; i < colIds.size(); i++)
     {
-        // check if resize the buffer is needed
-        // 1.add more columns
-        // 2.resive the buffer
-        //
-        // assert(colIds.size() == BufferPool::colCount);
-        for (int i = 0; i < colIds.size(); i++)
+        uint32_t colId = colIds.at(i);
+        if (ringBufferMap[currBufferIdx].find(colId) == ringBufferMap[currBufferIdx].end())
         {
-            uint32_t colId = colIds.at(i);
-            uint64_t byte = bytes.at(i);
-            if (BufferPool::ringBufferMap[currBufferIdx].find(colId) ==
-                BufferPool::ringBufferMap[currBufferIdx].end())
-                BufferPool::ringBufferMap[currBufferIdx][colId] =
-                    std::make_shared<BufferPoolManagedEntry>(
-                        registeredBuffers[currBufferIdx][0], 0, byte, 0);
+            ringBufferMap[currBufferIdx][colId] =
+                std::make_shared<BufferPoolManagedEntry>(buffers[0], 0, bytes.at(i), 0);
         }
     }
+    BufferPool::colCount = colIds.size();
+    return true;
 }
 
 void BufferPool::InitializeBuffers()
 {
-    for (int idx = 0; idx < 2; idx++)
+    int bufferCount = GetBufferCount();
+    registeredBuffers.resize(bufferCount);
+    nextEmptyBufferPoolEntry.resize(bufferCount);
+    buffersAllocated.resize(bufferCount);
+    ringBufferMap.resize(bufferCount);
+    threadLocalUsedSize.resize(bufferCount, 0);
+    threadLocalBufferCount.resize(bufferCount, 0);
+    nextBufferIndex = std::max(nextBufferIndex, bufferCount);
+}
+
+size_t BufferPool::GetSliceSize(uint64_t byte, const std::string &columnName)
+{
+    if (csvReader != nullptr)
     {
-        const int size_ = bufferSize + EXTRA_POOL_SIZE;
-        // Calculate the required space, allocate it in advance, and then register
-        // it.
-        std::shared_ptr<BufferPoolEntry> buffer_pool_entry =
-            std::make_shared<BufferPoolEntry>(size_, sliceSize, directIoLib, idx,
-                                              0);
-        registeredBuffers[idx].emplace_back(buffer_pool_entry);
-        buffer_pool_entry->setInUse(true);
-        globalFreeSize += size_;
+        byte = csvReader->get(columnName);
     }
+    size_t sliceCount = (byte + SLICE_SIZE - 1) / SLICE_SIZE + 1;
+    size_t totalSizeRaw = (sliceCount + 1) * SLICE_SIZE;
+    return directIoLib->getToAllocate(totalSizeRaw);
 }
 
 int64_t BufferPool::GetBufferId()
@@ -155,25 +196,61 @@ int64_t BufferPool::GetBufferId()
     return currBufferIdx;
 }
 
-std::shared_ptr<ByteBuffer> BufferPool::AllocateNewBuffer(
-    std::shared_ptr<BufferPoolManagedEntry> currentBufferManagedEntry,
-    uint32_t colId, uint64_t byte, std::string columnName)
+int BufferPool::GetBufferCount()
 {
-    auto strToBool = [](const std::string& s)
+    static int bufferCount = []
     {
-        return s == "true" || s == "1" || s == "yes";
-    };
-    std::string configValue =
-        ConfigFactory::Instance().getProperty("pixel.bufferpool.fixedsize");
-    bool isFixedSize = strToBool(configValue);
-    if (isFixedSize)
+        if (!ConfigFactory::Instance().boolCheckProperty("pixels.readahead.enabled"))
+        {
+            // double buffering, one morsel is read while the other one is scanned
+            return 2;
+        }
+        long depth = std::stol(ConfigFactory::Instance().getProperty("pixels.readahead.depth"));
+        return (int) std::max(1L, depth) + 1;
+    }();
+    return bufferCount;
+}
+
+bool BufferPool::Reserve(int bufferId)
+{
+    if (!isInitialized || bufferId < 0 || bufferId >= (int) registeredBuffers.size())
     {
-        byte = csvReader->get(columnName);
+        return false;
+    }
+    auto &buffers = registeredBuffers[bufferId];
+    if (!buffers.empty())
+    {
+        return true;
+    }
+    // a row group is likely to take as much as the largest buffer of this thread
+    size_t size = 0;
+    for (auto &otherBuffers : registeredBuffers)
+    {
+        if (!otherBuffers.empty())
+        {
+            size = std::max(size, otherBuffers[0]->getSize());
+        }
+    }
+    if (size == 0)
+    {
+        return false;
+    }
+    auto memory = BufferPoolArena::Instance()->tryAllocate(size);
+    if (memory == nullptr)
+    {
+        return false;
     }
+    buffers.emplace_back(std::make_shared<BufferPoolEntry>(memory, bufferId, 0));
+    buffers[0]->setInUse(true);
+    globalFreeSize += size;
+    return true;
+}
 
-    size_t sliceCount = (byte + SLICE_SIZE - 1) / SLICE_SIZE + 1;
-    size_t totalSizeRaw = (sliceCount + 1) * SLICE_SIZE;
-    size_t totalSize = directIoLib->getToAllocate(totalSizeRaw);
+std::shared_ptr<ByteBuffer> BufferPool::AllocateNewBuffer(
+    std::shared_ptr<BufferPoolManagedEntry> currentBufferManagedEntry,
+    uint32_t colId, uint64_t byte, std::string columnName)
+{
+    size_t totalSize = GetSliceSize(byte, columnName);
     // need to reallocate
     // get origin registered ByteBuffer
     auto currentBuffer = currentBufferManagedEntry->getBufferPoolEntry();
@@ -195,14 +272,14 @@ std::shared_ptr<ByteBuffer> BufferPool::AllocateNewBuffer(
         else
         {
             // find more space
-            // 1. register a new io_uring bounded buffer
+            // 1. register a new buffer into the buffer table of the io_uring
             // 2. reallocate current buffer
             currentBuffer->setInUse(false);
-            currentBuffer = BufferPool::AddNewBuffer(currentBuffer->getSize());
+            currentBuffer = BufferPool::AddNewBuffer(std::max(currentBuffer->getSize(), totalSize));
             std::vector<std::shared_ptr<ByteBuffer>> buffers;
             buffers.emplace_back(currentBuffer->getBuffer());
             if (!::DirectUringRandomAccessFile::RegisterMoreBuffer(
-                currentBuffer->getRingIndex(), buffers))
+                currentBuffer->getOffsetInBuffers(), buffers))
             {
                 throw std::runtime_error("Failed to register more buffers");
             }
@@ -289,7 +366,7 @@ void BufferPool::Reset()
 {
     // BufferPool::isInitialized = false;
     // std::lock_guard<std::mutex> lock(bufferPoolMutex);
-    for (int idx = 0; idx < 2; idx++)
+    for (int idx = 0; idx < (int) registeredBuffers.size(); idx++)
     {
         // BufferPool::currentBuffers[idx]->clear();;
         BufferPool::buffersAllocated[idx].clear();
@@ -308,10 +385,49 @@ void BufferPool::Reset()
     BufferPool::colCount = 0;
 }
 
+void BufferPool::Release()
+{
+    registeredBuffers.clear();
+    nextEmptyBufferPoolEntry.clear();
+    buffersAllocated.clear();
+    ringBufferMap.clear();
+    threadLocalUsedSize.clear();
+    threadLocalBufferCount.clear();
+    globalUsedSize = 0;
+    globalFreeSize = 0;
+    colCount = 0;
+    currBufferIdx = 0;
+    nextBufferIndex = 0;
+    BufferPool::isInitialized = false;
+}
+
+void BufferPool::Release(int bufferId)
+{
+    if (bufferId < 0 || bufferId >= (int) registeredBuffers.size())
+    {
+        return;
+    }
+    for (auto &buffer : registeredBuffers[bufferId])
+    {
+        ::DirectUringRandomAccessFile::UnregisterBuffer(buffer->getOffsetInBuffers());
+        globalFreeSize -= buffer->getSize();
+    }
+    registeredBuffers[bufferId].clear();
+    nextEmptyBufferPoolEntry[bufferId] = nullptr;
+    buffersAllocated[bufferId].clear();
+    ringBufferMap[bufferId].clear();
+    threadLocalUsedSize[bufferId] = 0;
+    threadLocalBufferCount[bufferId] = 0;
+}
+
 void BufferPool::Switch()
 {
-    currBufferIdx = 1 - currBufferIdx;
-    nextBufferIdx = 1 - nextBufferIdx;
+    currBufferIdx = (currBufferIdx + 1) % GetBufferCount();
+}
+
+void BufferPool::Switch(int bufferId)
+{
+    currBufferIdx = bufferId;
 }
 
 std::shared_ptr<BufferPoolEntry> BufferPool::AddNewBuffer(size_t size)
@@ -321,9 +437,10 @@ std::shared_ptr<BufferPoolEntry> BufferPool::AddNewBuffer(size_t size)
         assert(false && "Unexpected code path reached!");
     }
     // Calculate the required space, allocate it in advance, and then register it.
+    // All the buffers are read through the one ring of the thread.
     std::shared_ptr<BufferPoolEntry> buffer_pool_entry =
         std::make_shared<BufferPoolEntry>(size, sliceSize, directIoLib,
-                                          currBufferIdx, nextRingIndex++);
+                                          nextBufferIndex++, 0);
     registeredBuffers[currBufferIdx].emplace_back(buffer_pool_entry);
     buffer_pool_entry->setInUse(true);
     globalFreeSize += size;
@@ -331,6 +448,13 @@ std::shared_ptr<BufferPoolEntry> BufferPool::AddNewBuffer(size_t size)
     return buffer_pool_entry;
 }
 
+int BufferPool::getBufferIndex(uint32_t colId)
+{
+    return ringBufferMap[currBufferIdx][colId]
+           ->getBufferPoolEntry()
+           ->getOffsetInBuffers();
+}
+
 int BufferPool::getRingIndex(uint32_t colId)
 {
     return ringBufferMap[currBufferIdx][colId]
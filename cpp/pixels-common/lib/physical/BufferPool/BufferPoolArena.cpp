@@ -0,0 +1,272 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "physical/BufferPool/BufferPoolArena.h"
+#include "exception/InvalidArgumentException.h"
+#include "utils/ConfigFactory.h"
+#include <chrono>
+
+thread_local BufferPoolArena::Magazine BufferPoolArena::magazine;
+thread_local bool BufferPoolArena::isMagazineClosed = false;
+
+std::shared_ptr<BufferPoolArena> BufferPoolArena::Instance()
+{
+    static std::shared_ptr<BufferPoolArena> instance = std::make_shared<BufferPoolArena>(
+            std::stoul(ConfigFactory::Instance().getProperty("pixel.bufferpool.memory.budget")),
+            std::stol(ConfigFactory::Instance().getProperty("pixel.bufferpool.memory.wait.ms")),
+            std::stoi(ConfigFactory::Instance().getProperty("localfs.block.size")));
+    return instance;
+}
+
+BufferPoolArena::BufferPoolArena(size_t budget, long waitMillis, int blockSize)
+        : budget(budget), waitMillis(waitMillis), reservedBytes(0), waiters(0)
+{
+    directIoLib = std::make_shared<DirectIoLib>(blockSize);
+}
+
+size_t BufferPoolArena::getClassSize(size_t size)
+{
+    size_t classSize = MIN_CLASS_SIZE;
+    while (classSize < size)
+    {
+        classSize <<= 1;
+    }
+    if (classSize == MIN_CLASS_SIZE)
+    {
+        return classSize;
+    }
+    // round up to a quarter of the power of two below, which wastes at most a fifth of the slab
+    size_t lower = classSize / 2;
+    size_t step = lower / 4;
+    return lower + (size - lower + step - 1) / step * step;
+}
+
+std::shared_ptr<ByteBuffer> BufferPoolArena::allocate(size_t size)
+{
+    return allocate(size, true);
+}
+
+std::shared_ptr<ByteBuffer> BufferPoolArena::tryAllocate(size_t size)
+{
+    return allocate(size, false);
+}
+
+std::shared_ptr<ByteBuffer> BufferPoolArena::allocate(size_t size, bool mayWait)
+{
+    size_t classSize = getClassSize(size);
+    if (classSize > budget)
+    {
+        throw InvalidArgumentException("BufferPoolArena::allocate: a buffer of " +
+                                       std::to_string(size) + " bytes exceeds the memory budget of " +
+                                       std::to_string(budget) + " bytes");
+    }
+    std::shared_ptr<ByteBuffer> slab = takeFromMagazine(classSize);
+    if (slab == nullptr)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            auto &idle = freeSlabs[classSize];
+            if (!idle.empty())
+            {
+                slab = std::move(idle.back());
+                idle.pop_back();
+                break;
+            }
+            if (trimFor(classSize))
+            {
+                reservedBytes += classSize;
+                lock.unlock();
+                try
+                {
+                    slab = directIoLib->allocateDirectBuffer(classSize, false);
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    reservedBytes -= classSize;
+                    throw;
+                }
+                break;
+            }
+            // the budget is used up, take the idle slabs of all the threads, as the threads of
+            // DuckDB live on and their magazines are not flushed by their exit. The slabs
+            // released from now on go to the free lists, as there is a waiter
+            waiters++;
+            if (drainMagazines())
+            {
+                waiters--;
+                continue;
+            }
+            if (!mayWait)
+            {
+                waiters--;
+                return nullptr;
+            }
+            // apply backpressure until other scans release their slabs, the budget holds this
+            // buffer once they do, so the wait ends unless a scan never releases its buffers
+            released.wait_for(lock, std::chrono::milliseconds(waitMillis));
+            waiters--;
+        }
+    }
+    // the buffer is a view of the slab, which goes back to the arena when the buffer is released
+    auto arena = shared_from_this();
+    ByteBuffer *buffer = new ByteBuffer(*slab, 0, size);
+    return std::shared_ptr<ByteBuffer>(buffer, [arena, slab, classSize](ByteBuffer *buffer)
+    {
+        delete buffer;
+        arena->release(slab, classSize);
+    });
+}
+
+int BufferPoolArena::getClassIndex(size_t classSize)
+{
+    if (classSize <= MIN_CLASS_SIZE)
+    {
+        return 0;
+    }
+    // the class is a quarter step above the power of two below it
+    int shift = 63 - __builtin_clzl(classSize - 1);
+    size_t lower = 1UL << shift;
+    return 1 + 4 * (shift - (int) MIN_CLASS_SHIFT) + (int) ((classSize - lower) / (lower / 4)) - 1;
+}
+
+std::shared_ptr<ByteBuffer> BufferPoolArena::takeFromMagazine(size_t classSize)
+{
+    if (isMagazineClosed || magazine.arena.get() != this)
+    {
+        return nullptr;
+    }
+    int classIndex = getClassIndex(classSize);
+    for (size_t i = 0; i < MAGAZINE_SIZE; i++)
+    {
+        CachedSlab *cached = magazine.slots[classIndex * MAGAZINE_SIZE + i].exchange(nullptr);
+        if (cached != nullptr)
+        {
+            std::shared_ptr<ByteBuffer> slab = std::move(cached->slab);
+            delete cached;
+            return slab;
+        }
+    }
+    return nullptr;
+}
+
+void BufferPoolArena::release(std::shared_ptr<ByteBuffer> slab, size_t classSize)
+{
+    if (!isMagazineClosed && waiters.load() == 0)
+    {
+        if (magazine.arena == nullptr)
+        {
+            // register the magazine, so that a waiting allocation can drain it
+            std::lock_guard<std::mutex> lock(mutex);
+            magazine.arena = shared_from_this();
+            magazines.insert(&magazine);
+        }
+        if (magazine.arena.get() == this)
+        {
+            int classIndex = getClassIndex(classSize);
+            for (size_t i = 0; i < MAGAZINE_SIZE; i++)
+            {
+                // the other threads never fill a slot, so an empty slot stays empty until the store
+                auto &slot = magazine.slots[classIndex * MAGAZINE_SIZE + i];
+                if (slot.load() == nullptr)
+                {
+                    slot.store(new CachedSlab{std::move(slab), classSize});
+                    return;
+                }
+            }
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    freeSlabs[classSize].emplace_back(std::move(slab));
+    released.notify_all();
+}
+
+bool BufferPoolArena::flushMagazine(Magazine &magazine)
+{
+    bool flushed = false;
+    for (auto &slot : magazine.slots)
+    {
+        CachedSlab *cached = slot.exchange(nullptr);
+        if (cached != nullptr)
+        {
+            freeSlabs[cached->classSize].emplace_back(std::move(cached->slab));
+            delete cached;
+            flushed = true;
+        }
+    }
+    return flushed;
+}
+
+bool BufferPoolArena::drainMagazines()
+{
+    bool drained = false;
+    for (Magazine *cached : magazines)
+    {
+        drained |= flushMagazine(*cached);
+    }
+    return drained;
+}
+
+bool BufferPoolArena::trimFor(size_t classSize)
+{
+    for (auto it = freeSlabs.begin(); reservedBytes + classSize > budget && it != freeSlabs.end(); it++)
+    {
+        while (reservedBytes + classSize > budget && !it->second.empty())
+        {
+            it->second.pop_back();
+            reservedBytes -= it->first;
+        }
+    }
+    return reservedBytes + classSize <= budget;
+}
+
+size_t BufferPoolArena::getBudget() const
+{
+    return budget;
+}
+
+size_t BufferPoolArena::getReservedBytes()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return reservedBytes;
+}
+
+int BufferPoolArena::getWaiterNum() const
+{
+    return waiters.load();
+}
+
+BufferPoolArena::Magazine::~Magazine()
+{
+    // the slabs of an exiting thread go back to the free lists
+    isMagazineClosed = true;
+    if (arena != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(arena->mutex);
+        arena->flushMagazine(*this);
+        arena->magazines.erase(this);
+        arena->released.notify_all();
+    }
+}
@@ -25,6 +25,7 @@
  */
 #include "physical/BufferPool/BufferPoolEntry.h"
 #include "physical/BufferPool/Bitmap.h"
+#include "physical/BufferPool/BufferPoolArena.h"
 
 BufferPoolEntry::BufferPoolEntry(size_t size, int slice_size, std::shared_ptr<DirectIoLib> directLib, int offset,
                                  int ringIndex)
@@ -43,12 +44,20 @@ BufferPoolEntry::BufferPoolEntry(size_t size, int slice_size, std::shared_ptr<Di
     const int slice_count = static_cast<int>(size + slice_size - 1 / slice_size);
     // bitmap_ = std::make_shared<Bitmap>(slice_count);
 
-    buffer_ = directLib->allocateDirectBuffer(size_, false);
-    memset(buffer_->getPointer(), 0, buffer_->size());
+    // the memory is taken from the arena shared by all the threads and goes back to it
+    // when the entry is destroyed
+    buffer_ = BufferPoolArena::Instance()->allocate(size_);
     if (!buffer_)
     {
         throw std::runtime_error("Failed to allocate direct buffer");
     }
+    memset(buffer_->getPointer(), 0, buffer_->size());
+}
+
+BufferPoolEntry::BufferPoolEntry(std::shared_ptr<ByteBuffer> buffer, int offset, int ringIndex)
+    : size_(buffer->size()), buffer_(std::move(buffer)), isFull_(false), inexFree_(0), isInUse_(false),
+      offsetInBuffers_(offset), isRegistered(false), ringIndex(ringIndex)
+{
 }
 
 size_t BufferPoolEntry::getSize() const
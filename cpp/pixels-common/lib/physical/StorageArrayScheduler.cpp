@@ -23,16 +23,21 @@
  * @create 2024-01-21
  */
 #include "physical/StorageArrayScheduler.h"
+#include <algorithm>
 
 
-StorageArrayScheduler::StorageArrayScheduler(std::vector <std::string> &files, int threadNum)
+StorageArrayScheduler::StorageArrayScheduler(std::vector <std::string> &files, std::vector<int> &fileRGNums,
+                                             std::vector <std::vector<bool>> &fileRGIncluded, int morselRGNum)
 {
     std::unordered_map<std::string, int> device2id;
     int storageDepth = std::stoi(ConfigFactory::Instance().getProperty("storage.directory.depth"));
-    filesVector.clear();
+    morselQueues.clear();
+    morselSum = 0;
+    morselRGNum = std::max(morselRGNum, 1);
 
-    for (auto &file: files)
+    for (size_t fileId = 0; fileId < files.size(); fileId++)
     {
+        std::string &file = files[fileId];
         std::string deviceName;
         std::string tmp = file.substr(1);
         for (int i = 0; i < storageDepth; i++)
@@ -48,30 +53,39 @@ StorageArrayScheduler::StorageArrayScheduler(std::vector <std::string> &files, i
                 throw InvalidArgumentException("StorageArrayScheduler::initialize: wrong storage depth. ");
             }
         }
-        // The following code makes sure that one thread can also process multiple devices
         if (!device2id.count(deviceName))
         {
-            device2id[deviceName] = (int) device2id.size() % threadNum;
+            device2id[deviceName] = (int) device2id.size();
+            morselQueues.emplace_back();
         }
-        int id = device2id[deviceName];
-        if (id >= filesVector.size())
+        auto &queue = morselQueues[device2id[deviceName]];
+        int rgNum = fileRGNums.at(fileId);
+        if (rgNum < 0)
         {
-            filesVector.emplace_back(std::vector < std::string > {});
+            queue.push_back(Morsel{file, 0, -1, morselSum++});
+            continue;
+        }
+        const std::vector<bool> &included = fileRGIncluded.at(fileId);
+        int rgStart = 0;
+        while (rgStart < rgNum)
+        {
+            if (!included.empty() && !included.at(rgStart))
+            {
+                rgStart++;
+                continue;
+            }
+            int rgLen = 1;
+            while (rgLen < morselRGNum && rgStart + rgLen < rgNum &&
+                   (included.empty() || included.at(rgStart + rgLen)))
+            {
+                rgLen++;
+            }
+            queue.push_back(Morsel{file, rgStart, rgLen, morselSum++});
+            rgStart += rgLen;
         }
-        filesVector[id].emplace_back(file);
     }
 
-    devicesNum = (int) filesVector.size();
-    if (files.size() > threadNum && devicesNum % threadNum != 0 && threadNum % devicesNum != 0)
-    {
-        throw InvalidArgumentException("StorageArrayScheduler::initialize: "
-                                       "if multiple devices are used, make sure "
-                                       "the thread count is divisible by device num or"
-                                       "the device num is divisible by the thread count. "
-                                       "Now the thread count is " + std::to_string(threadNum) +
-                                       " , and the storage device num is " + std::to_string(devicesNum) +
-                                       ". Otherwise the load balancing issue occurs. ");
-    }
+    devicesNum = (int) morselQueues.size();
     currentDeviceID = 0;
 }
 
@@ -79,7 +93,7 @@ int StorageArrayScheduler::acquireDeviceId()
 {
     m.lock();
     int deviceId = currentDeviceID;
-    currentDeviceID = (currentDeviceID + 1) % devicesNum;
+    currentDeviceID = (currentDeviceID + 1) % std::max(devicesNum, 1);
     m.unlock();
     return deviceId;
 }
@@ -89,34 +103,34 @@ int StorageArrayScheduler::getDeviceSum()
     return devicesNum;
 }
 
-uint64_t StorageArrayScheduler::getFileSum(int deviceID)
+uint64_t StorageArrayScheduler::getMorselSum()
 {
-    return filesVector[deviceID].size();
+    return morselSum;
 }
 
-std::string StorageArrayScheduler::getFileName(int deviceID, int fileID)
+bool StorageArrayScheduler::nextMorsel(int deviceID, Morsel &morsel)
 {
-    return filesVector.at(deviceID).at(fileID);
-}
-
-int StorageArrayScheduler::getMaxFileSum()
-{
-    int result = 0;
-    for (auto &files: filesVector)
+    std::lock_guard<std::mutex> lock(m);
+    if (deviceID < devicesNum && !morselQueues[deviceID].empty())
     {
-        result = std::max(result, (int) files.size());
+        morsel = morselQueues[deviceID].front();
+        morselQueues[deviceID].pop_front();
+        return true;
     }
-    return result;
-}
-
-int StorageArrayScheduler::getBatchID(int deviceID, int fileID)
-{
-    int result = 0;
-    for (int i = 0; i < deviceID; i++)
+    // steal from the back of the longest queue, so that its owners keep reading in order
+    int victim = -1;
+    for (int i = 0; i < devicesNum; i++)
     {
-        result += (int) filesVector[i].size();
+        if (!morselQueues[i].empty() && (victim < 0 || morselQueues[i].size() > morselQueues[victim].size()))
+        {
+            victim = i;
+        }
+    }
+    if (victim < 0)
+    {
+        return false;
     }
-    result += fileID;
-    return result;
+    morsel = morselQueues[victim].back();
+    morselQueues[victim].pop_back();
+    return true;
 }
-
@@ -105,6 +105,11 @@ std::string PhysicalLocalReader::getName()
     return path.substr(path.find_last_of('/') + 1);
 }
 
+std::string PhysicalLocalReader::getPath()
+{
+    return path;
+}
+
 void PhysicalLocalReader::addRingIndex(int ringIndex)
 {
     ring_index_vector.insert(ringIndex);
@@ -25,6 +25,7 @@
 #include "physical/natives/DirectUringRandomAccessFile.h"
 
 #include <duckdb/storage/buffer/buffer_pool.hpp>
+#include <cerrno>
 
 // global
 std::mutex DirectUringRandomAccessFile::mutex_;
@@ -35,12 +36,27 @@ DirectUringRandomAccessFile::ringVector;
 thread_local std::vector<struct iovec*>
 DirectUringRandomAccessFile::iovecsVector;
 thread_local std::vector<long> DirectUringRandomAccessFile::offsetsVector;
+thread_local std::vector<struct iovec> DirectUringRandomAccessFile::bufferTable;
+thread_local bool DirectUringRandomAccessFile::isSparseTable = false;
 thread_local uint32_t DirectUringRandomAccessFile::iovecSize = 0;
+thread_local std::map<std::pair<uint64_t, int>, uint32_t>
+DirectUringRandomAccessFile::reapedCompletions;
+thread_local std::unordered_map<uint64_t, std::string>
+DirectUringRandomAccessFile::failedReads;
+std::atomic<uint64_t> DirectUringRandomAccessFile::nextReadId(1);
+thread_local std::unordered_map<uint64_t, DirectUringRandomAccessFile::PendingRead>
+DirectUringRandomAccessFile::pendingReads;
+thread_local uint64_t DirectUringRandomAccessFile::nextRequestId = 1;
+thread_local bool DirectUringRandomAccessFile::isFileTableTried = false;
+thread_local uint64_t DirectUringRandomAccessFile::fileTableId = 0;
+thread_local std::vector<int> DirectUringRandomAccessFile::freeFileSlots;
+std::atomic<uint64_t> DirectUringRandomAccessFile::nextFileTableId(1);
 
 DirectUringRandomAccessFile::DirectUringRandomAccessFile(
     const std::string& file)
-    : DirectRandomAccessFile(file)
+    : DirectRandomAccessFile(file), fixedFileSlot(-1), fixedFileTableId(0)
 {
+    readId = nextReadId.fetch_add(1);
 }
 
 void DirectUringRandomAccessFile::RegisterBufferFromPool(
@@ -48,35 +64,76 @@ void DirectUringRandomAccessFile::RegisterBufferFromPool(
 {
     if (!isRegistered)
     {
-        std::vector<std::shared_ptr<ByteBuffer>> tmpBuffers;
         auto ring = DirectUringRandomAccessFile::getRing(0);
-        struct iovec* iovecs = nullptr;
-        for (auto buffers : ::BufferPool::registeredBuffers)
+        // every entry of the pool is registered to the one ring of the thread, at its index in
+        // the buffer table, which is the buffer index of the requests reading into it
+        bufferTable.clear();
+        for (auto& buffers : ::BufferPool::registeredBuffers)
         {
-            for (auto buffer : buffers)
+            for (auto& buffer : buffers)
             {
+                int index = buffer->getOffsetInBuffers();
+                if (index >= (int)bufferTable.size())
+                {
+                    bufferTable.resize(index + 1, iovec{nullptr, 0});
+                }
+                bufferTable[index].iov_base = buffer->getBuffer()->getPointer();
+                bufferTable[index].iov_len = buffer->getBuffer()->size();
                 buffer->setIsRegistered(true);
-                tmpBuffers.emplace_back(buffer->getBuffer());
             }
         }
-        iovecs = (iovec*)calloc(tmpBuffers.size(), sizeof(struct iovec));
-        iovecSize = tmpBuffers.size();
-        for (auto i = 0; i < tmpBuffers.size(); i++)
+        iovecSize = bufferTable.size();
+        // the sparse table needs linux 5.19, fall back to a dense table on older kernels
+        isSparseTable = iovecSize <= REGISTERED_BUFFER_TABLE_SIZE &&
+            io_uring_register_buffers_sparse(ring, REGISTERED_BUFFER_TABLE_SIZE) == 0;
+        int ret;
+        if (isSparseTable)
         {
-            auto buffer = tmpBuffers.at(i);
-            iovecs[i].iov_base = buffer->getPointer();
-            iovecs[i].iov_len = buffer->size();
+            ret = io_uring_register_buffers_update_tag(ring, 0, bufferTable.data(), nullptr,
+                                                       iovecSize);
         }
-        iovecsVector.emplace_back(iovecs);
-        int ret = io_uring_register_buffers(ring, iovecs, iovecSize);
-        if (ret != 0)
+        else
+        {
+            ret = io_uring_register_buffers(ring, bufferTable.data(), iovecSize);
+        }
+        if (ret < 0)
         {
             throw InvalidArgumentException(
                 "DirectUringRandomAccessFile::RegisterBufferFromPool: register "
-                "buffer fails. ");
+                "buffer fails, errno " + std::to_string(-ret));
         }
         isRegistered = true;
+        return;
+    }
+    // the buffers taken since, e.g., the buffer of a buffer id read into for the first time,
+    // take their slots in the table, the buffers registered before stay registered
+    for (auto& buffers : ::BufferPool::registeredBuffers)
+    {
+        for (auto& buffer : buffers)
+        {
+            if (!buffer->getIsRegistered())
+            {
+                RegisterMoreBuffer(buffer->getOffsetInBuffers(), {buffer->getBuffer()});
+                buffer->setIsRegistered(true);
+            }
+        }
+    }
+}
+
+void DirectUringRandomAccessFile::UnregisterBuffer(int index)
+{
+    if (!isRegistered || index < 0 || index >= (int) bufferTable.size())
+    {
+        return;
     }
+    bufferTable[index] = iovec{nullptr, 0};
+    if (isSparseTable)
+    {
+        // an empty iovec clears the slot, so the kernel no longer pins the memory
+        io_uring_register_buffers_update_tag(getRing(0), index, &bufferTable[index], nullptr, 1);
+    }
+    // a dense table keeps the memory pinned until the slot is taken by another buffer or the
+    // ring is reset, as it can only be replaced as a whole
 }
 
 void DirectUringRandomAccessFile::RegisterBuffer(
@@ -95,7 +152,6 @@ void DirectUringRandomAccessFile::RegisterBuffer(
             iovecs[i].iov_len = buffer->size();
             memset(iovecs[i].iov_base, 0, buffer->size());
         }
-        ringVector.emplace_back(ring);
         iovecsVector.emplace_back(iovecs);
         int ret = io_uring_register_buffers(ring, iovecs, iovecSize);
         if (ret != 0)
@@ -141,52 +197,152 @@ void DirectUringRandomAccessFile::Reset()
         }
     }
     iovecsVector.clear();
+    bufferTable.clear();
+    isSparseTable = false;
+    reapedCompletions.clear();
+    failedReads.clear();
+    pendingReads.clear();
+    // the registered files are released with the ring
+    isFileTableTried = false;
+    fileTableId = 0;
+    freeFileSlots.clear();
 }
 
 bool DirectUringRandomAccessFile::RegisterMoreBuffer(
     int index, std::vector<std::shared_ptr<ByteBuffer>> buffers)
 {
     assert(isRegistered);
-    auto ring = DirectUringRandomAccessFile::getRing(index);
-    struct iovec* iovecs = nullptr;
-    iovecs = (iovec*)calloc(buffers.size(), sizeof(struct iovec));
-    iovecSize = buffers.size();
+    // the new buffers take the slots from index on in the buffer table of ring 0
+    auto ring = DirectUringRandomAccessFile::getRing(0);
+    if (index + buffers.size() > bufferTable.size())
+    {
+        bufferTable.resize(index + buffers.size(), iovec{nullptr, 0});
+    }
     for (auto i = 0; i < buffers.size(); i++)
     {
         auto buffer = buffers.at(i);
-        iovecs[i].iov_base = buffer->getPointer();
-        iovecs[i].iov_len = buffer->size();
+        bufferTable[index + i].iov_base = buffer->getPointer();
+        bufferTable[index + i].iov_len = buffer->size();
+    }
+    iovecSize = bufferTable.size();
+    int ret;
+    if (isSparseTable && iovecSize <= REGISTERED_BUFFER_TABLE_SIZE)
+    {
+        ret = io_uring_register_buffers_update_tag(ring, index, &bufferTable[index], nullptr,
+                                                   buffers.size());
+    }
+    else
+    {
+        // the dense table can not be updated in place, register the whole table again,
+        // unregistering waits for the requests in flight on the table
+        ret = io_uring_unregister_buffers(ring);
+        if (ret == 0)
+        {
+            isSparseTable = false;
+            ret = io_uring_register_buffers(ring, bufferTable.data(), iovecSize);
+        }
     }
-    iovecsVector.emplace_back(iovecs);
-    int ret = io_uring_register_buffers(ring, iovecs, iovecSize);
-    if (ret != 0)
+    if (ret < 0)
     {
         throw InvalidArgumentException(
             "DirectUringRandomAccessFile::RegisterMoreBuffer: register buffer "
-            "fails. ");
+            "fails, errno " + std::to_string(-ret));
     }
     return true;
 }
 
+int DirectUringRandomAccessFile::getFixedFileSlot()
+{
+    if (fixedFileSlot >= 0 && fixedFileTableId == fileTableId)
+    {
+        return fixedFileSlot;
+    }
+    auto ring = DirectUringRandomAccessFile::getRing(0);
+    if (!isFileTableTried)
+    {
+        // the sparse table needs linux 5.19, the files are read by descriptor on older kernels
+        isFileTableTried = true;
+        if (io_uring_register_files_sparse(ring, REGISTERED_FILE_TABLE_SIZE) == 0)
+        {
+            fileTableId = nextFileTableId.fetch_add(1);
+            for (int slot = REGISTERED_FILE_TABLE_SIZE - 1; slot >= 0; slot--)
+            {
+                freeFileSlots.emplace_back(slot);
+            }
+        }
+    }
+    if (fileTableId == 0 || freeFileSlots.empty())
+    {
+        return -1;
+    }
+    int slot = freeFileSlots.back();
+    if (io_uring_register_files_update(ring, slot, &fd, 1) != 1)
+    {
+        return -1;
+    }
+    freeFileSlots.pop_back();
+    fixedFileSlot = slot;
+    fixedFileTableId = fileTableId;
+    return slot;
+}
+
+void DirectUringRandomAccessFile::close()
+{
+    // the file table holds a reference to the file, release the slot before closing it.
+    // A file closed by another thread than the one that read it keeps its slot until
+    // the ring of that thread is reset.
+    if (fixedFileSlot >= 0 && fixedFileTableId == fileTableId)
+    {
+        int none = -1;
+        io_uring_register_files_update(DirectUringRandomAccessFile::getRing(0), fixedFileSlot,
+                                       &none, 1);
+        freeFileSlots.emplace_back(fixedFileSlot);
+    }
+    fixedFileSlot = -1;
+    DirectRandomAccessFile::close();
+}
+
 DirectUringRandomAccessFile::~DirectUringRandomAccessFile()
 {
 }
 
+void DirectUringRandomAccessFile::prepareRead(struct io_uring* ring, uint64_t requestId,
+                                              const PendingRead& read)
+{
+    struct io_uring_sqe* sqe = io_uring_get_sqe(ring);
+    if (!sqe)
+    {
+        throw std::runtime_error("DirectUringRandomAccessFile::readAsync: failed "
+            "to get SQE, submission queue is full");
+    }
+    io_uring_prep_read_fixed(sqe, read.fd, read.buf, read.length, read.offset,
+                             read.bufIndex);
+    if (read.fixedFile)
+    {
+        io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE);
+    }
+    // the completion is matched to the request by its user data
+    io_uring_sqe_set_data64(sqe, requestId);
+}
+
 std::shared_ptr<ByteBuffer> DirectUringRandomAccessFile::readAsync(
     int length, std::shared_ptr<ByteBuffer> buffer, int index, int ringIndex,
     int startOffset)
 {
     auto ring = DirectUringRandomAccessFile::getRing(ringIndex);
     auto offset = startOffset;
+    if (fd < 0)
+    {
+        throw std::runtime_error(
+            "DirectUringRandomAccessFile::readAsync: invalid file descriptor");
+    }
+    // the registered file table belongs to ring 0
+    int slot = ringIndex == 0 ? getFixedFileSlot() : -1;
+    PendingRead read{readId, slot >= 0 ? slot : fd, slot >= 0, buffer->getPointer(), 0, 0, index, 0};
+    uint64_t requestId = nextRequestId++;
 
     if (enableDirect)
     {
-        struct io_uring_sqe* sqe = io_uring_get_sqe(ring);
-        if (!sqe)
-        {
-            throw std::runtime_error("DirectUringRandomAccessFile::readAsync: failed "
-                "to get SQE, submission queue is full");
-        }
         // the file will be read from blockStart(fileOffset), and the first
         // fileDelta bytes should be ignored.
         uint64_t fileOffsetAligned = directIoLib->blockStart(offset);
@@ -207,13 +363,11 @@ std::shared_ptr<ByteBuffer> DirectUringRandomAccessFile::readAsync(
             throw InvalidArgumentException(ss.str());
         }
 
-        io_uring_prep_read_fixed(sqe, fd, buffer->getPointer(), toRead,
-                                 fileOffsetAligned, index);
-        if (fd < 0)
-        {
-            throw std::runtime_error(
-                "DirectUringRandomAccessFile::readAsync: invalid file descriptor");
-        }
+        read.length = toRead;
+        read.offset = fileOffsetAligned;
+        read.required = required_buffer_size;
+        prepareRead(ring, requestId, read);
+        pendingReads.emplace(requestId, read);
 
         auto bb = std::make_shared<ByteBuffer>(*buffer, offset - fileOffsetAligned,
                                                length);
@@ -222,9 +376,11 @@ std::shared_ptr<ByteBuffer> DirectUringRandomAccessFile::readAsync(
     }
     else
     {
-        struct io_uring_sqe* sqe = io_uring_get_sqe(ring);
-        io_uring_prep_read_fixed(sqe, fd, buffer->getPointer(), length, offset,
-                                 index);
+        read.length = length;
+        read.offset = offset;
+        read.required = length;
+        prepareRead(ring, requestId, read);
+        pendingReads.emplace(requestId, read);
         seek(offset + length);
         auto result = std::make_shared<ByteBuffer>(*buffer, 0, length);
         return result;
@@ -279,21 +435,125 @@ void DirectUringRandomAccessFile::readAsyncComplete(
     std::unordered_map<int, uint32_t> sizes,
     std::unordered_set<int> ringIndex)
 {
-    // Important! We cannot write the code as io_uring_wait_cqe_nr(ring, &cqe,
-    // iovecSize). The reason is unclear, but some random bugs would happen. It
-    // takes me nearly a week to find this bug
+    // The completions are reaped in batches and matched to their requests by the user data.
+    // The files read ahead share the rings of the thread, so a completion reaped here may
+    // belong to another file, it is counted for that file and this file waits for its own.
+    struct io_uring_cqe* cqes[COMPLETION_BATCH_SIZE];
+    auto failed = failedReads.find(readId);
+    if (failed != failedReads.end())
+    {
+        std::string error = failed->second;
+        failedReads.erase(failed);
+        throw InvalidArgumentException(
+            "DirectUringRandomAccessFile::readAsyncComplete: " + error);
+    }
     for (auto idx : ringIndex)
     {
-        struct io_uring_cqe* cqe;
         auto ring = DirectUringRandomAccessFile::getRing(idx);
-        for (int j = 0; j < sizes[idx]; j++)
+        uint32_t remaining = sizes[idx];
+        auto reaped = reapedCompletions.find({readId, idx});
+        if (reaped != reapedCompletions.end())
+        {
+            remaining -= std::min(remaining, reaped->second);
+            reapedCompletions.erase(reaped);
+        }
+        while (remaining > 0)
         {
-            if (io_uring_wait_cqe_nr(ring, &cqe, 1) != 0)
+            struct io_uring_cqe* cqe;
+            int ret = io_uring_wait_cqe(ring, &cqe);
+            if (ret == -EINTR)
+            {
+                continue;
+            }
+            if (ret != 0)
+            {
+                throw InvalidArgumentException(
+                    "DirectUringRandomAccessFile::readAsyncComplete: wait cqe fails, errno " +
+                    std::to_string(-ret));
+            }
+            unsigned count = io_uring_peek_batch_cqe(ring, cqes, COMPLETION_BATCH_SIZE);
+            int resubmitted = 0;
+            std::string error;
+            // the whole batch is handled before an error is thrown, as the completions are
+            // consumed together and the requests of the other files must still be counted
+            for (unsigned i = 0; i < count; i++)
+            {
+                auto pending = pendingReads.find(io_uring_cqe_get_data64(cqes[i]));
+                if (pending == pendingReads.end())
+                {
+                    continue;
+                }
+                PendingRead& read = pending->second;
+                int res = cqes[i]->res;
+                if (res == -EAGAIN || res == -EINTR)
+                {
+                    prepareRead(ring, pending->first, read);
+                    resubmitted++;
+                    continue;
+                }
+                std::string readError;
+                if (res < 0)
+                {
+                    readError = "read fails, errno " + std::to_string(-res);
+                }
+                else if (res == 0 && read.required > 0)
+                {
+                    readError = "unexpected end of file";
+                }
+                if (!readError.empty())
+                {
+                    if (read.readId == readId)
+                    {
+                        if (error.empty())
+                        {
+                            error = readError;
+                        }
+                    }
+                    else
+                    {
+                        // the other file throws it when it waits for its reads
+                        failedReads.emplace(read.readId, readError);
+                    }
+                    pendingReads.erase(pending);
+                    continue;
+                }
+                if ((uint32_t)res < read.required)
+                {
+                    // short read, submit the rest of the request
+                    read.buf += res;
+                    read.length -= res;
+                    read.offset += res;
+                    read.required -= res;
+                    prepareRead(ring, pending->first, read);
+                    resubmitted++;
+                    continue;
+                }
+                if (read.readId == readId)
+                {
+                    remaining--;
+                }
+                else
+                {
+                    reapedCompletions[{read.readId, idx}]++;
+                }
+                pendingReads.erase(pending);
+            }
+            io_uring_cq_advance(ring, count);
+            if (resubmitted > 0)
+            {
+                ret = io_uring_submit(ring);
+                if (ret < resubmitted)
+                {
+                    throw InvalidArgumentException(
+                        "DirectUringRandomAccessFile::readAsyncComplete: resubmit fails, "
+                        "return value " + std::to_string(ret));
+                }
+            }
+            if (!error.empty())
             {
                 throw InvalidArgumentException(
-                    "DirectUringRandomAccessFile::readAsyncComplete: wait cqe fails");
+                    "DirectUringRandomAccessFile::readAsyncComplete: " + error);
             }
-            io_uring_cqe_seen(ring, cqe);
         }
     }
 }
@@ -59,6 +59,11 @@ public:
 
     bool isNone();
 
+    /**
+     * @return the number of bits set in the mask
+     */
+    long count();
+
     void set();
 
     void set(long index, uint8_t value);
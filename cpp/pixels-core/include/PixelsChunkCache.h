@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_PIXELSCHUNKCACHE_H
+#define PIXELS_PIXELSCHUNKCACHE_H
+
+#include "PixelsFooterCache.h"
+#include "physical/natives/ByteBuffer.h"
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The cache of the column chunks read from the files, shared by all the queries in the process,
+ * so that the hot chunks of repeated queries are read from memory. It is split into shards,
+ * each of which has its own lock and replaces the chunks by 2Q: a chunk read for the first time
+ * enters a small FIFO queue, and only a chunk read again after it left that queue enters the
+ * main LRU queue, so that a large scan does not flush the chunks that are used repeatedly.
+ * The chunks being decoded are pinned by the buffers returned by get, and are not evicted.
+ */
+class PixelsChunkCache
+{
+public:
+    /**
+     * @return the chunk cache of this process, whose byte budget and number of shards are set by
+     * pixel.chunk.cache.size and pixel.chunk.cache.shards, or nullptr if the budget is 0
+     */
+    static std::shared_ptr <PixelsChunkCache> Instance();
+
+    explicit PixelsChunkCache(uint64_t capacity, int shardNum = DEFAULT_SHARD_NUM);
+
+    /**
+     * @return a buffer of the cached chunk of the column in the row group of this version of the
+     * file, which pins the chunk until it is released, or nullptr if the chunk is not cached
+     */
+    std::shared_ptr <ByteBuffer> get(const std::string &path, const PixelsFooterCache::FileVersion &version,
+                                     int rgId, int colId);
+
+    /**
+     * Cache a copy of the chunk, if it is admitted.
+     */
+    void put(const std::string &path, const PixelsFooterCache::FileVersion &version, int rgId, int colId,
+             const std::shared_ptr <ByteBuffer> &chunk);
+
+    void clear();
+
+    long getHitCount() const;
+
+    long getMissCount() const;
+
+    long getEvictionCount() const;
+
+    uint64_t getUsedBytes();
+
+    static constexpr int DEFAULT_SHARD_NUM = 16;
+
+private:
+    enum class Queue
+    {
+        In,
+        Main
+    };
+
+    struct Entry
+    {
+        PixelsFooterCache::FileVersion version;
+        std::shared_ptr <ByteBuffer> data;
+        uint64_t bytes;
+        Queue queue;
+        std::list<std::string>::iterator position;
+    };
+
+    struct Shard
+    {
+        std::mutex lock;
+        std::unordered_map <std::string, Entry> entries;
+        // the chunks read once, the newest at the front
+        std::list <std::string> in;
+        uint64_t inBytes = 0;
+        // the chunks read again, the most recently used at the front
+        std::list <std::string> main;
+        // the keys of the chunks evicted from the in queue and their bytes, the newest at the front
+        std::list <std::pair<std::string, uint64_t>> out;
+        std::unordered_map <std::string, std::list<std::pair<std::string, uint64_t>>::iterator> outIndex;
+        uint64_t outBytes = 0;
+        uint64_t usedBytes = 0;
+    };
+
+    Shard &getShard(const std::string &key);
+
+    static std::string chunkKey(const std::string &path, int rgId, int colId);
+
+    void erase(Shard &shard, std::unordered_map<std::string, Entry>::iterator it);
+
+    // evict the unpinned chunks of the shard until it is within its budget
+    void evict(Shard &shard);
+
+    // evict the least recent unpinned chunk of the queue, return false if all of them are pinned
+    bool evictFrom(Shard &shard, std::list <std::string> &queue);
+
+    std::vector <std::unique_ptr<Shard>> shards;
+    uint64_t shardCapacity;
+    // the share of the in queue and the bytes of the chunks remembered by the out queue
+    uint64_t inCapacity;
+    uint64_t outCapacity;
+    std::atomic<long> hitCount;
+    std::atomic<long> missCount;
+    std::atomic<long> evictionCount;
+};
+#endif //PIXELS_PIXELSCHUNKCACHE_H
@@ -35,6 +35,7 @@
 #include "PixelsBitMask.h"
 #include "vector/ColumnVector.h"
 #include "TypeDescription.h"
+#include "pixels-common/pixels.pb.h"
 #include <immintrin.h>
 #include <avxintrin.h>
 
@@ -43,13 +44,45 @@
 class PixelsFilter
 {
 public:
+    /**
+     * Evaluate the filter on the rows of the vector into the mask. The rows whose bits are not
+     * set in the mask on entry may be left unevaluated, so their bits are only meaningful once
+     * the mask is intersected with the incoming one.
+     */
     static void ApplyFilter(std::shared_ptr <ColumnVector> vector, duckdb::TableFilter &filter,
                             PixelsBitMask &filterMask,
                             std::shared_ptr <TypeDescription> type);
 
+    /**
+     * Check whether any value described by the column statistic may satisfy the filter.
+     * It returns false only if the statistic proves that no value can match, so that
+     * the row group or pixel covered by the statistic can be skipped safely.
+     * @param filter the pushed-down filter of this column
+     * @param stat the statistic of the column chunk or pixel
+     * @param type the type of this column
+     * @return false if the statistic excludes all values, otherwise true
+     */
+    static bool CheckStatistic(duckdb::TableFilter &filter, const pixels::proto::ColumnStatistic &stat,
+                               std::shared_ptr <TypeDescription> type);
+
+    template<class T>
+    static bool CheckRange(duckdb::ExpressionType comparison, const T &constant,
+                           const T &minimum, const T &maximum);
+
     template<class T, class OP>
     static int CompareAvx2(void *data, T constant);
 
+    /**
+     * Compare 8 consecutive 128-bit values with the constant.
+     * @return the mask of the values that satisfy the comparison, one bit per value
+     */
+    template<class OP>
+    static int CompareInt128Avx2(const duckdb::hugeint_t *data, __int128 constant);
+
+    template<class OP>
+    static void LongDecimalFilterOperation(std::shared_ptr <ColumnVector> vector,
+                                           const duckdb::Value &constant, PixelsBitMask &filter_mask);
+
     template<class T, class OP>
     static void TemplatedFilterOperation(std::shared_ptr <ColumnVector> vector,
                                          const duckdb::Value &constant, PixelsBitMask &filter_mask,
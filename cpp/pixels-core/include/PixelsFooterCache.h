@@ -28,32 +28,117 @@
 #include <iostream>
 #include <string>
 #include "pixels-common/pixels.pb.h"
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 using namespace pixels::proto;
-typedef std::unordered_map <std::string, std::shared_ptr<FileTail>> FileTailTable;
-typedef std::unordered_map <std::string, std::shared_ptr<RowGroupFooter>> RGFooterTable;
 
+/**
+ * The cache of the file tails and the row group footers, shared by all the queries in the process.
+ * It is split into shards, each of which has its own lock and evicts the least recently used
+ * footers once it exceeds its share of the byte budget. A cached footer is only returned if the
+ * file still has the length and the modification time that it had when the footer was read.
+ */
 class PixelsFooterCache
 {
 public:
-    PixelsFooterCache();
+    /**
+     * The version of a file, which changes if the file is rewritten.
+     */
+    struct FileVersion
+    {
+        long length = -1;
+        long modifyTime = -1;
+
+        bool operator==(const FileVersion &other) const
+        {
+            return length == other.length && modifyTime == other.modifyTime;
+        }
+    };
+
+    /**
+     * @return the footer cache of this process, whose byte budget and number of shards are set
+     * by pixel.footer.cache.size and pixel.footer.cache.shards
+     */
+    static std::shared_ptr <PixelsFooterCache> Instance();
+
+    explicit PixelsFooterCache(uint64_t capacity = DEFAULT_CAPACITY, int shardNum = DEFAULT_SHARD_NUM);
+
+    /**
+     * @param path the path of the file, with or without the file:// scheme
+     * @return the current version of the file, or a version with length -1 if the file is not
+     * accessible
+     */
+    static FileVersion getFileVersion(const std::string &path);
+
+    /**
+     * @return the cached file tail of this version of the file, or nullptr if it is not cached
+     */
+    std::shared_ptr <FileTail> getFileTail(const std::string &path, const FileVersion &version);
+
+    void putFileTail(const std::string &path, const FileVersion &version, std::shared_ptr <FileTail> fileTail);
+
+    /**
+     * @return the cached footer of this row group in this version of the file, or nullptr if
+     * it is not cached
+     */
+    std::shared_ptr <RowGroupFooter> getRGFooter(const std::string &path, const FileVersion &version, int rgId);
 
-    void putFileTail(const std::string &id, std::shared_ptr <FileTail> fileTail);
+    void putRGFooter(const std::string &path, const FileVersion &version, int rgId,
+                     std::shared_ptr <RowGroupFooter> footer);
 
-    bool containsFileTail(const std::string &id);
+    void clear();
 
-    std::shared_ptr <FileTail> getFileTail(const std::string &id);
+    long getHitCount() const;
 
-    void putRGFooter(const std::string &id, std::shared_ptr <RowGroupFooter> footer);
+    long getMissCount() const;
 
-    bool containsRGFooter(const std::string &id);
+    long getEvictionCount() const;
 
-    std::shared_ptr <RowGroupFooter> getRGFooter(const std::string &id);
+    uint64_t getUsedBytes();
+
+    /**
+     * @return the byte budget of the cache, i.e., the sum of the budgets of the shards
+     */
+    uint64_t getCapacity() const;
+
+    static constexpr uint64_t DEFAULT_CAPACITY = 256UL * 1024 * 1024;
+    static constexpr int DEFAULT_SHARD_NUM = 16;
 
 private:
-    FileTailTable fileTailCacheMap;
-    RGFooterTable rowGroupFooterCacheMap;
+    struct Entry
+    {
+        FileVersion version;
+        std::shared_ptr <google::protobuf::Message> value;
+        uint64_t bytes;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    struct Shard
+    {
+        std::mutex lock;
+        std::unordered_map <std::string, Entry> entries;
+        // the most recently used key is at the front
+        std::list <std::string> lru;
+        uint64_t usedBytes = 0;
+    };
+
+    std::shared_ptr <google::protobuf::Message> get(const std::string &key, const FileVersion &version);
+
+    void put(const std::string &key, const FileVersion &version, std::shared_ptr <google::protobuf::Message> value);
+
+    Shard &getShard(const std::string &key);
+
+    static std::string rgFooterKey(const std::string &path, int rgId);
 
+    std::vector <std::unique_ptr<Shard>> shards;
+    uint64_t shardCapacity;
+    std::atomic<long> hitCount;
+    std::atomic<long> missCount;
+    std::atomic<long> evictionCount;
 };
 #endif //PIXELS_PIXELSFOOTERCACHE_H
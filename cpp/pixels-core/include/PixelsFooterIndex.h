@@ -0,0 +1,147 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_PIXELSFOOTERINDEX_H
+#define PIXELS_PIXELSFOOTERINDEX_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "PixelsFooterCache.h"
+
+/**
+ * The footer index of a directory, which is a sidecar file holding the serialized file tails
+ * and row group footers of the pxl files in the directory. It is memory mapped, so that a newly
+ * started process finds the footers of a file without opening and reading the file. Each file
+ * is recorded with its length and modification time, and the footers of a file that has been
+ * rewritten since the index was built are not returned.
+ *
+ * <p>The layout of the index file, in little endian:</p>
+ * <pre>
+ * header:  magic "PXFI", version (u32), number of files (u32), reserved (u32)
+ * files:   one FileEntry per file, sorted by the file name
+ * footers: one Section per row group of each file, referenced by FileEntry::rgOffset
+ * data:    the file names, the serialized file tails and the serialized row group footers
+ * </pre>
+ */
+class PixelsFooterIndex
+{
+public:
+    ~PixelsFooterIndex();
+
+    /**
+     * Get the footer index of the directory. The index is mapped once and shared by the process,
+     * and it is mapped again if the index file has been rebuilt.
+     * @param directory the directory of the pxl files
+     * @return the footer index, or nullptr if the directory has no valid index
+     */
+    static std::shared_ptr <PixelsFooterIndex> open(const std::string &directory);
+
+    /**
+     * @param filePath the path of a pxl file
+     * @return the footer index of the directory of the file, or nullptr if there is no valid index
+     */
+    static std::shared_ptr <PixelsFooterIndex> openForFile(const std::string &filePath);
+
+    /**
+     * Write the footers of the pxl files in the directory into the index file of the directory.
+     * The footers of the files that have not changed since the existing index was built are
+     * taken from it, and only the new and changed files are read. The index file is replaced
+     * atomically. It is called offline, e.g., by the FOOTER_INDEX command of pixels-cli, as the
+     * scans only read the index.
+     * @param directory the directory of the pxl files
+     * @return false if the index file can not be written
+     */
+    static bool build(const std::string &directory);
+
+    /**
+     * @return true if the footer index is enabled by pixel.footer.index.enabled
+     */
+    static bool isEnabled();
+
+    /**
+     * @return the file tail of this version of the file, or nullptr if it is not in the index
+     */
+    std::shared_ptr <FileTail> getFileTail(const std::string &filePath, const PixelsFooterCache::FileVersion &version);
+
+    /**
+     * @return the footer of the row group in this version of the file, or nullptr if it is not
+     * in the index
+     */
+    std::shared_ptr <RowGroupFooter> getRGFooter(const std::string &filePath,
+                                                 const PixelsFooterCache::FileVersion &version, int rgId);
+
+    static const std::string INDEX_FILE_NAME;
+
+private:
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t fileNum;
+        uint32_t reserved;
+    };
+
+    struct FileEntry
+    {
+        uint64_t nameOffset;
+        uint32_t nameLength;
+        uint32_t rgNum;
+        int64_t length;
+        int64_t modifyTime;
+        uint64_t tailOffset;
+        uint32_t tailLength;
+        uint32_t reserved;
+        uint64_t rgOffset;
+    };
+
+    struct Section
+    {
+        uint64_t offset;
+        uint32_t length;
+        uint32_t reserved;
+    };
+
+    PixelsFooterIndex(const uint8_t *data, uint64_t size, PixelsFooterCache::FileVersion version);
+
+    static std::shared_ptr <PixelsFooterIndex> map(const std::string &indexPath,
+                                                   const PixelsFooterCache::FileVersion &version);
+
+    bool validate() const;
+
+    const FileEntry *find(const std::string &fileName, const PixelsFooterCache::FileVersion &version) const;
+
+    const uint8_t *data;
+    uint64_t size;
+    // the version of the index file itself
+    PixelsFooterCache::FileVersion version;
+
+    static std::mutex indexesLock;
+    static std::unordered_map <std::string, std::shared_ptr<PixelsFooterIndex>> indexes;
+
+    static constexpr uint32_t FORMAT_VERSION = 1;
+};
+#endif //PIXELS_PIXELSFOOTERINDEX_H
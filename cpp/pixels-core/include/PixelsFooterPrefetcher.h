@@ -0,0 +1,122 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_PIXELSFOOTERPREFETCHER_H
+#define PIXELS_PIXELSFOOTERPREFETCHER_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include "PixelsFooterCache.h"
+#include "PixelsFooterIndex.h"
+
+/**
+ * Reads the file tails and the row group footers of the files of a scan into the footer cache,
+ * so that the scan threads open their files without waiting for the footers. The reads of many
+ * files are submitted to one io_uring and up to pixel.footer.prefetch.depth of them are in flight
+ * at a time, so that prefetching a thousand files costs a few round trips to the storage rather
+ * than a thousand. The files are opened in windows of pixel.footer.prefetch.depth files, so a
+ * scan of many files does not run out of fds.
+ *
+ * The file tails are needed to plan the scan and are read when the scan is bound. The row group
+ * footers are only needed when a row group is read, so they are read in the background while the
+ * scan runs, and only as many of them as fit in the byte budget of the footer cache.
+ */
+class PixelsFooterPrefetcher
+{
+public:
+    /**
+     * Read the file tails of the files into the footer cache. The file tails that are already in
+     * the cache or in the footer index of the directory are not read again.
+     * @param filePaths the paths of the pxl files, with or without the file:// scheme
+     * @param footerCache the footer cache to fill
+     * @return the file tail of each file, or nullptr for a file whose tail can not be read
+     */
+    static std::vector <std::shared_ptr<FileTail>> prefetchFileTails(const std::vector <std::string> &filePaths,
+                                                                     std::shared_ptr <PixelsFooterCache> footerCache);
+
+    /**
+     * Read the row group footers of the files into the footer cache, in the order of the files.
+     * The footers that are already in the cache or in the footer index of the directory are not
+     * read again. It stops queuing footers once the footers of this scan would fill the byte
+     * budget of the footer cache, as they would only evict each other.
+     * @param filePaths the paths of the pxl files, with or without the file:// scheme
+     * @param fileTails the file tails returned by prefetchFileTails
+     * @param footerCache the footer cache to fill
+     * @param cancelled checked between the windows of files, set it to stop prefetching early
+     */
+    static void prefetchRGFooters(const std::vector <std::string> &filePaths,
+                                  const std::vector <std::shared_ptr<FileTail>> &fileTails,
+                                  std::shared_ptr <PixelsFooterCache> footerCache,
+                                  const std::atomic<bool> &cancelled);
+
+private:
+    struct PrefetchedFile
+    {
+        // the path without the scheme, which is the key of the footer cache
+        std::string path;
+        PixelsFooterCache::FileVersion version;
+        int fd = -1;
+        std::shared_ptr <FileTail> fileTail;
+        std::shared_ptr <PixelsFooterIndex> footerIndex;
+    };
+
+    struct ReadRequest
+    {
+        int fd;
+        uint64_t offset;
+        std::string buffer;
+        uint64_t done;
+        bool failed;
+    };
+
+    static std::string stripScheme(const std::string &filePath);
+
+    /**
+     * Read the file tails of a window of files, leaving the files that had to be read open in
+     * their fd.
+     */
+    static void prefetchTailWindow(std::vector <PrefetchedFile> &files, std::shared_ptr <PixelsFooterCache> footerCache,
+                                   int queueDepth, long tailReadSize, bool useFooterIndex);
+
+    /**
+     * Read the row group footers of a window of files, leaving the files that had to be read
+     * open in their fd. cachedBytes is the number of bytes this scan has put into the cache so
+     * far, no footer is queued once it would exceed the budget.
+     * @return false if the budget is reached
+     */
+    static bool prefetchFooterWindow(std::vector <PrefetchedFile> &files,
+                                     std::shared_ptr <PixelsFooterCache> footerCache,
+                                     int queueDepth, uint64_t budget, uint64_t &cachedBytes);
+
+    /**
+     * Read all the requests with at most queueDepth of them in flight. The requests that fail
+     * or reach the end of the file are marked failed.
+     */
+    static void readAll(std::vector <ReadRequest> &requests, int queueDepth);
+
+    static void readAllSync(std::vector <ReadRequest> &requests);
+};
+#endif //PIXELS_PIXELSFOOTERPREFETCHER_H
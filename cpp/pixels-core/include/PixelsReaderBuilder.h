@@ -30,6 +30,7 @@
 #include "pixels-common/pixels.pb.h"
 #include "PixelsVersion.h"
 #include "PixelsFooterCache.h"
+#include "PixelsFooterIndex.h"
 #include "exception/PixelsReaderException.h"
 #include "exception/InvalidArgumentException.h"
 #include "exception/PixelsFileVersionInvalidException.h"
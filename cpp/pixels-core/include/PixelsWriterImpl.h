@@ -33,6 +33,7 @@
 #include "stats/StatsRecorder.h"
 #include "pixels-common/pixels.pb.h"
 #include "vector/VectorizedRowBatch.h"
+#include "compression/CompressionCodec.h"
 #include <unicode/timezone.h>
 #include <unicode/unistr.h>
 #include <unicode/locid.h>
@@ -40,9 +41,15 @@
 class PixelsWriterImpl : public PixelsWriter
 {
 public:
+    /**
+     * @param compressionBlockSize the maximum number of raw bytes, in KiB, compressed as a block
+     * @param compressionKind the block compression applied to the column chunks, PostScript.blockCompressed
+     * is set if it is not NONE
+     */
     PixelsWriterImpl(std::shared_ptr <TypeDescription> schema, int pixelsStride, int rowGroupSize,
                      const std::string &targetFilePath, int blockSize, bool blockPadding,
-                     EncodingLevel encodingLevel, bool nullsPadding, bool partitioned, int compressionBlockSize);
+                     EncodingLevel encodingLevel, bool nullsPadding, bool partitioned, int compressionBlockSize,
+                     pixels::proto::CompressionKind compressionKind = pixels::proto::CompressionKind::NONE);
 
     bool addRowBatch(std::shared_ptr <VectorizedRowBatch> rowBatch) override;
 
@@ -68,12 +75,13 @@ private:
     int rowGroupSize;
     pixels::proto::CompressionKind compressionKind;
     int compressionBlockSize;
+    std::shared_ptr <CompressionCodec> compressionCodec;
     // std::unique_ptr<icu::TimeZone> timeZone;
     std::shared_ptr <PixelsWriterOption> columnWriterOption;
     std::vector <std::shared_ptr<ColumnWriter>> columnWriters;
-    std::vector <StatsRecorder> fileColStatRecorders;
-    std::int64_t fileContentLength;
-    int fileRowNum;
+    std::vector <std::unique_ptr<StatsRecorder>> fileColStatRecorders;
+    std::int64_t fileContentLength = 0;
+    int fileRowNum = 0;
     std::int64_t writtenBytes = 0;
     std::int64_t curRowGroupOffset = 0;
     std::int64_t curRowGroupFooterOffset = 0;
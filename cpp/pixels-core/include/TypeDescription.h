@@ -42,9 +42,12 @@
 #include "vector/ByteColumnVector.h"
 #include "vector/BinaryColumnVector.h"
 #include "vector/DecimalColumnVector.h"
+#include "vector/LongDecimalColumnVector.h"
 #include "vector/DateColumnVector.h"
 #include "vector/TimestampColumnVector.h"
 #include "vector/IntColumnVector.h"
+#include "vector/FloatColumnVector.h"
+#include "vector/DoubleColumnVector.h"
 
 struct CategoryProperty
 {
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_COMPRESSIONCODEC_H
+#define PIXELS_COMPRESSIONCODEC_H
+
+#include "pixels-common/pixels.pb.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * The block compression of column chunks, which only the files with PostScript.blockCompressed set apply (see the
+ * CompressionKind in pixels.proto). A compressed column chunk is a sequence
+ * of blocks, each of which is prefixed by an 8-byte little endian header holding
+ * the compressed length and the raw length of the block. If the highest bit of the
+ * compressed length is set, the block is stored as is since it did not shrink.
+ * The pixel positions and the isNull offset in the chunk index are offsets in the
+ * raw (decompressed) chunk.
+ */
+class CompressionCodec
+{
+public:
+    static const int BLOCK_HEADER_SIZE = 8;
+
+    virtual ~CompressionCodec() = default;
+
+    /**
+     * @param kind the compression kind in the post script
+     * @return the codec of the kind, or nullptr if the kind is NONE
+     */
+    static std::shared_ptr <CompressionCodec> create(pixels::proto::CompressionKind kind);
+
+    /**
+     * Compress the content of a column chunk block by block.
+     * @param content the raw content of the column chunk
+     * @param blockSize the maximum number of raw bytes in a block
+     * @return the compressed column chunk
+     */
+    std::vector <uint8_t> compressChunk(const std::vector <uint8_t> &content, int blockSize) const;
+
+    /**
+     * @return the number of bytes of the column chunk after decompression
+     */
+    static uint64_t getRawChunkLength(const uint8_t *chunk, uint64_t length);
+
+    /**
+     * Decompress a column chunk into dst, which holds at least getRawChunkLength() bytes.
+     */
+    void decompressChunk(const uint8_t *chunk, uint64_t length, uint8_t *dst) const;
+
+protected:
+    virtual size_t maxCompressedLength(size_t length) const = 0;
+
+    /**
+     * @return the compressed length, or 0 if the input can not be compressed into capacity bytes
+     */
+    virtual size_t compress(const uint8_t *src, size_t length, uint8_t *dst, size_t capacity) const = 0;
+
+    /**
+     * Decompress a block of exactly rawLength bytes, throws if the block is corrupted.
+     */
+    virtual void decompress(const uint8_t *src, size_t length, uint8_t *dst, size_t rawLength) const = 0;
+};
+#endif //PIXELS_COMPRESSIONCODEC_H
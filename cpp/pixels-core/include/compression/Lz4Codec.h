@@ -0,0 +1,39 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_LZ4CODEC_H
+#define PIXELS_LZ4CODEC_H
+
+#include "compression/CompressionCodec.h"
+
+class Lz4Codec : public CompressionCodec
+{
+protected:
+    size_t maxCompressedLength(size_t length) const override;
+
+    size_t compress(const uint8_t *src, size_t length, uint8_t *dst, size_t capacity) const override;
+
+    void decompress(const uint8_t *src, size_t length, uint8_t *dst, size_t rawLength) const override;
+};
+#endif //PIXELS_LZ4CODEC_H
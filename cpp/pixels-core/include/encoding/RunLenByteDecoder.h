@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_RUNLENBYTEDECODER_H
+#define PIXELS_RUNLENBYTEDECODER_H
+
+#include "encoding/Decoder.h"
+
+/**
+ * The decoder of the run length encoded bytes. Each run starts with a control byte:
+ * a control byte c in [0, 127] is followed by a byte repeated c + 3 times, and a
+ * control byte c in [-128, -1] is followed by -c literal bytes.
+ */
+class RunLenByteDecoder : public Decoder
+{
+public:
+    explicit RunLenByteDecoder(const std::shared_ptr <ByteBuffer> &bb);
+
+    void close() override;
+
+    long next() override;
+
+    /**
+     * Decode the next len bytes into values, the repeated runs are filled with
+     * memset and the literal runs are copied with memcpy.
+     */
+    void next(uint8_t *values, int len);
+
+    void skip(long numValues);
+
+    bool hasNext() override;
+
+private:
+    void readRun();
+
+    static const int MIN_REPEAT_SIZE = 3;
+
+    std::shared_ptr <ByteBuffer> inputStream;
+    // the number of values left in the current run
+    int remaining;
+    bool repeat;
+    uint8_t repeatValue;
+};
+#endif //PIXELS_RUNLENBYTEDECODER_H
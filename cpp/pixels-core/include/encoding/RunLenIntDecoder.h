@@ -41,6 +41,24 @@ public:
 
     long next() override;
 
+    /**
+     * Decode the next len values into values. The runs that fit in the
+     * destination as a whole are decoded straight into it without going
+     * through the literals buffer.
+     * @param values the destination of the decoded values
+     * @param len the number of values to decode
+     */
+    void next(int32_t *values, int len);
+
+    void next(int64_t *values, int len);
+
+    /**
+     * Skip the next values without materializing them. The runs that are
+     * skipped as a whole are not unpacked.
+     * @param numValues the number of values to skip
+     */
+    void skip(long numValues);
+
     bool hasNext() override;
 
     ~RunLenIntDecoder();
@@ -49,12 +67,22 @@ private:
 
     void readValues();
 
+    long skipRun(long maxValues);
+
+    template<typename T>
+    void nextBatch(T *values, int len);
+
+    template<typename T>
+    int decodeRun(T *values, int maxValues);
+
     void readShortRepeatValues(int firstByte);
 
     void readDirectValues(int firstByte);
 
     void readDeltaValues(int firstByte);
 
+    void readPatchedBaseValues(int firstByte);
+
     long readVulong(const std::shared_ptr <ByteBuffer> &input);
 
     long readVslong(const std::shared_ptr <ByteBuffer> &input);
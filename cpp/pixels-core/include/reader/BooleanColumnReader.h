@@ -0,0 +1,57 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_BOOLEANCOLUMNREADER_H
+#define PIXELS_BOOLEANCOLUMNREADER_H
+
+#include "reader/ColumnReader.h"
+#include "vector/ByteColumnVector.h"
+
+class BooleanColumnReader : public ColumnReader
+{
+public:
+    explicit BooleanColumnReader(std::shared_ptr <TypeDescription> type);
+
+    void close() override;
+
+    void read(std::shared_ptr <ByteBuffer> input,
+              pixels::proto::ColumnEncoding &encoding,
+              int offset, int size, int pixelStride,
+              int vectorIndex, std::shared_ptr <ColumnVector> vector,
+              pixels::proto::ColumnChunkIndex &chunkIndex,
+              std::shared_ptr <PixelsBitMask> filterMask) override;
+
+    void skip(std::shared_ptr <ByteBuffer> input,
+              pixels::proto::ColumnEncoding &encoding,
+              int offset, int size, int pixelStride,
+              pixels::proto::ColumnChunkIndex &chunkIndex) override;
+
+private:
+    /**
+     * The position of the next value in the column chunk, in bits.
+     */
+    uint64_t bitOffset;
+};
+
+#endif //PIXELS_BOOLEANCOLUMNREADER_H
@@ -67,10 +67,34 @@ public:
                       pixels::proto::ColumnChunkIndex &chunkIndex,
                       std::shared_ptr <PixelsBitMask> filterMask);
 
+    /**
+     * Skip values in the input buffer without decoding them into a vector.
+     * [offset, offset + size) covers either whole pixels or one batch inside a
+     * pixel, so that the next read continues right after the skipped values.
+     *
+     * @param input    input buffer
+     * @param encoding encoding type
+     * @param offset   starting offset of the values to skip
+     * @param size     number of values to skip
+     * @param pixelStride the stride (number of rows) in a pixels.
+     * @param chunkIndex the metadata of the column chunk to read.
+     */
+    virtual void skip(std::shared_ptr <ByteBuffer> input,
+                      pixels::proto::ColumnEncoding &encoding,
+                      int offset, int size, int pixelStride,
+                      pixels::proto::ColumnChunkIndex &chunkIndex);
+
     void setValid(const std::shared_ptr <ByteBuffer> &input, int pixelStride,
                   const std::shared_ptr <ColumnVector> &columnVector, int pixelId, bool hasNull);
 
 protected:
+    /**
+     * Count the nulls in [offset, offset + size) by the isNull bitmaps from isNullOffset,
+     * which is not moved. The range covers either whole pixels or one batch inside a pixel.
+     */
+    int countNulls(const std::shared_ptr <ByteBuffer> &input, int offset, int size, int pixelStride,
+                   const pixels::proto::ColumnChunkIndex &chunkIndex) const;
+
     int elementIndex;
     std::shared_ptr <TypeDescription> type;
     uint32_t isNullOffset;
@@ -26,13 +26,18 @@
 #define PIXELS_COLUMNREADERBUILDER_H
 
 #include "reader/ColumnReader.h"
+#include "reader/BooleanColumnReader.h"
+#include "reader/ByteColumnReader.h"
 #include "reader/CharColumnReader.h"
 #include "reader/VarcharColumnReader.h"
 #include "reader/DecimalColumnReader.h"
+#include "reader/LongDecimalColumnReader.h"
 #include "reader/DateColumnReader.h"
 #include "reader/TimestampColumnReader.h"
 #include "reader/IntColumnReader.h"
 #include "reader/LongColumnReader.h"
+#include "reader/FloatColumnReader.h"
+#include "reader/DoubleColumnReader.h"
 #include "reader/StringColumnReader.h"
 
 class ColumnReaderBuilder
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_FILTERCOLUMNSTAT_H
+#define PIXELS_FILTERCOLUMNSTAT_H
+
+#include "duckdb/planner/table_filter.hpp"
+#include <limits>
+#include <vector>
+
+/**
+ * The runtime statistics of a filter column, used to order the filter columns
+ * so that the cheap and selective ones are evaluated first.
+ */
+class FilterColumnStat
+{
+public:
+    int columnIndex; // the index of the column in the result schema
+    duckdb::TableFilter *filter;
+    double inputRows;
+    double passedRows;
+    double costNanos;
+
+    FilterColumnStat(int index, duckdb::TableFilter *f)
+    {
+        columnIndex = index;
+        filter = f;
+        inputRows = 0;
+        passedRows = 0;
+        costNanos = 0;
+    }
+
+    /**
+     * @return the evaluation cost per row divided by the fraction of rows rejected,
+     * the filter column with the smallest rank should be evaluated first
+     */
+    double rank() const
+    {
+        if (inputRows == 0)
+        {
+            // not evaluated yet, try it first to collect its statistics
+            return 0;
+        }
+        double rejectRate = 1.0 - passedRows / inputRows;
+        if (rejectRate <= 0)
+        {
+            return std::numeric_limits<double>::max();
+        }
+        return costNanos / inputRows / rejectRate;
+    }
+};
+
+/**
+ * The statistics of the filter columns of a scan thread. They are kept across the morsels of the
+ * thread, so that the record reader of each morsel starts from the order learned by the previous
+ * ones instead of the order of the filters.
+ */
+class FilterColumnStats
+{
+public:
+    // the filter columns in the order they are evaluated
+    std::vector <FilterColumnStat> stats;
+    // the number of batches filtered since the statistics were created
+    int batchNum = 0;
+};
+
+#endif //PIXELS_FILTERCOLUMNSTAT_H
@@ -42,6 +42,11 @@ public:
             pixels::proto::ColumnChunkIndex &chunkIndex,
             std::shared_ptr <PixelsBitMask> filterMask) override;
 
+  void skip(std::shared_ptr <ByteBuffer> input,
+            pixels::proto::ColumnEncoding &encoding,
+            int offset, int size, int pixelStride,
+            pixels::proto::ColumnChunkIndex &chunkIndex) override;
+
 private:
   std::shared_ptr <RunLenIntDecoder> decoder;
 };
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_LONGDECIMALCOLUMNREADER_H
+#define PIXELS_LONGDECIMALCOLUMNREADER_H
+
+#include "reader/ColumnReader.h"
+#include "vector/LongDecimalColumnVector.h"
+
+class LongDecimalColumnReader : public ColumnReader
+{
+public:
+    explicit LongDecimalColumnReader(std::shared_ptr <TypeDescription> type);
+
+    void close() override;
+
+    void read(std::shared_ptr <ByteBuffer> input,
+              pixels::proto::ColumnEncoding &encoding,
+              int offset, int size, int pixelStride,
+              int vectorIndex, std::shared_ptr <ColumnVector> vector,
+              pixels::proto::ColumnChunkIndex &chunkIndex,
+              std::shared_ptr <PixelsBitMask> filterMask) override;
+
+    void skip(std::shared_ptr <ByteBuffer> input,
+              pixels::proto::ColumnEncoding &encoding,
+              int offset, int size, int pixelStride,
+              pixels::proto::ColumnChunkIndex &chunkIndex) override;
+
+    /**
+     * Convert the unscaled values in the column chunk, each of which is written as the high
+     * 64 bits followed by the low 64 bits, into the layout of duckdb hugeint.
+     * @param input the unscaled values in the column chunk
+     * @param output the hugeint values
+     * @param num the number of values to convert
+     * @param littleEndian whether the 64-bit words in the column chunk are little endian
+     */
+    static void toHugeint(const uint8_t *input, duckdb::hugeint_t *output, int num, bool littleEndian);
+
+    static constexpr int VALUE_SIZE = 16;
+};
+
+#endif //PIXELS_LONGDECIMALCOLUMNREADER_H
@@ -29,6 +29,8 @@
 #include <string>
 #include <vector>
 #include "duckdb/planner/table_filter.hpp"
+#include "reader/FilterColumnStat.h"
+#include <memory>
 
 class PixelsReaderOption
 {
@@ -77,6 +79,14 @@ class PixelsReaderOption
 
   bool isEnableEncodedColumnVector();
 
+  /**
+   * Share the statistics of the filter columns with the record readers of the other morsels of
+   * the scan thread. If it is not set, the record reader collects its own statistics.
+   */
+  void setFilterColumnStats(std::shared_ptr<FilterColumnStats> stats);
+
+  std::shared_ptr<FilterColumnStats> getFilterColumnStats() const;
+
  private:
   std::vector<std::string> includedCols;
   duckdb::TableFilterSet *filter;
@@ -90,5 +100,6 @@ class PixelsReaderOption
   int rgStart;
   int rgLen;
  int ringIndex;
+  std::shared_ptr<FilterColumnStats> filterColumnStats;
 };
 #endif //PIXELS_PIXELSREADEROPTION_H
@@ -32,7 +32,10 @@
 #include "physical/SchedulerFactory.h"
 #include "pixels-common/pixels.pb.h"
 #include "PixelsFooterCache.h"
+#include "PixelsChunkCache.h"
+#include "PixelsFooterIndex.h"
 #include "reader/PixelsReaderOption.h"
+#include "reader/FilterColumnStat.h"
 #include "utils/String.h"
 #include "TypeDescription.h"
 #include "reader/ColumnReader.h"
@@ -41,6 +44,7 @@
 #include "physical/BufferPool.h"
 #include "physical/natives/DirectUringRandomAccessFile.h"
 #include "PixelsFilter.h"
+#include "compression/CompressionCodec.h"
 
 class ChunkId
 {
@@ -61,6 +65,22 @@ public:
     }
 };
 
+/**
+ * A byte range [start, end) inside a column chunk.
+ */
+class ChunkRange
+{
+public:
+    uint32_t start;
+    uint32_t end;
+
+    ChunkRange(uint32_t s, uint32_t e)
+    {
+        start = s;
+        end = e;
+    }
+};
+
 class PixelsRecordReaderImpl : public PixelsRecordReader
 {
 public:
@@ -79,10 +99,27 @@ public:
 
     bool read();
 
+    /**
+     * Read the chunks of the current row group into the current BufferPool buffer.
+     * @param mayWait whether to wait for the other scans if the memory budget is used up
+     * @return false if mayWait is false and the memory budget is used up, nothing is read then
+     */
+    bool read(bool mayWait);
+
     std::shared_ptr <PixelsBitMask> getFilterMask();
 
     bool isEndOfFile() override;
 
+    /**
+     * @return the number of row groups skipped by the row group statistics
+     */
+    int getPrunedRGNum() const;
+
+    /**
+     * @return the number of pixels skipped by the pixel statistics
+     */
+    int getPrunedPixelNum() const;
+
     ~PixelsRecordReaderImpl();
 
     void close() override;
@@ -98,11 +135,64 @@ private:
 
     void UpdateRowGroupInfo();
 
+    bool checkRowGroupStatistic(int rgId);
+
+    bool checkPixelStatistic(int pixelId);
+
+    /**
+     * @return whether each pixel in the current row group may match the filter,
+     * or an empty vector if all the pixels may match.
+     */
+    std::vector<bool> getSurvivingPixels();
+
+    /**
+     * @return true if the pixels of the column can be read and decoded separately by pixelPositions
+     */
+    static bool isPixelAddressable(const std::shared_ptr <TypeDescription> &type);
+
+    /**
+     * Turn the surviving pixels of a column chunk into byte ranges inside the chunk.
+     * Ranges closer than coalesceGap bytes are merged into one.
+     * @param ranges the byte ranges to read, it is empty if no pixel survives
+     * @return false if the whole chunk should be read instead
+     */
+    static bool planChunkRanges(const pixels::proto::ColumnChunkIndex &chunkIndex,
+                                const std::vector<bool> &survivingPixels, int coalesceGap,
+                                std::vector <ChunkRange> &ranges);
+
+    void skipPixels();
+
+    /**
+     * Decompress the chunks read by the last read into buffers of BufferPoolArena. It is called
+     * once the reads of the chunks complete, i.e., in asyncReadComplete for the asynchronous
+     * reads, so that the chunks are decompressed while the reads of the morsels read ahead are
+     * still in flight.
+     */
+    void decompressChunks();
+
+    /**
+     * Reorder the filter columns by their rank, and decay the statistics so that
+     * the order follows the data distribution of the recent row groups.
+     */
+    void rankFilterColumns();
+
+    /**
+     * Put the chunks read by the last read into the chunk cache, after their reads complete.
+     */
+    void cacheReadChunks();
+
     static std::mutex mutex_;
     std::shared_ptr <PhysicalReader> physicalReader;
     pixels::proto::Footer footer;
     pixels::proto::PostScript postScript;
     std::shared_ptr <PixelsFooterCache> footerCache;
+    // the cache of the column chunks shared by the queries, nullptr if it is disabled
+    std::shared_ptr <PixelsChunkCache> chunkCache;
+    std::string filePath;
+    PixelsFooterCache::FileVersion fileVersion;
+    // the columns whose whole chunks are read by the last read, and the row group id of the chunks
+    std::vector <uint32_t> chunksToCache;
+    int chunksToCacheRGId{-1};
     PixelsReaderOption option;
     duckdb::TableFilterSet *filter;
     long queryId;
@@ -112,6 +202,8 @@ private:
     bool everRead;
     bool everPrepareRead;
     int targetRGNum;
+    int prunedRGNum;
+    int prunedPixelNum;
     int curRGIdx;
     int curRowInRG;
     int batchSize;
@@ -121,6 +213,9 @@ private:
     int curRGRowCount;
     bool enabledFilterPushDown;
     std::shared_ptr <PixelsBitMask> filterMask;
+    // the filter columns in the order they are evaluated, shared by the readers of a scan thread
+    std::shared_ptr <FilterColumnStats> filterColumnStats;
+    int filterRankInterval;
     std::shared_ptr <pixels::proto::RowGroupFooter> curRGFooter;
     std::vector <std::shared_ptr<pixels::proto::ColumnEncoding>> curEncoding;
     std::vector<int> curChunkBufferIndex;
@@ -137,6 +232,18 @@ private:
 
     // buffers of each chunk in this file, arranged by chunk's row group id and column id
     std::vector <std::shared_ptr<ByteBuffer>> chunkBuffers;
+    // the block compression of the file, nullptr if the chunks are not compressed
+    std::shared_ptr <CompressionCodec> compressionCodec;
+    // whether each chunk buffer still holds the compressed chunk
+    std::vector<bool> compressedChunks;
+    /**
+     * The buffers the chunks are decompressed into, arranged as chunkBuffers. They are taken
+     * from BufferPoolArena, so that they count in the memory budget of the BufferPool buffers,
+     * and reused by every other row group, so the values of the previous row group stay valid
+     * while the current one is read, as the double buffers of BufferPool do.
+     */
+    std::vector <std::shared_ptr<ByteBuffer>> decompressedBuffers[2];
+    int decompressedBufferIdx;
     // column readers for each target columns
     std::vector <std::shared_ptr<ColumnReader>> readers;
     std::vector <uint32_t> targetColumns;
@@ -152,5 +259,8 @@ private:
     std::shared_ptr <TypeDescription> resultSchema;
     std::shared_ptr <VectorizedRowBatch> resultRowBatch;
     int asyncReadRequestNum{0};
+    // the BufferPool buffer the row groups are read into, taken by the first read, so that the
+    // later row groups do not overwrite the buffers of the files read ahead of this one
+    int poolBufferId{-1};
 };
 #endif //PIXELS_PIXELSRECORDREADERIMPL_H
@@ -44,6 +44,11 @@ public:
               pixels::proto::ColumnChunkIndex &chunkIndex,
               std::shared_ptr <PixelsBitMask> filterMask) override;
 
+    void skip(std::shared_ptr <ByteBuffer> input,
+              pixels::proto::ColumnEncoding &encoding,
+              int offset, int size, int pixelStride,
+              pixels::proto::ColumnChunkIndex &chunkIndex) override;
+
 private:
     /**
      * RLE decoder of string content element length if no dictionary encoded.
@@ -70,6 +75,26 @@ private:
     int *dictStarts;
     int startsLength;
 
+    /**
+     * If true, the dictionary encoded chunks are read into dictionary encoded
+     * column vectors, i.e., only the dictionary ids are decoded for each row.
+     */
+    bool dictionaryVector;
+    /**
+     * The dictionary entries of the current chunk followed by a null entry,
+     * shared by the column vectors of all the batches in the chunk.
+     */
+    std::vector <duckdb::string_t> dictEntries;
+    std::vector <uint64_t> dictEntriesValid;
+    /**
+     * Set when a new chunk's dictionary is materialized, so that the column vector
+     * drops the filter results cached for the entries of the previous dictionary.
+     */
+    bool dictEntriesRenewed;
+
+    void readDictionaryIds(std::shared_ptr <BinaryColumnVector> columnVector, int size, int vectorIndex,
+                           bool cascadeRLE);
+
     /**
      * In this method, we have reduced most of significant memory copies.
      */
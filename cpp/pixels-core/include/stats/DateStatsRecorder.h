@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_DATESTATSRECORDER_H
+#define PIXELS_DATESTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+#include <climits>
+
+/**
+ * The statistics of date columns, values are the days since epoch.
+ */
+class DateStatsRecorder : public StatsRecorder
+{
+public:
+    DateStatsRecorder();
+
+    explicit DateStatsRecorder(const pixels::proto::ColumnStatistic &statistic);
+
+    void updateDate(int value) override;
+
+    void updateDate(const int *values, const uint8_t *isNull, int length) override;
+
+    void merge(const StatsRecorder &other) override;
+
+    void reset() override;
+
+    pixels::proto::ColumnStatistic serialize() const override;
+
+    int getMinimum() const;
+
+    int getMaximum() const;
+
+    bool hasMinimum() const;
+
+    bool hasMaximum() const;
+
+private:
+    int minimum = INT_MAX;
+    int maximum = INT_MIN;
+    bool hasMin = false;
+    bool hasMax = false;
+};
+
+#endif // PIXELS_DATESTATSRECORDER_H
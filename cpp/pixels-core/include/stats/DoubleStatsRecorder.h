@@ -0,0 +1,70 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_DOUBLESTATSRECORDER_H
+#define PIXELS_DOUBLESTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of floating-point columns (float and double).
+ */
+class DoubleStatsRecorder : public StatsRecorder
+{
+public:
+    DoubleStatsRecorder();
+
+    explicit DoubleStatsRecorder(const pixels::proto::ColumnStatistic &statistic);
+
+    void updateFloat(float value) override;
+
+    void updateDouble(double value) override;
+
+    void updateDouble(const double *values, const uint8_t *isNull, int length) override;
+
+    void merge(const StatsRecorder &other) override;
+
+    void reset() override;
+
+    pixels::proto::ColumnStatistic serialize() const override;
+
+    double getMinimum() const;
+
+    double getMaximum() const;
+
+    bool hasMinimum() const;
+
+    bool hasMaximum() const;
+
+    double getSum() const;
+
+private:
+    double minimum = 0;
+    double maximum = 0;
+    double sum = 0;
+    bool hasMin = false;
+    bool hasMax = false;
+};
+
+#endif // PIXELS_DOUBLESTATSRECORDER_H
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_INTEGER128STATSRECORDER_H
+#define PIXELS_INTEGER128STATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of long decimal columns, recorded by the 128-bit unscaled values.
+ */
+class Integer128StatsRecorder : public StatsRecorder
+{
+public:
+    Integer128StatsRecorder();
+
+    explicit Integer128StatsRecorder(const pixels::proto::ColumnStatistic &statistic);
+
+    void updateInteger128(long high, long low, int repetitions) override;
+
+    /**
+     * 64-bit values are sign-extended, this is used when long decimals are written as
+     * 64-bit unscaled values.
+     */
+    void updateInteger(const long *values, const uint8_t *isNull, int length) override;
+
+    void updateInteger128(const long *values, const uint8_t *isNull, int length) override;
+
+    void merge(const StatsRecorder &other) override;
+
+    void reset() override;
+
+    pixels::proto::ColumnStatistic serialize() const override;
+
+    __int128 getMinimum() const;
+
+    __int128 getMaximum() const;
+
+    bool hasMinimum() const;
+
+    bool hasMaximum() const;
+
+    static __int128 toInt128(long high, long low);
+
+private:
+    __int128 minimum = 0;
+    __int128 maximum = 0;
+    bool hasMin = false;
+    bool hasMax = false;
+};
+
+#endif // PIXELS_INTEGER128STATSRECORDER_H
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_INTEGERSTATSRECORDER_H
+#define PIXELS_INTEGERSTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+#include <climits>
+
+/**
+ * The statistics of integer columns (byte, short, int, long and short decimal).
+ * Short decimals are recorded by their unscaled values.
+ */
+class IntegerStatsRecorder : public StatsRecorder
+{
+public:
+    IntegerStatsRecorder();
+
+    explicit IntegerStatsRecorder(const pixels::proto::ColumnStatistic &statistic);
+
+    void updateInteger(long value, int repetitions) override;
+
+    void updateInteger(const int *values, const uint8_t *isNull, int length) override;
+
+    void updateInteger(const long *values, const uint8_t *isNull, int length) override;
+
+    void merge(const StatsRecorder &other) override;
+
+    void reset() override;
+
+    pixels::proto::ColumnStatistic serialize() const override;
+
+    long getMinimum() const;
+
+    long getMaximum() const;
+
+    bool hasMinimum() const;
+
+    bool hasMaximum() const;
+
+    bool isSumDefined() const;
+
+    long getSum() const;
+
+private:
+    template<typename T>
+    void updateIntegers(const T *values, const uint8_t *isNull, int length);
+
+    void mergeSum(__int128 delta);
+
+    long minimum = LONG_MAX;
+    long maximum = LONG_MIN;
+    long sum = 0L;
+    bool hasMin = false;
+    bool hasMax = false;
+    bool overflow = false;
+};
+
+#endif // PIXELS_INTEGERSTATSRECORDER_H
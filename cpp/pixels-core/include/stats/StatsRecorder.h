@@ -70,11 +70,34 @@ public:
 
     virtual void updateVector();
 
+    /**
+     * Bulk updates used by the column writers. Each of them consumes a whole partition
+     * of a column vector at once. isNull can be nullptr if the partition has no null
+     * values. Null values are counted in numberOfValues but ignored by min/max/sum.
+     */
+    virtual void updateInteger(const int *values, const uint8_t *isNull, int length);
+
+    virtual void updateInteger(const long *values, const uint8_t *isNull, int length);
+
+    /**
+     * @param values the high and low 64 bits of each value, i.e., values[2*i] is the high
+     *               bits and values[2*i+1] is the low bits of the i-th value
+     */
+    virtual void updateInteger128(const long *values, const uint8_t *isNull, int length);
+
+    virtual void updateDouble(const double *values, const uint8_t *isNull, int length);
+
+    virtual void updateString(const std::string *values, const uint8_t *isNull, int length);
+
+    virtual void updateDate(const int *values, const uint8_t *isNull, int length);
+
+    virtual void updateTimestamp(const long *values, const uint8_t *isNull, int length);
+
     bool isStatsExists() const;
 
-    void merge(const StatsRecorder &stats);
+    virtual void merge(const StatsRecorder &stats);
 
-    void reset();
+    virtual void reset();
 
     long getNumberOfValues() const;
 
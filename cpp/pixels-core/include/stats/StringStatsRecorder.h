@@ -0,0 +1,69 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_STRINGSTATSRECORDER_H
+#define PIXELS_STRINGSTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of string columns (string, char and varchar).
+ * Strings are compared byte-wise, the same as the comparison of duckdb::string_t.
+ */
+class StringStatsRecorder : public StatsRecorder
+{
+public:
+    StringStatsRecorder();
+
+    explicit StringStatsRecorder(const pixels::proto::ColumnStatistic &statistic);
+
+    void updateString(const std::string &value, int repetitions) override;
+
+    void updateString(const std::string *values, const uint8_t *isNull, int length) override;
+
+    void merge(const StatsRecorder &other) override;
+
+    void reset() override;
+
+    pixels::proto::ColumnStatistic serialize() const override;
+
+    const std::string &getMinimum() const;
+
+    const std::string &getMaximum() const;
+
+    bool hasMinimum() const;
+
+    bool hasMaximum() const;
+
+    long getSum() const;
+
+private:
+    std::string minimum;
+    std::string maximum;
+    // the total length of the strings
+    long sum = 0L;
+    bool hasMinMax = false;
+};
+
+#endif // PIXELS_STRINGSTATSRECORDER_H
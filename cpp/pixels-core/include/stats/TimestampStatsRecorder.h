@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_TIMESTAMPSTATSRECORDER_H
+#define PIXELS_TIMESTAMPSTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+#include <climits>
+
+/**
+ * The statistics of timestamp columns, values are kept in the unit of TimestampColumnVector::times.
+ */
+class TimestampStatsRecorder : public StatsRecorder
+{
+public:
+    TimestampStatsRecorder();
+
+    explicit TimestampStatsRecorder(const pixels::proto::ColumnStatistic &statistic);
+
+    void updateTimestamp(long value) override;
+
+    void updateTimestamp(const long *values, const uint8_t *isNull, int length) override;
+
+    void merge(const StatsRecorder &other) override;
+
+    void reset() override;
+
+    pixels::proto::ColumnStatistic serialize() const override;
+
+    long getMinimum() const;
+
+    long getMaximum() const;
+
+    bool hasMinimum() const;
+
+    bool hasMaximum() const;
+
+private:
+    long minimum = LONG_MAX;
+    long maximum = LONG_MIN;
+    bool hasMin = false;
+    bool hasMax = false;
+};
+
+#endif // PIXELS_TIMESTAMPSTATSRECORDER_H
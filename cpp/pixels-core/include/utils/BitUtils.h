@@ -57,6 +57,15 @@ public:
 public:
     static std::vector <uint8_t> bitWiseCompact(std::vector <uint8_t> values, int length, ByteOrder byteOrder);
 
+    /**
+     * Expand the little endian compacted bits into one byte (0 or 1) per value.
+     * @param input the compacted bits
+     * @param bitOffset the position of the first value in input, in bits
+     * @param length the number of values to expand
+     * @param values the destination of the values
+     */
+    static void bitWiseDeCompactLE(const uint8_t *input, uint64_t bitOffset, int length, uint8_t *values);
+
 private:
     static std::vector <uint8_t> bitWiseCompactBE(std::vector <uint8_t> values, int length);
 
@@ -95,6 +95,16 @@ public:
     void unrolledUnPack64(long *buffer, int offset, int len,
                           const std::shared_ptr <ByteBuffer> &input);
 
+    /**
+     * Unpack len big-endian bit-packed values straight into values, zigzag
+     * decoding them in the same pass if zigzag is true. The byte aligned
+     * widths 8, 16 and 32 are unpacked with AVX2.
+     * @param bitSize the bit width, from 1 to 64
+     * @return the number of bytes consumed from input
+     */
+    template<typename T>
+    static int unpack(T *values, int len, int bitSize, const uint8_t *input, bool zigzag);
+
     // -----------------------------------------------------------
     // encoding utils
     int encodeBitWidth(int n);
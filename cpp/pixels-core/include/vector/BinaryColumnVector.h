@@ -29,6 +29,7 @@
 #include "vector/VectorizedRowBatch.h"
 #include "duckdb.h"
 #include "duckdb/common/types/vector.hpp"
+#include <unordered_map>
 
 /**
  * BinaryColumnVector derived from org.apache.hadoop.hive.ql.exec.vector.
@@ -54,6 +55,24 @@ class BinaryColumnVector : public ColumnVector
 
   std::vector<std::string> str_vec;
 
+  /**
+   * If the vector is dictionary encoded, dictionary holds the entries of the
+   * dictionary of the current column chunk and dictIds holds the index of each
+   * value in the dictionary, while vector is not filled. The last entry of the
+   * dictionary is invalid (null), which is referenced by the null values.
+   */
+  duckdb::string_t *dictionary;
+  uint64_t *dictionaryValid;
+  int dictionarySize;
+  uint32_t *dictIds;
+
+  /**
+   * The results of the comparisons evaluated on the dictionary entries, keyed by
+   * the filter constant. Each entry gets -1 if it qualifies and 0 otherwise, so the
+   * row filter can gather them by dictionary id. They live as long as the dictionary.
+   */
+  std::unordered_map<const void *, std::vector<int32_t>> dictionaryFilterResults;
+
   /**
   * Use this constructor by default. All column vectors
   * should normally be the default size.
@@ -70,6 +89,22 @@ class BinaryColumnVector : public ColumnVector
    * @param length     length of source byte sequence
    */
   void setRef(int elementNum, uint8_t *const &sourceBuf, int start, int length);
+  /**
+   * Switch the vector to hold dictionary ids, or back to hold the values if entries is nullptr.
+   * The entries are owned by the caller and must outlive the use of this vector.
+   *
+   * @param entries the dictionary entries, the last one is the null entry
+   * @param valid   the validity bitmap of the entries
+   * @param size    the number of entries including the null entry
+   * @param renewed whether the entries belong to a new dictionary, which drops the cached filter results
+   */
+  void setDictionary(duckdb::string_t *entries, uint64_t *valid, int size, bool renewed = false);
+  bool isDictionaryEncoded() const;
+  /**
+   * @return the value of an element, either dictionary encoded or not
+   */
+  duckdb::string_t getValue(int elementNum) const;
+  uint32_t *currentDictIds();
   void *current() override;
   void close() override;
   void print(int rowCount) override;
@@ -28,17 +28,54 @@
 #include "vector/ColumnVector.h"
 #include "vector/VectorizedRowBatch.h"
 
+/**
+ * The column vector of bytes and booleans, a boolean takes one byte of 0 or 1.
+ */
 class ByteColumnVector : public ColumnVector
 {
 public:
+    /**
+     * The values of this vector. It points to the owned buffer, or straight into the
+     * column chunk if the values are read without copying.
+     */
     uint8_t *vector;
 
+    /**
+     * The little endian compacted bits of the booleans in this vector, which point into
+     * the column chunk so that the filters can be evaluated on them, or nullptr if the
+     * values are not available as whole bytes of bits.
+     */
+    const uint8_t *bits;
+
     /**
     * Use this constructor by default. All column vectors
     * should normally be the default size.
     */
     ByteColumnVector(int len = VectorizedRowBatch::DEFAULT_SIZE, bool encoding = false);
 
+    ~ByteColumnVector();
+
+    /**
+     * Make vector point to the owned buffer again, so that the values can be written into it.
+     * @param preserved the number of leading values to copy into the buffer if vector points
+     *                  into the column chunk
+     * @return the owned buffer
+     */
+    uint8_t *ownedVector(int preserved = 0);
+
+    void *current() override;
+
     void close() override;
+
+    void add(bool value) override;
+
+    void add(int64_t value) override;
+
+    void add(int value) override;
+
+    void ensureSize(uint64_t size, bool preserveData) override;
+
+private:
+    uint8_t *buffer;
 };
 #endif //PIXELS_BYTECOLUMNVECTOR_H
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_DOUBLECOLUMNVECTOR_H
+#define PIXELS_DOUBLECOLUMNVECTOR_H
+
+#include "vector/ColumnVector.h"
+#include "vector/VectorizedRowBatch.h"
+
+class DoubleColumnVector : public ColumnVector
+{
+ public:
+  /**
+   * The values of this vector. It points to the owned buffer, or straight into the
+   * column chunk if the values are read without copying.
+   */
+  double *vector;
+
+  /**
+  * Use this constructor by default. All column vectors
+  * should normally be the default size.
+  */
+  explicit DoubleColumnVector(uint64_t len = VectorizedRowBatch::DEFAULT_SIZE, bool encoding = false);
+
+  ~DoubleColumnVector();
+
+  /**
+   * Make vector point to the owned buffer again, so that the values can be written into it.
+   * @param preserved the number of leading values to copy into the buffer if vector points
+   *                  into the column chunk
+   * @return the owned buffer
+   */
+  double *ownedVector(int preserved = 0);
+
+  void *current() override;
+
+  void print(int rowCount) override;
+
+  void close() override;
+
+  void add(std::string &value) override;
+
+  void add(int64_t value) override;
+
+  void add(int value) override;
+
+  void ensureSize(uint64_t size, bool preserveData) override;
+
+ private:
+  double *buffer;
+};
+#endif //PIXELS_DOUBLECOLUMNVECTOR_H
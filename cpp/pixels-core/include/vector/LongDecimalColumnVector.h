@@ -0,0 +1,61 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifndef PIXELS_LONGDECIMALCOLUMNVECTOR_H
+#define PIXELS_LONGDECIMALCOLUMNVECTOR_H
+
+#include "vector/ColumnVector.h"
+#include "vector/VectorizedRowBatch.h"
+#include "duckdb/common/types.hpp"
+
+/**
+ * The column vector of long decimals, whose precision is larger than 18. The unscaled
+ * values are kept in the layout of duckdb hugeint, so that the vector can be referenced
+ * by the HUGEINT backed DECIMAL vectors of duckdb.
+ */
+class LongDecimalColumnVector : public ColumnVector
+{
+ public:
+  duckdb::hugeint_t *vector;
+  int precision;
+  int scale;
+  /**
+  * Use this constructor by default. All column vectors
+  * should normally be the default size.
+  */
+  LongDecimalColumnVector(int precision, int scale, bool encoding = false);
+  LongDecimalColumnVector(uint64_t len, int precision, int scale, bool encoding = false);
+  ~LongDecimalColumnVector();
+  void print(int rowCount) override;
+  void close() override;
+  void *current() override;
+  int getPrecision();
+  int getScale();
+
+  void add(std::string &value) override;
+  void add(int64_t value) override;
+  void add(int value) override;
+  void ensureSize(uint64_t size, bool preserveData) override;
+};
+#endif //PIXELS_LONGDECIMALCOLUMNVECTOR_H
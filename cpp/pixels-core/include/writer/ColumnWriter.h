@@ -60,6 +60,13 @@ public:
 
     virtual pixels::proto::ColumnEncoding getColumnChunkEncoding() const;
 
+    /**
+     * Get the statistic of the column chunk that has been flushed by this writer.
+     */
+    virtual pixels::proto::ColumnStatistic getColumnChunkStat() const;
+
+    const StatsRecorder &getColumnChunkStatRecorder() const;
+
     virtual void reset();
 
     virtual void flush();
@@ -87,8 +94,8 @@ protected:
     std::shared_ptr <ByteBuffer> outputStream;
     int curPixelEleIndex = 0;
 //std::unique_ptr<Encoder> encoder;
-    StatsRecorder pixelStatRecorder;
-    StatsRecorder columnChunkStatRecorder;
+    std::unique_ptr <StatsRecorder> pixelStatRecorder;
+    std::unique_ptr <StatsRecorder> columnChunkStatRecorder;
     bool hasNull = false;
     const bool nullsPadding;
     int curPixelVectorIndex = 0;
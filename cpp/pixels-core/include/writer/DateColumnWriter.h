@@ -40,5 +40,7 @@ class DateColumnWriter : public ColumnWriter
   bool runlengthEncoding;
   std::unique_ptr<RunLenIntEncoder> encoder;
   std::vector<long> curPixelVector; // current pixel value vector haven't written out yet
+
+  void writeCurPartDate(std::shared_ptr<DateColumnVector> columnVector, int *values, int curPartLength, int curPartOffset);
 };
 #endif // DUCKDB_DATECOLUMNWRITER_H
@@ -42,6 +42,8 @@ private:
     bool runlengthEncoding;
     std::unique_ptr<RunLenIntEncoder> encoder;
     std::vector<long> curPixelVector; // current pixel value vector haven't written out yet
+
+    void writeCurPartDecimal(std::shared_ptr<DecimalColumnVector> columnVector, long *values, int curPartLength, int curPartOffset);
 };
 
 #endif //DUCKDB_DECIMALCOLUMNWRITER_H
@@ -55,6 +55,8 @@ public:
 
 
 private:
+    void writeCurPartString(std::shared_ptr<BinaryColumnVector> columnVector, int curPartLength, int curPartOffset);
+
     std::vector<long> curPixelVector;
     bool runlengthEncoding;
     bool dictionaryEncoding;
@@ -42,6 +42,8 @@ private:
     std::unique_ptr<RunLenIntEncoder> encoder;
     std::vector<long> curPixelVector; // current pixel value vector haven't written out yet
 
+    void writeCurPartTimestamp(std::shared_ptr<TimestampColumnVector> columnVector, long *values, int curPartLength, int curPartOffset);
+
 };
 
 #endif //DUCKDB_TIMESTAMPCOLUMNWRITER_H
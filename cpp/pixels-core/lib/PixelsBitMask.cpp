@@ -61,6 +61,18 @@ bool PixelsBitMask::isNone()
     return !(lastByte & lastMask);
 }
 
+long PixelsBitMask::count()
+{
+    long num = 0;
+    for (int i = 0; i < arrayLength - 1; i++)
+    {
+        num += __builtin_popcount(mask[i]);
+    }
+    uint8_t lastMask = (uint16_t)(1 << (maskLength - 8 * (arrayLength - 1))) - 1;
+    num += __builtin_popcount(mask[arrayLength - 1] & lastMask);
+    return num;
+}
+
 void PixelsBitMask::Or(PixelsBitMask &other)
 {
     // if their maskLength are the same, the arrayLength must be the same
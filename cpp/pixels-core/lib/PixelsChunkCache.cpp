@@ -0,0 +1,265 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "PixelsChunkCache.h"
+#include "utils/ConfigFactory.h"
+#include "profiler/CountProfiler.h"
+#include <cstring>
+
+std::shared_ptr <PixelsChunkCache> PixelsChunkCache::Instance()
+{
+    static std::shared_ptr <PixelsChunkCache> instance = []() -> std::shared_ptr <PixelsChunkCache>
+    {
+        uint64_t capacity = std::stoul(ConfigFactory::Instance().getProperty("pixel.chunk.cache.size"));
+        if (capacity == 0)
+        {
+            return nullptr;
+        }
+        return std::make_shared<PixelsChunkCache>(
+                capacity, std::stoi(ConfigFactory::Instance().getProperty("pixel.chunk.cache.shards")));
+    }();
+    return instance;
+}
+
+PixelsChunkCache::PixelsChunkCache(uint64_t capacity, int shardNum)
+{
+    shardNum = std::max(shardNum, 1);
+    for (int i = 0; i < shardNum; i++)
+    {
+        shards.emplace_back(std::make_unique<Shard>());
+    }
+    shardCapacity = capacity / shardNum;
+    inCapacity = shardCapacity / 4;
+    outCapacity = shardCapacity / 2;
+    hitCount = 0;
+    missCount = 0;
+    evictionCount = 0;
+}
+
+std::string PixelsChunkCache::chunkKey(const std::string &path, int rgId, int colId)
+{
+    return path + "#" + std::to_string(rgId) + "#" + std::to_string(colId);
+}
+
+PixelsChunkCache::Shard &PixelsChunkCache::getShard(const std::string &key)
+{
+    return *shards[std::hash<std::string>{}(key) % shards.size()];
+}
+
+std::shared_ptr <ByteBuffer> PixelsChunkCache::get(const std::string &path,
+                                                   const PixelsFooterCache::FileVersion &version,
+                                                   int rgId, int colId)
+{
+    std::string key = chunkKey(path, rgId, colId);
+    Shard &shard = getShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto it = shard.entries.find(key);
+    if (it == shard.entries.end())
+    {
+        missCount++;
+        ::CountProfiler::Instance().Count("chunk cache misses");
+        return nullptr;
+    }
+    if (!(it->second.version == version) || version.length < 0)
+    {
+        // the file has been rewritten since the chunk was cached
+        erase(shard, it);
+        missCount++;
+        ::CountProfiler::Instance().Count("chunk cache misses");
+        return nullptr;
+    }
+    if (it->second.queue == Queue::Main)
+    {
+        shard.main.splice(shard.main.begin(), shard.main, it->second.position);
+    }
+    hitCount++;
+    ::CountProfiler::Instance().Count("chunk cache hits");
+    // each reader gets a buffer of its own for its read position, which pins the chunk
+    std::shared_ptr <ByteBuffer> data = it->second.data;
+    return std::shared_ptr<ByteBuffer>(new ByteBuffer(*data, 0, data->size()), [data](ByteBuffer *buffer)
+    {
+        delete buffer;
+    });
+}
+
+void PixelsChunkCache::put(const std::string &path, const PixelsFooterCache::FileVersion &version,
+                           int rgId, int colId, const std::shared_ptr <ByteBuffer> &chunk)
+{
+    if (version.length < 0 || chunk == nullptr)
+    {
+        // the version of an inaccessible file can not be checked, so its chunks are not cached
+        return;
+    }
+    std::string key = chunkKey(path, rgId, colId);
+    uint64_t bytes = chunk->size() + key.size() + sizeof(Entry);
+    if (bytes > shardCapacity)
+    {
+        return;
+    }
+    Shard &shard = getShard(key);
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        if (shard.entries.find(key) != shard.entries.end())
+        {
+            return;
+        }
+    }
+    // the chunk is in a buffer that is reused by the next reads, copy it out of the lock
+    auto data = std::make_shared<ByteBuffer>(chunk->size());
+    memcpy(data->getPointer(), chunk->getPointer(), chunk->size());
+    std::lock_guard<std::mutex> guard(shard.lock);
+    if (shard.entries.find(key) != shard.entries.end())
+    {
+        return;
+    }
+    // a chunk read again after it left the in queue is used repeatedly, it enters the main queue
+    Queue queue = Queue::In;
+    auto remembered = shard.outIndex.find(key);
+    if (remembered != shard.outIndex.end())
+    {
+        shard.outBytes -= remembered->second->second;
+        shard.out.erase(remembered->second);
+        shard.outIndex.erase(remembered);
+        queue = Queue::Main;
+    }
+    auto &list = queue == Queue::Main ? shard.main : shard.in;
+    list.push_front(key);
+    shard.entries[key] = Entry{version, std::move(data), bytes, queue, list.begin()};
+    shard.usedBytes += bytes;
+    if (queue == Queue::In)
+    {
+        shard.inBytes += bytes;
+    }
+    evict(shard);
+}
+
+void PixelsChunkCache::erase(Shard &shard, std::unordered_map<std::string, Entry>::iterator it)
+{
+    shard.usedBytes -= it->second.bytes;
+    if (it->second.queue == Queue::In)
+    {
+        shard.inBytes -= it->second.bytes;
+        shard.in.erase(it->second.position);
+    }
+    else
+    {
+        shard.main.erase(it->second.position);
+    }
+    shard.entries.erase(it);
+}
+
+void PixelsChunkCache::evict(Shard &shard)
+{
+    while (shard.usedBytes > shardCapacity)
+    {
+        // the in queue gives way first when it exceeds its share
+        bool evicted = false;
+        if (shard.inBytes > inCapacity || shard.main.empty())
+        {
+            evicted = evictFrom(shard, shard.in);
+        }
+        if (!evicted)
+        {
+            evicted = evictFrom(shard, shard.main) || evictFrom(shard, shard.in);
+        }
+        if (!evicted)
+        {
+            // all the chunks are pinned, the shard stays over its budget until they are released
+            break;
+        }
+    }
+    while (shard.outBytes > outCapacity)
+    {
+        shard.outBytes -= shard.out.back().second;
+        shard.outIndex.erase(shard.out.back().first);
+        shard.out.pop_back();
+    }
+}
+
+bool PixelsChunkCache::evictFrom(Shard &shard, std::list <std::string> &queue)
+{
+    for (auto victim = queue.rbegin(); victim != queue.rend(); victim++)
+    {
+        auto it = shard.entries.find(*victim);
+        if (it->second.data.use_count() > 1)
+        {
+            // pinned by a reader
+            continue;
+        }
+        if (it->second.queue == Queue::In)
+        {
+            // remember the chunk, so that it enters the main queue if it is read again
+            shard.out.emplace_front(it->first, it->second.data->size());
+            shard.outIndex[it->first] = shard.out.begin();
+            shard.outBytes += it->second.data->size();
+        }
+        erase(shard, it);
+        evictionCount++;
+        ::CountProfiler::Instance().Count("chunk cache evictions");
+        return true;
+    }
+    return false;
+}
+
+void PixelsChunkCache::clear()
+{
+    for (auto &shard: shards)
+    {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        shard->entries.clear();
+        shard->in.clear();
+        shard->main.clear();
+        shard->out.clear();
+        shard->outIndex.clear();
+        shard->inBytes = 0;
+        shard->outBytes = 0;
+        shard->usedBytes = 0;
+    }
+}
+
+long PixelsChunkCache::getHitCount() const
+{
+    return hitCount;
+}
+
+long PixelsChunkCache::getMissCount() const
+{
+    return missCount;
+}
+
+long PixelsChunkCache::getEvictionCount() const
+{
+    return evictionCount;
+}
+
+uint64_t PixelsChunkCache::getUsedBytes()
+{
+    uint64_t usedBytes = 0;
+    for (auto &shard: shards)
+    {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        usedBytes += shard->usedBytes;
+    }
+    return usedBytes;
+}
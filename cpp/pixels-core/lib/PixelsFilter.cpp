@@ -23,6 +23,8 @@
  * @create 2023-06-23
  */
 #include "PixelsFilter.h"
+#include "stats/Integer128StatsRecorder.h"
+#include <cmath>
 
 template<class T, class OP>
 int PixelsFilter::CompareAvx2(void *data, T constant)
@@ -31,7 +33,41 @@ int PixelsFilter::CompareAvx2(void *data, T constant)
     __m256i vector_next;
     __m256i constants;
     __m256i mask;
-    if constexpr(sizeof(T) == 4)
+    if constexpr(std::is_floating_point<T>())
+    {
+        // the ordered comparisons are false on NaN, while duckdb orders NaN after all the other values
+        constexpr int predicate = std::is_same<OP, duckdb::Equals>() ? _CMP_EQ_OQ :
+                                  std::is_same<OP, duckdb::LessThan>() ? _CMP_LT_OQ :
+                                  std::is_same<OP, duckdb::LessThanEquals>() ? _CMP_LE_OQ :
+                                  std::is_same<OP, duckdb::GreaterThan>() ? _CMP_GT_OQ : _CMP_GE_OQ;
+        constexpr bool nanQualified = std::is_same<OP, duckdb::GreaterThan>() ||
+                                      std::is_same<OP, duckdb::GreaterThanEquals>();
+        if constexpr(sizeof(T) == 4)
+        {
+            __m256 values = _mm256_loadu_ps((float *) data);
+            __m256 result = _mm256_cmp_ps(values, _mm256_set1_ps(constant), predicate);
+            if constexpr(nanQualified)
+            {
+                result = _mm256_or_ps(result, _mm256_cmp_ps(values, values, _CMP_UNORD_Q));
+            }
+            return _mm256_movemask_ps(result);
+        } else
+        {
+            __m256d constants_pd = _mm256_set1_pd(constant);
+            int result = 0;
+            for (int half = 0; half < 2; half++)
+            {
+                __m256d values = _mm256_loadu_pd((double *) data + half * 4);
+                __m256d halfResult = _mm256_cmp_pd(values, constants_pd, predicate);
+                if constexpr(nanQualified)
+                {
+                    halfResult = _mm256_or_pd(halfResult, _mm256_cmp_pd(values, values, _CMP_UNORD_Q));
+                }
+                result |= _mm256_movemask_pd(halfResult) << (half * 4);
+            }
+            return result;
+        }
+    } else if constexpr(sizeof(T) == 4)
     {
         vector = _mm256_load_si256((__m256i *) data);
         constants = _mm256_set1_epi32(constant);
@@ -103,6 +139,71 @@ int PixelsFilter::CompareAvx2(void *data, T constant)
     }
 }
 
+template<class OP>
+int PixelsFilter::CompareInt128Avx2(const duckdb::hugeint_t *data, __int128 constant)
+{
+    // each value takes two lanes, the low word and then the high word, and the low words
+    // are compared as unsigned by flipping their sign bits
+    const __m256i flipLow = _mm256_setr_epi64x(INT64_MIN, 0, INT64_MIN, 0);
+    const __m256i constants = _mm256_xor_si256(
+            _mm256_setr_epi64x((int64_t) constant, (int64_t) (constant >> 64),
+                               (int64_t) constant, (int64_t) (constant >> 64)), flipLow);
+    int result = 0;
+    for (int k = 0; k < 4; k++)
+    {
+        __m256i values = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (data + 2 * k)), flipLow);
+        __m256i equal = _mm256_cmpeq_epi64(values, constants);
+        __m256i selected;
+        // shifting by 8 bytes moves the result of the low word to the lane of the high word
+        if constexpr(std::is_same<OP, duckdb::Equals>())
+        {
+            selected = _mm256_and_si256(equal, _mm256_slli_si256(equal, 8));
+        } else if constexpr(std::is_same<OP, duckdb::LessThan>() ||
+                            std::is_same<OP, duckdb::GreaterThanEquals>())
+        {
+            __m256i less = _mm256_cmpgt_epi64(constants, values);
+            selected = _mm256_or_si256(less, _mm256_and_si256(equal, _mm256_slli_si256(less, 8)));
+        } else
+        {
+            __m256i greater = _mm256_cmpgt_epi64(values, constants);
+            selected = _mm256_or_si256(greater, _mm256_and_si256(equal, _mm256_slli_si256(greater, 8)));
+        }
+        int lanes = _mm256_movemask_pd(_mm256_castsi256_pd(selected));
+        result |= (((lanes >> 1) & 1) | ((lanes >> 2) & 2)) << (2 * k);
+    }
+    if constexpr(std::is_same<OP, duckdb::LessThanEquals>() ||
+                 std::is_same<OP, duckdb::GreaterThanEquals>())
+    {
+        return ~result & 0xFF;
+    }
+    return result;
+}
+
+static bool GetInteger128Constant(const duckdb::Value &constant, __int128 &result);
+
+template<class OP>
+void PixelsFilter::LongDecimalFilterOperation(std::shared_ptr <ColumnVector> vector,
+                                              const duckdb::Value &constant, PixelsBitMask &filter_mask)
+{
+    __int128 constant_value;
+    if (!GetInteger128Constant(constant, constant_value))
+    {
+        throw InvalidArgumentException("Unsupported constant for long decimal filter. ");
+    }
+    auto longDecimalColumnVector = std::static_pointer_cast<LongDecimalColumnVector>(vector);
+    const duckdb::hugeint_t *values = longDecimalColumnVector->vector;
+    int i = 0;
+#ifdef ENABLE_SIMD_FILTER
+    for (; i < vector->length - vector->length % 8; i += 8) {
+        filter_mask.setByteAligned(i, CompareInt128Avx2<OP>(values + i, constant_value));
+    }
+#endif
+    for (; i < vector->length; i++)
+    {
+        filter_mask.set(i, OP::Operation(Integer128StatsRecorder::toInt128(values[i].upper, values[i].lower),
+                                         constant_value));
+    }
+}
 
 template<class T, class OP>
 void PixelsFilter::TemplatedFilterOperation(std::shared_ptr <ColumnVector> vector,
@@ -112,6 +213,37 @@ void PixelsFilter::TemplatedFilterOperation(std::shared_ptr <ColumnVector> vecto
     T constant_value = constant.template GetValueUnsafe<T>();
     switch (type->getCategory())
     {
+        case TypeDescription::BOOLEAN:
+        {
+            auto byteColumnVector = std::static_pointer_cast<ByteColumnVector>(vector);
+            int i = 0;
+            if (byteColumnVector->bits != nullptr)
+            {
+                // a boolean predicate maps each bit to a fixed result, so the bits give the mask of 8 rows
+                uint8_t whenSet = OP::Operation((T) (uint8_t) 1, constant_value) ? 0xFF : 0;
+                uint8_t whenUnset = OP::Operation((T) (uint8_t) 0, constant_value) ? 0xFF : 0;
+                for (; i < vector->length - vector->length % 8; i += 8)
+                {
+                    uint8_t bits = byteColumnVector->bits[i / 8];
+                    filter_mask.setByteAligned(i, (bits & whenSet) | (~bits & whenUnset));
+                }
+            }
+            for (; i < vector->length; i++)
+            {
+                filter_mask.set(i, OP::Operation((T) byteColumnVector->vector[i], constant_value));
+            }
+            break;
+        }
+        case TypeDescription::BYTE:
+        {
+            auto byteColumnVector = std::static_pointer_cast<ByteColumnVector>(vector);
+            for (int i = 0; i < vector->length; i++)
+            {
+                filter_mask.set(i, OP::Operation((T) (int8_t) byteColumnVector->vector[i],
+                                                 constant_value));
+            }
+            break;
+        }
         case TypeDescription::SHORT:
         case TypeDescription::INT:
         {
@@ -181,6 +313,51 @@ void PixelsFilter::TemplatedFilterOperation(std::shared_ptr <ColumnVector> vecto
             }
             break;
         }
+        case TypeDescription::FLOAT:
+        {
+            auto floatColumnVector = std::static_pointer_cast<FloatColumnVector>(vector);
+            int i = 0;
+#ifdef ENABLE_SIMD_FILTER
+            bool nanConstant = false;
+            if constexpr(std::is_floating_point<T>())
+            {
+                nanConstant = std::isnan(constant_value);
+            }
+            // a NaN constant is left to the scalar comparison, which orders NaN as duckdb does
+            for (; !nanConstant && i < vector->length - vector->length % 8; i += 8) {
+                uint8_t mask = CompareAvx2<T, OP>(floatColumnVector->vector + i, constant_value);
+                filter_mask.setByteAligned(i, mask);
+            }
+#endif
+            for (; i < vector->length; i++)
+            {
+                filter_mask.set(i, OP::Operation((T) floatColumnVector->vector[i],
+                                                 constant_value));
+            }
+            break;
+        }
+        case TypeDescription::DOUBLE:
+        {
+            auto doubleColumnVector = std::static_pointer_cast<DoubleColumnVector>(vector);
+            int i = 0;
+#ifdef ENABLE_SIMD_FILTER
+            bool nanConstant = false;
+            if constexpr(std::is_floating_point<T>())
+            {
+                nanConstant = std::isnan(constant_value);
+            }
+            for (; !nanConstant && i < vector->length - vector->length % 8; i += 8) {
+                uint8_t mask = CompareAvx2<T, OP>(doubleColumnVector->vector + i, constant_value);
+                filter_mask.setByteAligned(i, mask);
+            }
+#endif
+            for (; i < vector->length; i++)
+            {
+                filter_mask.set(i, OP::Operation((T) doubleColumnVector->vector[i],
+                                                 constant_value));
+            }
+            break;
+        }
         case TypeDescription::STRING:
         case TypeDescription::BINARY:
         case TypeDescription::VARBINARY:
@@ -188,10 +365,51 @@ void PixelsFilter::TemplatedFilterOperation(std::shared_ptr <ColumnVector> vecto
         case TypeDescription::VARCHAR:
         {
             auto binaryColumnVector = std::static_pointer_cast<BinaryColumnVector>(vector);
+            if (binaryColumnVector->isDictionaryEncoded())
+            {
+                // compare each dictionary entry once per chunk, then the rows only look up their ids
+                auto &entryResults = binaryColumnVector->dictionaryFilterResults[&constant];
+                if (entryResults.empty())
+                {
+                    entryResults.resize(binaryColumnVector->dictionarySize);
+                    for (int d = 0; d < binaryColumnVector->dictionarySize; d++)
+                    {
+                        bool valid = (binaryColumnVector->dictionaryValid[d / 64] >> (d % 64)) & 1;
+                        entryResults[d] = valid && OP::Operation(binaryColumnVector->dictionary[d],
+                                                                 (duckdb::string_t) constant_value) ? -1 : 0;
+                    }
+                }
+                const int32_t *results = entryResults.data();
+                const uint32_t *ids = binaryColumnVector->dictIds;
+                int i = 0;
+#ifdef ENABLE_SIMD_FILTER
+                for (; i < vector->length - vector->length % 8; i += 8) {
+                    __m256i codes = _mm256_loadu_si256((const __m256i *) (ids + i));
+                    __m256i qualified = _mm256_i32gather_epi32(results, codes, 4);
+                    filter_mask.setByteAligned(i, _mm256_movemask_ps(_mm256_castsi256_ps(qualified)));
+                }
+#endif
+                for (; i < vector->length; i++)
+                {
+                    filter_mask.set(i, results[ids[i]] != 0);
+                }
+                break;
+            }
+            // the reader leaves the strings of the null and filtered out rows unset, so only the
+            // rows still set in the incoming mask are compared, which also saves the comparisons
             for (int i = 0; i < vector->length; i++)
             {
-                filter_mask.set(i, OP::Operation((duckdb::string_t) binaryColumnVector->vector[i],
-                                                 (duckdb::string_t) constant_value));
+                if (i % 8 == 0 && filter_mask.mask[i / 8] == 0)
+                {
+                    i += 7;
+                    continue;
+                }
+                if (filter_mask.get(i))
+                {
+                    filter_mask.set(i, vector->checkValid(i) &&
+                                       OP::Operation(binaryColumnVector->getValue(i),
+                                                     (duckdb::string_t) constant_value));
+                }
             }
             break;
         }
@@ -209,6 +427,12 @@ void PixelsFilter::FilterOperationSwitch(std::shared_ptr <ColumnVector> vector,
     }
     switch (type->getCategory())
     {
+        case TypeDescription::BOOLEAN:
+            TemplatedFilterOperation<bool, OP>(vector, constant, filter_mask, type);
+            break;
+        case TypeDescription::BYTE:
+            TemplatedFilterOperation<int8_t, OP>(vector, constant, filter_mask, type);
+            break;
         case TypeDescription::SHORT:
         case TypeDescription::INT:
         case TypeDescription::DATE:
@@ -218,7 +442,20 @@ void PixelsFilter::FilterOperationSwitch(std::shared_ptr <ColumnVector> vector,
             TemplatedFilterOperation<int64_t, OP>(vector, constant, filter_mask, type);
             break;
         case TypeDescription::DECIMAL:
-            TemplatedFilterOperation<int64_t, OP>(vector, constant, filter_mask, type);
+            if (type->getPrecision() > TypeDescription::SHORT_DECIMAL_MAX_PRECISION)
+            {
+                LongDecimalFilterOperation<OP>(vector, constant, filter_mask);
+            }
+            else
+            {
+                TemplatedFilterOperation<int64_t, OP>(vector, constant, filter_mask, type);
+            }
+            break;
+        case TypeDescription::FLOAT:
+            TemplatedFilterOperation<float, OP>(vector, constant, filter_mask, type);
+            break;
+        case TypeDescription::DOUBLE:
+            TemplatedFilterOperation<double, OP>(vector, constant, filter_mask, type);
             break;
         case TypeDescription::STRING:
         case TypeDescription::BINARY:
@@ -243,7 +480,7 @@ void PixelsFilter::ApplyFilter(std::shared_ptr <ColumnVector> vector, duckdb::Ta
             auto &conjunction = (duckdb::ConjunctionAndFilter &) filter;
             for (auto &child_filter: conjunction.child_filters)
             {
-                PixelsBitMask childMask(filterMask.maskLength);
+                PixelsBitMask childMask(filterMask);
                 ApplyFilter(vector, *child_filter, childMask, type);
                 filterMask.And(childMask);
             }
@@ -310,3 +547,197 @@ void PixelsFilter::ApplyFilter(std::shared_ptr <ColumnVector> vector, duckdb::Ta
 
 
 
+
+template<class T>
+bool PixelsFilter::CheckRange(duckdb::ExpressionType comparison, const T &constant,
+                              const T &minimum, const T &maximum)
+{
+    switch (comparison)
+    {
+        case duckdb::ExpressionType::COMPARE_EQUAL:
+            return !(constant < minimum) && !(maximum < constant);
+        case duckdb::ExpressionType::COMPARE_NOTEQUAL:
+            return !(minimum == maximum && minimum == constant);
+        case duckdb::ExpressionType::COMPARE_LESSTHAN:
+            return minimum < constant;
+        case duckdb::ExpressionType::COMPARE_LESSTHANOREQUALTO:
+            return !(constant < minimum);
+        case duckdb::ExpressionType::COMPARE_GREATERTHAN:
+            return constant < maximum;
+        case duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+            return !(maximum < constant);
+        default:
+            return true;
+    }
+}
+
+static bool GetIntegerConstant(const duckdb::Value &constant, int64_t &result)
+{
+    switch (constant.type().InternalType())
+    {
+        case duckdb::PhysicalType::INT8:
+            result = constant.GetValueUnsafe<int8_t>();
+            return true;
+        case duckdb::PhysicalType::INT16:
+            result = constant.GetValueUnsafe<int16_t>();
+            return true;
+        case duckdb::PhysicalType::INT32:
+            result = constant.GetValueUnsafe<int32_t>();
+            return true;
+        case duckdb::PhysicalType::INT64:
+            result = constant.GetValueUnsafe<int64_t>();
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool GetInteger128Constant(const duckdb::Value &constant, __int128 &result)
+{
+    if (constant.type().InternalType() == duckdb::PhysicalType::INT128)
+    {
+        auto value = constant.GetValueUnsafe<duckdb::hugeint_t>();
+        result = Integer128StatsRecorder::toInt128(value.upper, (long) value.lower);
+        return true;
+    }
+    int64_t value;
+    if (!GetIntegerConstant(constant, value))
+    {
+        return false;
+    }
+    result = value;
+    return true;
+}
+
+bool PixelsFilter::CheckStatistic(duckdb::TableFilter &filter, const pixels::proto::ColumnStatistic &stat,
+                                  std::shared_ptr <TypeDescription> type)
+{
+    switch (filter.filter_type)
+    {
+        case duckdb::TableFilterType::CONJUNCTION_AND:
+        {
+            auto &conjunction = (duckdb::ConjunctionAndFilter &) filter;
+            for (auto &childFilter: conjunction.child_filters)
+            {
+                if (!CheckStatistic(*childFilter, stat, type))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case duckdb::TableFilterType::CONJUNCTION_OR:
+        {
+            auto &conjunction = (duckdb::ConjunctionOrFilter &) filter;
+            for (auto &childFilter: conjunction.child_filters)
+            {
+                if (CheckStatistic(*childFilter, stat, type))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        case duckdb::TableFilterType::CONSTANT_COMPARISON:
+        {
+            auto &constantFilter = (duckdb::ConstantFilter &) filter;
+            auto &constant = constantFilter.constant;
+            auto comparison = constantFilter.comparison_type;
+            // if the typed statistic exists but has no minimum or maximum, every value is null
+            switch (type->getCategory())
+            {
+                case TypeDescription::BYTE:
+                case TypeDescription::SHORT:
+                case TypeDescription::INT:
+                case TypeDescription::LONG:
+                case TypeDescription::DECIMAL:
+                {
+                    if (type->getCategory() == TypeDescription::DECIMAL &&
+                        type->getPrecision() > TypeDescription::SHORT_DECIMAL_MAX_PRECISION)
+                    {
+                        __int128 value;
+                        if (!stat.has_int128statistics() || !GetInteger128Constant(constant, value))
+                        {
+                            return true;
+                        }
+                        Integer128StatsRecorder int128Stat(stat);
+                        if (!int128Stat.hasMinimum() || !int128Stat.hasMaximum())
+                        {
+                            return false;
+                        }
+                        return CheckRange<__int128>(comparison, value, int128Stat.getMinimum(),
+                                                    int128Stat.getMaximum());
+                    }
+                    int64_t value;
+                    if (!stat.has_intstatistics() || !GetIntegerConstant(constant, value))
+                    {
+                        return true;
+                    }
+                    auto &intStat = stat.intstatistics();
+                    if (!intStat.has_minimum() || !intStat.has_maximum())
+                    {
+                        return false;
+                    }
+                    int64_t minimum = intStat.minimum();
+                    int64_t maximum = intStat.maximum();
+                    return CheckRange<int64_t>(comparison, value, minimum, maximum);
+                }
+                case TypeDescription::DATE:
+                {
+                    if (!stat.has_datestatistics() || constant.type().InternalType() != duckdb::PhysicalType::INT32)
+                    {
+                        return true;
+                    }
+                    auto &dateStat = stat.datestatistics();
+                    if (!dateStat.has_minimum() || !dateStat.has_maximum())
+                    {
+                        return false;
+                    }
+                    int32_t minimum = dateStat.minimum();
+                    int32_t maximum = dateStat.maximum();
+                    return CheckRange<int32_t>(comparison, constant.GetValueUnsafe<int32_t>(), minimum, maximum);
+                }
+                case TypeDescription::TIMESTAMP:
+                {
+                    if (!stat.has_timestampstatistics() || constant.type().InternalType() != duckdb::PhysicalType::INT64)
+                    {
+                        return true;
+                    }
+                    auto &timestampStat = stat.timestampstatistics();
+                    if (!timestampStat.has_minimum() || !timestampStat.has_maximum())
+                    {
+                        return false;
+                    }
+                    int64_t minimum = timestampStat.minimum();
+                    int64_t maximum = timestampStat.maximum();
+                    return CheckRange<int64_t>(comparison, constant.GetValueUnsafe<int64_t>(), minimum, maximum);
+                }
+                case TypeDescription::STRING:
+                case TypeDescription::CHAR:
+                case TypeDescription::VARCHAR:
+                {
+                    if (!stat.has_stringstatistics() || constant.type().InternalType() != duckdb::PhysicalType::VARCHAR)
+                    {
+                        return true;
+                    }
+                    auto &stringStat = stat.stringstatistics();
+                    if (!stringStat.has_minimum() || !stringStat.has_maximum())
+                    {
+                        return false;
+                    }
+                    // std::string compares bytes as unsigned chars, the same as duckdb::string_t
+                    return CheckRange<std::string>(comparison, duckdb::StringValue::Get(constant),
+                                                   stringStat.minimum(), stringStat.maximum());
+                }
+                default:
+                    return true;
+            }
+        }
+        case duckdb::TableFilterType::IS_NULL:
+            return !stat.has_hasnull() || stat.hasnull();
+        case duckdb::TableFilterType::IS_NOT_NULL:
+        case duckdb::TableFilterType::OPTIONAL_FILTER:
+        default:
+            return true;
+    }
+}
@@ -23,54 +23,180 @@
  * @create 2023-03-14
  */
 #include "PixelsFooterCache.h"
-#include "exception/InvalidArgumentException.h"
+#include "utils/ConfigFactory.h"
+#include "profiler/CountProfiler.h"
+#include <algorithm>
+#include <sys/stat.h>
 
-PixelsFooterCache::PixelsFooterCache()
+std::shared_ptr <PixelsFooterCache> PixelsFooterCache::Instance()
 {
+    static std::shared_ptr <PixelsFooterCache> instance = std::make_shared<PixelsFooterCache>(
+            std::stoul(ConfigFactory::Instance().getProperty("pixel.footer.cache.size")),
+            std::stoi(ConfigFactory::Instance().getProperty("pixel.footer.cache.shards")));
+    return instance;
 }
 
-void PixelsFooterCache::putFileTail(const std::string &id, std::shared_ptr <FileTail> fileTail)
+PixelsFooterCache::PixelsFooterCache(uint64_t capacity, int shardNum)
 {
-    fileTailCacheMap[id] = fileTail;
+    shardNum = std::max(shardNum, 1);
+    for (int i = 0; i < shardNum; i++)
+    {
+        shards.emplace_back(std::make_unique<Shard>());
+    }
+    shardCapacity = capacity / shardNum;
+    hitCount = 0;
+    missCount = 0;
+    evictionCount = 0;
 }
 
-std::shared_ptr <FileTail> PixelsFooterCache::getFileTail(const std::string &id)
+PixelsFooterCache::FileVersion PixelsFooterCache::getFileVersion(const std::string &path)
 {
-    if (fileTailCacheMap.find(id) != fileTailCacheMap.end())
-    {
-        return fileTailCacheMap[id];
-    }
-    else
+    std::string localPath = path.rfind("file://", 0) == 0 ? path.substr(7) : path;
+    FileVersion version;
+    struct stat st{};
+    if (stat(localPath.c_str(), &st) == 0)
     {
-        throw InvalidArgumentException("No such a FileTail id.");
+        version.length = st.st_size;
+        version.modifyTime = st.st_mtim.tv_sec * 1000000000L + st.st_mtim.tv_nsec;
     }
+    return version;
+}
+
+std::shared_ptr <FileTail> PixelsFooterCache::getFileTail(const std::string &path, const FileVersion &version)
+{
+    return std::static_pointer_cast<FileTail>(get(path, version));
+}
+
+void PixelsFooterCache::putFileTail(const std::string &path, const FileVersion &version,
+                                    std::shared_ptr <FileTail> fileTail)
+{
+    put(path, version, fileTail);
+}
+
+std::shared_ptr <RowGroupFooter> PixelsFooterCache::getRGFooter(const std::string &path,
+                                                                const FileVersion &version, int rgId)
+{
+    return std::static_pointer_cast<RowGroupFooter>(get(rgFooterKey(path, rgId), version));
+}
+
+void PixelsFooterCache::putRGFooter(const std::string &path, const FileVersion &version, int rgId,
+                                    std::shared_ptr <RowGroupFooter> footer)
+{
+    put(rgFooterKey(path, rgId), version, footer);
 }
 
-void PixelsFooterCache::putRGFooter(const std::string &id, std::shared_ptr <RowGroupFooter> footer)
+std::string PixelsFooterCache::rgFooterKey(const std::string &path, int rgId)
 {
-    rowGroupFooterCacheMap[id] = footer;
+    return path + "#" + std::to_string(rgId);
 }
 
-bool PixelsFooterCache::containsFileTail(const std::string &id)
+PixelsFooterCache::Shard &PixelsFooterCache::getShard(const std::string &key)
 {
-    return fileTailCacheMap.find(id) != fileTailCacheMap.end();
+    return *shards[std::hash<std::string>{}(key) % shards.size()];
+}
+
+std::shared_ptr <google::protobuf::Message> PixelsFooterCache::get(const std::string &key,
+                                                                   const FileVersion &version)
+{
+    Shard &shard = getShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto it = shard.entries.find(key);
+    if (it == shard.entries.end())
+    {
+        missCount++;
+        ::CountProfiler::Instance().Count("footer cache misses");
+        return nullptr;
+    }
+    if (!(it->second.version == version) || version.length < 0)
+    {
+        // the file has been rewritten since the footer was cached
+        shard.usedBytes -= it->second.bytes;
+        shard.lru.erase(it->second.lruPosition);
+        shard.entries.erase(it);
+        missCount++;
+        ::CountProfiler::Instance().Count("footer cache misses");
+        return nullptr;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruPosition);
+    hitCount++;
+    ::CountProfiler::Instance().Count("footer cache hits");
+    return it->second.value;
 }
 
-std::shared_ptr <RowGroupFooter> PixelsFooterCache::getRGFooter(const std::string &id)
+void PixelsFooterCache::put(const std::string &key, const FileVersion &version,
+                            std::shared_ptr <google::protobuf::Message> value)
 {
-    if (rowGroupFooterCacheMap.find(id) != rowGroupFooterCacheMap.end())
+    if (version.length < 0)
+    {
+        // the version of an inaccessible file can not be checked, so its footers are not cached
+        return;
+    }
+    uint64_t bytes = value->SpaceUsedLong() + key.size() + sizeof(Entry);
+    if (bytes > shardCapacity)
     {
-        return rowGroupFooterCacheMap[id];
+        return;
     }
-    else
+    Shard &shard = getShard(key);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end())
     {
-        throw InvalidArgumentException("No such a RGFooter id.");
+        shard.usedBytes -= it->second.bytes;
+        shard.lru.erase(it->second.lruPosition);
+        shard.entries.erase(it);
     }
+    while (shard.usedBytes + bytes > shardCapacity && !shard.lru.empty())
+    {
+        auto victim = shard.entries.find(shard.lru.back());
+        shard.usedBytes -= victim->second.bytes;
+        shard.entries.erase(victim);
+        shard.lru.pop_back();
+        evictionCount++;
+        ::CountProfiler::Instance().Count("footer cache evictions");
+    }
+    shard.lru.push_front(key);
+    shard.entries[key] = Entry{version, std::move(value), bytes, shard.lru.begin()};
+    shard.usedBytes += bytes;
+}
+
+void PixelsFooterCache::clear()
+{
+    for (auto &shard: shards)
+    {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        shard->entries.clear();
+        shard->lru.clear();
+        shard->usedBytes = 0;
+    }
+}
+
+long PixelsFooterCache::getHitCount() const
+{
+    return hitCount;
 }
 
-bool PixelsFooterCache::containsRGFooter(const std::string &id)
+long PixelsFooterCache::getMissCount() const
 {
-    return rowGroupFooterCacheMap.find(id) != rowGroupFooterCacheMap.end();
+    return missCount;
 }
 
+long PixelsFooterCache::getEvictionCount() const
+{
+    return evictionCount;
+}
 
+uint64_t PixelsFooterCache::getUsedBytes()
+{
+    uint64_t usedBytes = 0;
+    for (auto &shard: shards)
+    {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        usedBytes += shard->usedBytes;
+    }
+    return usedBytes;
+}
+
+uint64_t PixelsFooterCache::getCapacity() const
+{
+    return shardCapacity * shards.size();
+}
@@ -0,0 +1,342 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "PixelsFooterIndex.h"
+#include "utils/ConfigFactory.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+const std::string PixelsFooterIndex::INDEX_FILE_NAME = ".pixels-footer-index";
+
+std::mutex PixelsFooterIndex::indexesLock;
+std::unordered_map <std::string, std::shared_ptr<PixelsFooterIndex>> PixelsFooterIndex::indexes;
+
+static std::string localPath(const std::string &path)
+{
+    return path.rfind("file://", 0) == 0 ? path.substr(7) : path;
+}
+
+PixelsFooterIndex::PixelsFooterIndex(const uint8_t *data, uint64_t size, PixelsFooterCache::FileVersion version)
+{
+    this->data = data;
+    this->size = size;
+    this->version = version;
+}
+
+PixelsFooterIndex::~PixelsFooterIndex()
+{
+    munmap((void *) data, size);
+}
+
+bool PixelsFooterIndex::isEnabled()
+{
+    static bool enabled = ConfigFactory::Instance().getProperty("pixel.footer.index.enabled") == "true";
+    return enabled;
+}
+
+std::shared_ptr <PixelsFooterIndex> PixelsFooterIndex::open(const std::string &directory)
+{
+    std::string indexPath = (fs::path(localPath(directory)) / INDEX_FILE_NAME).string();
+    auto indexVersion = PixelsFooterCache::getFileVersion(indexPath);
+    std::lock_guard<std::mutex> guard(indexesLock);
+    auto it = indexes.find(indexPath);
+    if (it != indexes.end() && it->second != nullptr && it->second->version == indexVersion)
+    {
+        return it->second;
+    }
+    // the index is missing, or it has been rebuilt since it was mapped
+    auto index = indexVersion.length < 0 ? nullptr : map(indexPath, indexVersion);
+    indexes[indexPath] = index;
+    return index;
+}
+
+std::shared_ptr <PixelsFooterIndex> PixelsFooterIndex::openForFile(const std::string &filePath)
+{
+    return open(fs::path(localPath(filePath)).parent_path().string());
+}
+
+std::shared_ptr <PixelsFooterIndex> PixelsFooterIndex::map(const std::string &indexPath,
+                                                           const PixelsFooterCache::FileVersion &version)
+{
+    if (version.length < (long) sizeof(Header))
+    {
+        return nullptr;
+    }
+    int fd = ::open(indexPath.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    void *mapped = mmap(nullptr, version.length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    std::shared_ptr <PixelsFooterIndex> index(
+            new PixelsFooterIndex((const uint8_t *) mapped, version.length, version));
+    return index->validate() ? index : nullptr;
+}
+
+bool PixelsFooterIndex::validate() const
+{
+    auto header = (const Header *) data;
+    if (std::memcmp(header->magic, "PXFI", 4) != 0 || header->version != FORMAT_VERSION ||
+        sizeof(Header) + (uint64_t) header->fileNum * sizeof(FileEntry) > size)
+    {
+        return false;
+    }
+    auto entries = (const FileEntry *) (data + sizeof(Header));
+    for (uint32_t i = 0; i < header->fileNum; i++)
+    {
+        const FileEntry &entry = entries[i];
+        if (entry.nameOffset + entry.nameLength > size || entry.tailOffset + entry.tailLength > size ||
+            entry.rgOffset + (uint64_t) entry.rgNum * sizeof(Section) > size)
+        {
+            return false;
+        }
+        auto sections = (const Section *) (data + entry.rgOffset);
+        for (uint32_t rg = 0; rg < entry.rgNum; rg++)
+        {
+            if (sections[rg].offset + sections[rg].length > size)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const PixelsFooterIndex::FileEntry *PixelsFooterIndex::find(const std::string &fileName,
+                                                            const PixelsFooterCache::FileVersion &version) const
+{
+    auto header = (const Header *) data;
+    auto entries = (const FileEntry *) (data + sizeof(Header));
+    // the entries are sorted by the file name
+    auto entry = std::lower_bound(entries, entries + header->fileNum, fileName,
+                                  [this](const FileEntry &e, const std::string &name)
+                                  {
+                                      return name.compare(0, name.size(), (const char *) data + e.nameOffset,
+                                                          e.nameLength) > 0;
+                                  });
+    if (entry == entries + header->fileNum ||
+        fileName.compare(0, fileName.size(), (const char *) data + entry->nameOffset, entry->nameLength) != 0 ||
+        entry->length != version.length || entry->modifyTime != version.modifyTime)
+    {
+        return nullptr;
+    }
+    return entry;
+}
+
+std::shared_ptr <FileTail> PixelsFooterIndex::getFileTail(const std::string &filePath,
+                                                          const PixelsFooterCache::FileVersion &version)
+{
+    const FileEntry *entry = find(fs::path(localPath(filePath)).filename().string(), version);
+    if (entry == nullptr)
+    {
+        return nullptr;
+    }
+    auto fileTail = std::make_shared<FileTail>();
+    if (!fileTail->ParseFromArray(data + entry->tailOffset, (int) entry->tailLength))
+    {
+        return nullptr;
+    }
+    return fileTail;
+}
+
+std::shared_ptr <RowGroupFooter> PixelsFooterIndex::getRGFooter(const std::string &filePath,
+                                                                const PixelsFooterCache::FileVersion &version,
+                                                                int rgId)
+{
+    const FileEntry *entry = find(fs::path(localPath(filePath)).filename().string(), version);
+    if (entry == nullptr || rgId < 0 || (uint32_t) rgId >= entry->rgNum)
+    {
+        return nullptr;
+    }
+    const Section &section = ((const Section *) (data + entry->rgOffset))[rgId];
+    auto footer = std::make_shared<RowGroupFooter>();
+    if (!footer->ParseFromArray(data + section.offset, (int) section.length))
+    {
+        return nullptr;
+    }
+    return footer;
+}
+
+/**
+ * Read length bytes at the offset of the file into the buffer.
+ */
+static bool readAt(int fd, uint64_t offset, uint64_t length, std::string &buffer)
+{
+    buffer.resize(length);
+    uint64_t done = 0;
+    while (done < length)
+    {
+        ssize_t n = pread(fd, buffer.data() + done, length - done, (off_t) (offset + done));
+        if (n <= 0)
+        {
+            return false;
+        }
+        done += n;
+    }
+    return true;
+}
+
+bool PixelsFooterIndex::build(const std::string &directory)
+{
+    struct IndexedFile
+    {
+        std::string name;
+        PixelsFooterCache::FileVersion version;
+        std::string tail;
+        std::vector <std::string> rgFooters;
+    };
+    std::string dir = localPath(directory);
+    std::string indexPath = (fs::path(dir) / INDEX_FILE_NAME).string();
+    // the footers of the files not changed since the previous index was built are copied from it
+    auto previous = map(indexPath, PixelsFooterCache::getFileVersion(indexPath));
+    std::vector <IndexedFile> files;
+    std::error_code error;
+    for (const auto &dirEntry: fs::directory_iterator(dir, error))
+    {
+        if (!dirEntry.is_regular_file() || dirEntry.path().extension() != ".pxl")
+        {
+            continue;
+        }
+        IndexedFile file;
+        file.name = dirEntry.path().filename().string();
+        file.version = PixelsFooterCache::getFileVersion(dirEntry.path().string());
+        const FileEntry *indexed = previous != nullptr ? previous->find(file.name, file.version) : nullptr;
+        if (indexed != nullptr)
+        {
+            file.tail.assign((const char *) previous->data + indexed->tailOffset, indexed->tailLength);
+            auto sections = (const Section *) (previous->data + indexed->rgOffset);
+            for (uint32_t rg = 0; rg < indexed->rgNum; rg++)
+            {
+                file.rgFooters.emplace_back((const char *) previous->data + sections[rg].offset, sections[rg].length);
+            }
+            files.emplace_back(std::move(file));
+            continue;
+        }
+        int fd = ::open(dirEntry.path().c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            continue;
+        }
+        // the last 8 bytes of a pxl file are the big endian offset of the file tail
+        std::string buffer;
+        bool valid = file.version.length > (long) sizeof(uint64_t) &&
+                     readAt(fd, file.version.length - sizeof(uint64_t), sizeof(uint64_t), buffer);
+        FileTail fileTail;
+        if (valid)
+        {
+            uint64_t tailOffset;
+            std::memcpy(&tailOffset, buffer.data(), sizeof(uint64_t));
+            tailOffset = __builtin_bswap64(tailOffset);
+            valid = tailOffset < (uint64_t) file.version.length - sizeof(uint64_t) &&
+                    readAt(fd, tailOffset, file.version.length - tailOffset - sizeof(uint64_t), file.tail) &&
+                    fileTail.ParseFromString(file.tail);
+        }
+        for (int rg = 0; valid && rg < fileTail.footer().rowgroupinfos_size(); rg++)
+        {
+            const auto &rgInfo = fileTail.footer().rowgroupinfos(rg);
+            file.rgFooters.emplace_back();
+            valid = readAt(fd, rgInfo.footeroffset(), rgInfo.footerlength(), file.rgFooters.back());
+        }
+        ::close(fd);
+        if (valid)
+        {
+            files.emplace_back(std::move(file));
+        }
+    }
+    std::sort(files.begin(), files.end(), [](const IndexedFile &a, const IndexedFile &b)
+    {
+        return a.name < b.name;
+    });
+
+    // lay out the header, the file entries and the sections first, and then the data
+    std::string content(sizeof(Header) + files.size() * sizeof(FileEntry), '\0');
+    for (const auto &file: files)
+    {
+        content.append(file.rgFooters.size() * sizeof(Section), '\0');
+    }
+    Header header{{'P', 'X', 'F', 'I'}, FORMAT_VERSION, (uint32_t) files.size(), 0};
+    std::memcpy(content.data(), &header, sizeof(Header));
+    uint64_t rgOffset = sizeof(Header) + files.size() * sizeof(FileEntry);
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        const IndexedFile &file = files[i];
+        FileEntry entry{};
+        entry.nameOffset = content.size();
+        entry.nameLength = file.name.size();
+        content.append(file.name);
+        entry.length = file.version.length;
+        entry.modifyTime = file.version.modifyTime;
+        entry.tailOffset = content.size();
+        entry.tailLength = file.tail.size();
+        content.append(file.tail);
+        entry.rgNum = file.rgFooters.size();
+        entry.rgOffset = rgOffset;
+        for (size_t rg = 0; rg < file.rgFooters.size(); rg++)
+        {
+            Section section{content.size(), (uint32_t) file.rgFooters[rg].size(), 0};
+            std::memcpy(content.data() + rgOffset + rg * sizeof(Section), &section, sizeof(Section));
+            content.append(file.rgFooters[rg]);
+        }
+        rgOffset += file.rgFooters.size() * sizeof(Section);
+        std::memcpy(content.data() + sizeof(Header) + i * sizeof(FileEntry), &entry, sizeof(FileEntry));
+    }
+
+    // write to a temporary file and rename it, so that readers never see a partial index
+    std::string tmpPath = indexPath + "." + std::to_string(getpid()) + ".tmp";
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    uint64_t done = 0;
+    while (done < content.size())
+    {
+        ssize_t n = write(fd, content.data() + done, content.size() - done);
+        if (n <= 0)
+        {
+            ::close(fd);
+            unlink(tmpPath.c_str());
+            return false;
+        }
+        done += n;
+    }
+    ::close(fd);
+    if (rename(tmpPath.c_str(), indexPath.c_str()) != 0)
+    {
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,414 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "PixelsFooterPrefetcher.h"
+#include "PixelsFooterIndex.h"
+#include "utils/ConfigFactory.h"
+#include "utils/Endianness.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <liburing.h>
+#include <unistd.h>
+
+std::vector <std::shared_ptr<FileTail>>
+PixelsFooterPrefetcher::prefetchFileTails(const std::vector <std::string> &filePaths,
+                                          std::shared_ptr <PixelsFooterCache> footerCache)
+{
+    int queueDepth = std::stoi(ConfigFactory::Instance().getProperty("pixel.footer.prefetch.depth"));
+    long tailReadSize = std::stol(ConfigFactory::Instance().getProperty("pixel.tail.read.size"));
+    bool useFooterIndex = PixelsFooterIndex::isEnabled();
+
+    // the files are prefetched in windows of queueDepth files and the files of a window are closed
+    // before the next window opens, so that the open files stay far below the limit of the process
+    size_t windowSize = std::max(queueDepth, 1);
+    std::vector <std::shared_ptr<FileTail>> fileTails(filePaths.size());
+    std::vector <PrefetchedFile> files;
+    for (size_t windowStart = 0; windowStart < filePaths.size(); windowStart += windowSize)
+    {
+        size_t windowEnd = std::min(filePaths.size(), windowStart + windowSize);
+        files.assign(windowEnd - windowStart, PrefetchedFile());
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            files[i].path = stripScheme(filePaths[windowStart + i]);
+        }
+        prefetchTailWindow(files, footerCache, queueDepth, tailReadSize, useFooterIndex);
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            fileTails[windowStart + i] = files[i].fileTail;
+            if (files[i].fd >= 0)
+            {
+                ::close(files[i].fd);
+            }
+        }
+    }
+    return fileTails;
+}
+
+void PixelsFooterPrefetcher::prefetchRGFooters(const std::vector <std::string> &filePaths,
+                                               const std::vector <std::shared_ptr<FileTail>> &fileTails,
+                                               std::shared_ptr <PixelsFooterCache> footerCache,
+                                               const std::atomic<bool> &cancelled)
+{
+    int queueDepth = std::stoi(ConfigFactory::Instance().getProperty("pixel.footer.prefetch.depth"));
+    bool useFooterIndex = PixelsFooterIndex::isEnabled();
+
+    // the file tails of this scan are in the cache too, so they count against the budget
+    uint64_t budget = footerCache->getCapacity();
+    uint64_t cachedBytes = 0;
+    for (const auto &fileTail: fileTails)
+    {
+        if (fileTail != nullptr)
+        {
+            cachedBytes += fileTail->SpaceUsedLong();
+        }
+    }
+
+    size_t windowSize = std::max(queueDepth, 1);
+    std::vector <PrefetchedFile> files;
+    bool withinBudget = cachedBytes < budget;
+    for (size_t windowStart = 0; windowStart < filePaths.size() && withinBudget && !cancelled;
+         windowStart += windowSize)
+    {
+        size_t windowEnd = std::min(filePaths.size(), windowStart + windowSize);
+        files.clear();
+        for (size_t i = windowStart; i < windowEnd; i++)
+        {
+            if (fileTails[i] == nullptr)
+            {
+                continue;
+            }
+            PrefetchedFile file;
+            file.path = stripScheme(filePaths[i]);
+            file.version = PixelsFooterCache::getFileVersion(file.path);
+            file.fileTail = fileTails[i];
+            if (useFooterIndex)
+            {
+                file.footerIndex = PixelsFooterIndex::openForFile(file.path);
+            }
+            files.push_back(std::move(file));
+        }
+        withinBudget = prefetchFooterWindow(files, footerCache, queueDepth, budget, cachedBytes);
+        for (auto &file: files)
+        {
+            if (file.fd >= 0)
+            {
+                ::close(file.fd);
+            }
+        }
+    }
+}
+
+std::string PixelsFooterPrefetcher::stripScheme(const std::string &filePath)
+{
+    return filePath.rfind("file://", 0) == 0 ? filePath.substr(7) : filePath;
+}
+
+void PixelsFooterPrefetcher::prefetchTailWindow(std::vector <PrefetchedFile> &files,
+                                                std::shared_ptr <PixelsFooterCache> footerCache,
+                                                int queueDepth, long tailReadSize, bool useFooterIndex)
+{
+    std::vector <ReadRequest> requests;
+    std::vector <size_t> requestFiles;
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        PrefetchedFile &file = files[i];
+        file.version = PixelsFooterCache::getFileVersion(file.path);
+        if (file.version.length < (long) sizeof(long))
+        {
+            continue;
+        }
+        file.fileTail = footerCache->getFileTail(file.path, file.version);
+        if (file.fileTail == nullptr && useFooterIndex)
+        {
+            file.footerIndex = PixelsFooterIndex::openForFile(file.path);
+            if (file.footerIndex != nullptr)
+            {
+                file.fileTail = file.footerIndex->getFileTail(file.path, file.version);
+            }
+        }
+        if (file.fileTail != nullptr)
+        {
+            continue;
+        }
+        file.fd = ::open(file.path.c_str(), O_RDONLY);
+        if (file.fd < 0)
+        {
+            continue;
+        }
+        // the trailing window holds the file tail and its offset unless the file tail is larger
+        long windowLen = std::min(file.version.length, tailReadSize);
+        requests.push_back({file.fd, (uint64_t) (file.version.length - windowLen),
+                            std::string(windowLen, '\0'), 0, false});
+        requestFiles.push_back(i);
+    }
+    readAll(requests, queueDepth);
+
+    // parse the file tails in the windows and read the file tails larger than the window
+    std::vector <ReadRequest> tailRequests;
+    std::vector <size_t> tailRequestFiles;
+    auto parseFileTail = [&](PrefetchedFile &file, const char *data, size_t length)
+    {
+        auto fileTail = std::make_shared<FileTail>();
+        if (fileTail->ParseFromArray(data, (int) length))
+        {
+            file.fileTail = fileTail;
+        }
+    };
+    for (size_t r = 0; r < requests.size(); r++)
+    {
+        ReadRequest &request = requests[r];
+        PrefetchedFile &file = files[requestFiles[r]];
+        if (request.failed)
+        {
+            continue;
+        }
+        long fileTailOffset;
+        std::memcpy(&fileTailOffset, request.buffer.data() + request.buffer.size() - sizeof(long), sizeof(long));
+        if (Endianness::isLittleEndian())
+        {
+            fileTailOffset = (long) __builtin_bswap64(fileTailOffset);
+        }
+        if (fileTailOffset < 0 || fileTailOffset > file.version.length - (long) sizeof(long))
+        {
+            continue;
+        }
+        size_t fileTailLength = file.version.length - fileTailOffset - sizeof(long);
+        if (fileTailOffset >= (long) request.offset)
+        {
+            parseFileTail(file, request.buffer.data() + (fileTailOffset - request.offset), fileTailLength);
+        }
+        else
+        {
+            tailRequests.push_back({file.fd, (uint64_t) fileTailOffset, std::string(fileTailLength, '\0'), 0, false});
+            tailRequestFiles.push_back(requestFiles[r]);
+        }
+    }
+    requests.clear();
+    readAll(tailRequests, queueDepth);
+    for (size_t r = 0; r < tailRequests.size(); r++)
+    {
+        if (!tailRequests[r].failed)
+        {
+            parseFileTail(files[tailRequestFiles[r]], tailRequests[r].buffer.data(), tailRequests[r].buffer.size());
+        }
+    }
+    tailRequests.clear();
+    for (auto &file: files)
+    {
+        if (file.fileTail != nullptr)
+        {
+            footerCache->putFileTail(file.path, file.version, file.fileTail);
+        }
+    }
+}
+
+bool PixelsFooterPrefetcher::prefetchFooterWindow(std::vector <PrefetchedFile> &files,
+                                                  std::shared_ptr <PixelsFooterCache> footerCache,
+                                                  int queueDepth, uint64_t budget, uint64_t &cachedBytes)
+{
+    // read the row group footers that are neither cached nor in the footer index, the footers
+    // are queued by their length in the file, which is below the bytes they take in the cache
+    std::vector <std::pair<size_t, int>> footerRequestRGs;
+    std::vector <ReadRequest> footerRequests;
+    uint64_t queuedBytes = 0;
+    bool withinBudget = true;
+    for (size_t i = 0; i < files.size() && withinBudget; i++)
+    {
+        PrefetchedFile &file = files[i];
+        const auto &rgInfos = file.fileTail->footer().rowgroupinfos();
+        for (int rgId = 0; rgId < rgInfos.size(); rgId++)
+        {
+            if (footerCache->getRGFooter(file.path, file.version, rgId) != nullptr)
+            {
+                continue;
+            }
+            if (file.footerIndex != nullptr)
+            {
+                auto footer = file.footerIndex->getRGFooter(file.path, file.version, rgId);
+                if (footer != nullptr)
+                {
+                    footerCache->putRGFooter(file.path, file.version, rgId, footer);
+                    cachedBytes += footer->SpaceUsedLong();
+                    continue;
+                }
+            }
+            uint64_t footerLength = rgInfos.Get(rgId).footerlength();
+            if (cachedBytes + queuedBytes + footerLength > budget)
+            {
+                withinBudget = false;
+                break;
+            }
+            if (file.fd < 0)
+            {
+                file.fd = ::open(file.path.c_str(), O_RDONLY);
+                if (file.fd < 0)
+                {
+                    break;
+                }
+            }
+            footerRequests.push_back({file.fd, rgInfos.Get(rgId).footeroffset(),
+                                      std::string(footerLength, '\0'), 0, false});
+            footerRequestRGs.emplace_back(i, rgId);
+            queuedBytes += footerLength;
+        }
+    }
+    readAll(footerRequests, queueDepth);
+    for (size_t r = 0; r < footerRequests.size(); r++)
+    {
+        auto footer = std::make_shared<RowGroupFooter>();
+        if (!footerRequests[r].failed && footer->ParseFromString(footerRequests[r].buffer))
+        {
+            const PrefetchedFile &file = files[footerRequestRGs[r].first];
+            footerCache->putRGFooter(file.path, file.version, footerRequestRGs[r].second, footer);
+            cachedBytes += footer->SpaceUsedLong();
+        }
+    }
+    return withinBudget && cachedBytes < budget;
+}
+
+void PixelsFooterPrefetcher::readAll(std::vector <ReadRequest> &requests, int queueDepth)
+{
+    if (requests.empty())
+    {
+        return;
+    }
+    struct io_uring ring{};
+    if (queueDepth <= 0 || io_uring_queue_init(queueDepth, &ring, 0) < 0)
+    {
+        // io_uring is not available, e.g., it is disabled in the container
+        readAllSync(requests);
+        return;
+    }
+    std::deque <size_t> pending;
+    for (size_t r = 0; r < requests.size(); r++)
+    {
+        if (requests[r].done < requests[r].buffer.size())
+        {
+            pending.push_back(r);
+        }
+    }
+    // the reads prepared in the submission queue and the reads submitted to the kernel
+    int prepared = 0;
+    int inflight = 0;
+    // set when the ring fails, the reads in flight are still reaped before the ring is released,
+    // as the kernel writes into their buffers until they complete
+    bool broken = false;
+    while ((!broken && !pending.empty()) || inflight > 0)
+    {
+        while (!broken && !pending.empty() && prepared + inflight < queueDepth)
+        {
+            struct io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+            if (sqe == nullptr)
+            {
+                break;
+            }
+            ReadRequest &request = requests[pending.front()];
+            io_uring_prep_read(sqe, request.fd, request.buffer.data() + request.done,
+                               request.buffer.size() - request.done, request.offset + request.done);
+            io_uring_sqe_set_data64(sqe, pending.front());
+            pending.pop_front();
+            prepared++;
+        }
+        if (!broken && prepared > 0)
+        {
+            int ret = io_uring_submit(&ring);
+            if (ret > 0)
+            {
+                prepared -= ret;
+                inflight += ret;
+            }
+            else if (ret < 0 && ret != -EINTR && ret != -EAGAIN && ret != -EBUSY)
+            {
+                // the prepared reads are never submitted, they are failed below
+                broken = true;
+            }
+        }
+        if (inflight == 0)
+        {
+            continue;
+        }
+        struct io_uring_cqe *cqe;
+        int ret = io_uring_wait_cqe(&ring, &cqe);
+        if (ret < 0)
+        {
+            continue;
+        }
+        while (inflight > 0 && io_uring_peek_cqe(&ring, &cqe) == 0)
+        {
+            size_t r = io_uring_cqe_get_data64(cqe);
+            ReadRequest &request = requests[r];
+            if (cqe->res == -EAGAIN || cqe->res == -EINTR)
+            {
+                // the read was interrupted before it read anything, read it again
+                pending.push_back(r);
+            }
+            else if (cqe->res <= 0)
+            {
+                request.failed = true;
+            }
+            else
+            {
+                request.done += cqe->res;
+                if (request.done < request.buffer.size())
+                {
+                    // a short read, read the remaining bytes
+                    pending.push_back(r);
+                }
+            }
+            io_uring_cqe_seen(&ring, cqe);
+            inflight--;
+        }
+    }
+    io_uring_queue_exit(&ring);
+    for (auto &request: requests)
+    {
+        if (request.done < request.buffer.size())
+        {
+            request.failed = true;
+        }
+    }
+}
+
+void PixelsFooterPrefetcher::readAllSync(std::vector <ReadRequest> &requests)
+{
+    for (auto &request: requests)
+    {
+        while (!request.failed && request.done < request.buffer.size())
+        {
+            ssize_t n = pread(request.fd, request.buffer.data() + request.done,
+                              request.buffer.size() - request.done, (off_t) (request.offset + request.done));
+            if (n <= 0)
+            {
+                request.failed = true;
+            }
+            else
+            {
+                request.done += n;
+            }
+        }
+    }
+}
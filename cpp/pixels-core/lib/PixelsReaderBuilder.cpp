@@ -24,6 +24,9 @@
  */
 #include "PixelsReaderBuilder.h"
 #include "utils/Endianness.h"
+#include "utils/ConfigFactory.h"
+#include <algorithm>
+#include <cstring>
 
 PixelsReaderBuilder::PixelsReaderBuilder()
 {
@@ -59,12 +62,32 @@ std::shared_ptr<PixelsReader> PixelsReaderBuilder::build()
     std::shared_ptr<PhysicalReader> fsReader =
             PhysicalReaderUtil::newPhysicalReader (builderStorage, builderPath);
     // try to get file tail from cache
-    std::string fileName = fsReader->getName ();
+    std::string filePath = fsReader->getPath ();
     std::shared_ptr<pixels::proto::FileTail> fileTail;
-    if (builderPixelsFooterCache != nullptr && builderPixelsFooterCache->containsFileTail (fileName))
+    PixelsFooterCache::FileVersion cacheVersion;
+    bool useFooterIndex = PixelsFooterIndex::isEnabled ();
+    if (builderPixelsFooterCache != nullptr || useFooterIndex)
     {
-        fileTail = builderPixelsFooterCache->getFileTail (fileName);
-    } else
+        cacheVersion = PixelsFooterCache::getFileVersion (filePath);
+    }
+    if (builderPixelsFooterCache != nullptr)
+    {
+        fileTail = builderPixelsFooterCache->getFileTail (filePath, cacheVersion);
+    }
+    if (fileTail == nullptr && useFooterIndex)
+    {
+        // a newly started process finds the file tail in the footer index of the directory
+        auto footerIndex = PixelsFooterIndex::openForFile (filePath);
+        if (footerIndex != nullptr)
+        {
+            fileTail = footerIndex->getFileTail (filePath, cacheVersion);
+        }
+        if (fileTail != nullptr && builderPixelsFooterCache != nullptr)
+        {
+            builderPixelsFooterCache->putFileTail (filePath, cacheVersion, fileTail);
+        }
+    }
+    if (fileTail == nullptr)
     {
         if (fsReader.get () == nullptr)
         {
@@ -73,27 +96,44 @@ std::shared_ptr<PixelsReader> PixelsReaderBuilder::build()
         }
         // get FileTail
         long fileLen = fsReader->getFileLength ();
-        fsReader->seek (fileLen - (long) sizeof (long));
+        // read the trailing window of the file in one request, which holds the file tail and
+        // its offset unless the file tail is larger than the window
+        long windowLen = std::min (fileLen, std::stol (ConfigFactory::Instance ().getProperty ("pixel.tail.read.size")));
+        if (windowLen < (long) sizeof (long))
+        {
+            throw InvalidArgumentException ("PixelsReaderBuilder::build: the file is too short to have a FileTail!");
+        }
+        long windowOffset = fileLen - windowLen;
+        fsReader->seek (windowOffset);
+        std::shared_ptr<ByteBuffer> windowBuffer = fsReader->readFully ((int) windowLen);
         // get FileTailOffset
-
-        long fileTailOffset = fsReader->readLong ();
+        long fileTailOffset;
+        std::memcpy (&fileTailOffset, windowBuffer->getPointer () + windowLen - sizeof (long), sizeof (long));
         if (Endianness::isLittleEndian ())
         {
             fileTailOffset = (long) __builtin_bswap64 (fileTailOffset);
         }
 
         int fileTailLength = (int) (fileLen - fileTailOffset - sizeof (long));
-        fsReader->seek (fileTailOffset);
-        std::shared_ptr<ByteBuffer> fileTailBuffer = fsReader->readFully (fileTailLength);
+        const uint8_t *fileTailData;
+        std::shared_ptr<ByteBuffer> fileTailBuffer;
+        if (fileTailOffset >= windowOffset)
+        {
+            fileTailData = windowBuffer->getPointer () + (fileTailOffset - windowOffset);
+        } else
+        {
+            fsReader->seek (fileTailOffset);
+            fileTailBuffer = fsReader->readFully (fileTailLength);
+            fileTailData = fileTailBuffer->getPointer ();
+        }
         fileTail = std::make_shared<pixels::proto::FileTail> ();
-        if (!fileTail->ParseFromArray (fileTailBuffer->getPointer (),
-                                       fileTailLength))
+        if (!fileTail->ParseFromArray (fileTailData, fileTailLength))
         {
             throw InvalidArgumentException ("PixelsReaderBuilder::build: paring FileTail error!");
         }
         if (builderPixelsFooterCache != nullptr)
         {
-            builderPixelsFooterCache->putFileTail (fileName, fileTail);
+            builderPixelsFooterCache->putFileTail (filePath, cacheVersion, fileTail);
         }
     }
 
@@ -51,8 +51,10 @@ PixelsWriterImpl::PixelsWriterImpl(std::shared_ptr<TypeDescription> schema,
                                    int blockSize, bool blockPadding,
                                    EncodingLevel encodingLevel,
                                    bool nullsPadding, bool partitioned,
-                                   int compressionBlockSize)
+                                   int compressionBlockSize,
+                                   pixels::proto::CompressionKind compressionKind)
     : schema(schema), rowGroupSize(rowGroupSize),
+      compressionKind(compressionKind),
       compressionBlockSize(compressionBlockSize)
 {
   this->columnWriterOption = std::make_shared<PixelsWriterOption>()
@@ -61,7 +63,7 @@ PixelsWriterImpl::PixelsWriterImpl(std::shared_ptr<TypeDescription> schema,
       ->setNullsPadding(nullsPadding);
   this->physicalWriter = PhysicalWriterUtil::newPhysicalWriter(
       targetFilePath, blockSize, blockPadding, false);
-  this->compressionKind = pixels::proto::CompressionKind::NONE;
+  this->compressionCodec = CompressionCodec::create(compressionKind);
   // this->timeZone =
   // std::unique_ptr<icu::TimeZone>(icu::TimeZone::createDefault());
   this->children = schema->getChildren();
@@ -71,6 +73,7 @@ PixelsWriterImpl::PixelsWriterImpl(std::shared_ptr<TypeDescription> schema,
   {
     columnWriters.push_back(ColumnWriterBuilder::newColumnWriter(
         children.at(i), columnWriterOption));
+    fileColStatRecorders.push_back(StatsRecorder::create(*children.at(i)));
   }
 }
 
@@ -155,16 +158,23 @@ void PixelsWriterImpl::writeRowGroup()
   // TODO
   std::cout << "Try to write rowGroup" << std::endl;
   int rowGroupDataLength = 0;
-  //    pixels::proto::RowGroupStatistic curRowGroupStatistic;
+  pixels::proto::RowGroupStatistic curRowGroupStatistic;
   pixels::proto::RowGroupInformation curRowGroupInfo;
   pixels::proto::RowGroupIndex curRowGroupIndex;
   pixels::proto::RowGroupEncoding curRowGroupEncoding;
+  std::vector<std::vector<uint8_t>> chunkContents;
   // reset each column writer and get current row group content size in bytes
   for (auto writer : columnWriters)
   {
     // flush writes the isNull bit map into the internal output stream.
     writer->flush();
-    rowGroupDataLength += writer->getColumnChunkSize();
+    chunkContents.emplace_back(writer->getColumnChunkContent());
+    if (compressionCodec != nullptr)
+    {
+      chunkContents.back() = compressionCodec->compressChunk(chunkContents.back(),
+                                                             compressionBlockSize * 1024);
+    }
+    rowGroupDataLength += chunkContents.back().size();
     if (CHUNK_ALIGNMENT != 0 && rowGroupDataLength % CHUNK_ALIGNMENT != 0)
     {
       /*
@@ -201,9 +211,8 @@ void PixelsWriterImpl::writeRowGroup()
                                  "column chunks in the row group");
       }
 
-      for (auto &writer : columnWriters)
+      for (auto &rowGroupBuffer : chunkContents)
       {
-        auto rowGroupBuffer = writer->getColumnChunkContent();
         physicalWriter->append(rowGroupBuffer.data(), 0, rowGroupBuffer.size());
         writtenBytes += rowGroupBuffer.size();
         if (CHUNK_ALIGNMENT != 0 &&
@@ -234,9 +243,9 @@ void PixelsWriterImpl::writeRowGroup()
     std::shared_ptr<ColumnWriter> writer = columnWriters[i];
     auto chunkIndex = writer->getColumnChunkIndex();
     chunkIndex.set_chunkoffset(curRowGroupOffset + rowGroupDataLength);
-    chunkIndex.set_chunklength(writer->getColumnChunkSize());
+    chunkIndex.set_chunklength(chunkContents[i].size());
     chunkIndex.set_littleendian(true);
-    rowGroupDataLength += writer->getColumnChunkSize();
+    rowGroupDataLength += chunkContents[i].size();
     if (CHUNK_ALIGNMENT != 0 && rowGroupDataLength % CHUNK_ALIGNMENT != 0)
     {
       rowGroupDataLength +=
@@ -245,6 +254,9 @@ void PixelsWriterImpl::writeRowGroup()
     *(curRowGroupIndex.add_columnchunkindexentries()) = chunkIndex;
     *(curRowGroupEncoding.add_columnchunkencodings()) =
         writer->getColumnChunkEncoding();
+    // collect the column chunk statistic into the row group and file statistics
+    *(curRowGroupStatistic.add_columnchunkstats()) = writer->getColumnChunkStat();
+    fileColStatRecorders[i]->merge(writer->getColumnChunkStatRecorder());
 
     columnWriters[i] = ColumnWriterBuilder::newColumnWriter(children.at(i),
                                                             columnWriterOption);
@@ -281,6 +293,7 @@ void PixelsWriterImpl::writeRowGroup()
   curRowGroupInfo.set_footerlength(rowGroupFooter->ByteSizeLong());
   curRowGroupInfo.set_numberofrows(curRowGroupNumOfRows);
   rowGroupInfoList.push_back(curRowGroupInfo);
+  rowGroupStatisticList.push_back(curRowGroupStatistic);
 
   this->fileRowNum += curRowGroupNumOfRows;
   this->fileContentLength += rowGroupDataLength;
@@ -294,11 +307,21 @@ void PixelsWriterImpl::writeFileTail()
   std::shared_ptr<pixels::proto::PostScript> postScript =
       std::make_shared<pixels::proto::PostScript>();
   schema->writeTypes(footer);
+  for (const auto &recorder : fileColStatRecorders)
+  {
+    *(footer->add_columnstats()) = recorder->serialize();
+  }
   for (auto rowGroupInformation : rowGroupInfoList)
   {
     *(footer->add_rowgroupinfos()) = rowGroupInformation;
   }
+  for (const auto &rowGroupStatistic : rowGroupStatisticList)
+  {
+    *(footer->add_rowgroupstats()) = rowGroupStatistic;
+  }
   postScript->set_version(PixelsVersion::V1);
+  // readers only decompress the column chunks if this is set
+  postScript->set_blockcompressed(compressionCodec != nullptr);
   std::string FILE_MAGIC = "PIXELS";
   postScript->set_contentlength(fileContentLength);
   postScript->set_numberofrows(fileRowNum);
@@ -371,11 +371,18 @@ std::shared_ptr <ColumnVector> TypeDescription::createColumn(int maxSize, std::v
     // the length of useEncodedVector is already checked, not need to check again.
     switch (category)
     {
+        case BOOLEAN:
+        case BYTE:
+            return std::make_shared<ByteColumnVector>(maxSize, useEncodedVector.at(0));
         case SHORT:
         case INT:
             return std::make_shared<IntColumnVector>(maxSize, useEncodedVector.at(0));
         case LONG:
             return std::make_shared<LongColumnVector>(maxSize, useEncodedVector.at(0));
+        case FLOAT:
+            return std::make_shared<FloatColumnVector>(maxSize, useEncodedVector.at(0));
+        case DOUBLE:
+            return std::make_shared<DoubleColumnVector>(maxSize, useEncodedVector.at(0));
         case DATE:
             return std::make_shared<DateColumnVector>(maxSize, useEncodedVector.at(0));
         case DECIMAL:
@@ -386,7 +393,7 @@ std::shared_ptr <ColumnVector> TypeDescription::createColumn(int maxSize, std::v
             }
             else
             {
-                throw InvalidArgumentException("Currently we didn't implement LongDecimalColumnVector.");
+                return std::make_shared<LongDecimalColumnVector>(maxSize, precision, scale, useEncodedVector.at(0));
             }
         }
         case TIMESTAMP:
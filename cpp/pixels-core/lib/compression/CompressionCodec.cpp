@@ -0,0 +1,158 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "compression/CompressionCodec.h"
+#include "exception/InvalidArgumentException.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#ifdef PIXELS_WITH_ZSTD
+#include "compression/ZstdCodec.h"
+#endif
+#ifdef PIXELS_WITH_LZ4
+#include "compression/Lz4Codec.h"
+#endif
+#ifdef PIXELS_WITH_SNAPPY
+#include "compression/SnappyCodec.h"
+#endif
+
+namespace
+{
+const uint32_t STORED_FLAG = 0x80000000u;
+
+void putUint32(uint8_t *dst, uint32_t value)
+{
+    // the file is little endian, as the column chunks are
+    for (int i = 0; i < 4; i++)
+    {
+        dst[i] = (uint8_t) (value >> (8 * i));
+    }
+}
+
+uint32_t getUint32(const uint8_t *src)
+{
+    return (uint32_t) src[0] | ((uint32_t) src[1] << 8) | ((uint32_t) src[2] << 16) | ((uint32_t) src[3] << 24);
+}
+}
+
+std::shared_ptr <CompressionCodec> CompressionCodec::create(pixels::proto::CompressionKind kind)
+{
+    switch (kind)
+    {
+        case pixels::proto::CompressionKind::NONE:
+            return nullptr;
+#ifdef PIXELS_WITH_ZSTD
+        case pixels::proto::CompressionKind::ZSTD:
+            return std::make_shared<ZstdCodec>();
+#endif
+#ifdef PIXELS_WITH_LZ4
+        case pixels::proto::CompressionKind::LZ4:
+            return std::make_shared<Lz4Codec>();
+#endif
+#ifdef PIXELS_WITH_SNAPPY
+        case pixels::proto::CompressionKind::SNAPPY:
+            return std::make_shared<SnappyCodec>();
+#endif
+        default:
+            throw InvalidArgumentException("CompressionCodec::create: compression kind " +
+                                           pixels::proto::CompressionKind_Name(kind) + " is not supported. ");
+    }
+}
+
+std::vector <uint8_t> CompressionCodec::compressChunk(const std::vector <uint8_t> &content, int blockSize) const
+{
+    if (blockSize <= 0 || (uint32_t) blockSize >= STORED_FLAG)
+    {
+        throw InvalidArgumentException("CompressionCodec::compressChunk: invalid compression block size. ");
+    }
+    std::vector <uint8_t> result;
+    size_t blockNum = (content.size() + blockSize - 1) / blockSize;
+    result.reserve(blockNum * BLOCK_HEADER_SIZE + maxCompressedLength(std::min(content.size(), (size_t) blockSize))
+                   * blockNum);
+    for (size_t start = 0; start < content.size(); start += blockSize)
+    {
+        size_t rawLength = std::min((size_t) blockSize, content.size() - start);
+        size_t headerPos = result.size();
+        result.resize(headerPos + BLOCK_HEADER_SIZE + maxCompressedLength(rawLength));
+        uint8_t *dst = result.data() + headerPos + BLOCK_HEADER_SIZE;
+        size_t compressedLength = compress(content.data() + start, rawLength, dst, maxCompressedLength(rawLength));
+        uint32_t storedLength = compressedLength;
+        if (compressedLength == 0 || compressedLength >= rawLength)
+        {
+            // keep the blocks that do not shrink as is, so they are copied rather than decompressed
+            std::memcpy(dst, content.data() + start, rawLength);
+            compressedLength = rawLength;
+            storedLength = rawLength | STORED_FLAG;
+        }
+        putUint32(result.data() + headerPos, storedLength);
+        putUint32(result.data() + headerPos + 4, rawLength);
+        result.resize(headerPos + BLOCK_HEADER_SIZE + compressedLength);
+    }
+    return result;
+}
+
+uint64_t CompressionCodec::getRawChunkLength(const uint8_t *chunk, uint64_t length)
+{
+    uint64_t rawLength = 0;
+    uint64_t pos = 0;
+    while (pos + BLOCK_HEADER_SIZE <= length)
+    {
+        uint32_t compressedLength = getUint32(chunk + pos) & ~STORED_FLAG;
+        rawLength += getUint32(chunk + pos + 4);
+        pos += BLOCK_HEADER_SIZE + compressedLength;
+    }
+    if (pos != length)
+    {
+        throw InvalidArgumentException("CompressionCodec::getRawChunkLength: the compressed chunk is truncated. ");
+    }
+    return rawLength;
+}
+
+void CompressionCodec::decompressChunk(const uint8_t *chunk, uint64_t length, uint8_t *dst) const
+{
+    uint64_t pos = 0;
+    while (pos + BLOCK_HEADER_SIZE <= length)
+    {
+        uint32_t storedLength = getUint32(chunk + pos);
+        uint32_t rawLength = getUint32(chunk + pos + 4);
+        uint32_t compressedLength = storedLength & ~STORED_FLAG;
+        const uint8_t *src = chunk + pos + BLOCK_HEADER_SIZE;
+        if (pos + BLOCK_HEADER_SIZE + compressedLength > length ||
+            ((storedLength & STORED_FLAG) && compressedLength != rawLength))
+        {
+            throw InvalidArgumentException("CompressionCodec::decompressChunk: the compressed chunk is corrupted. ");
+        }
+        if (storedLength & STORED_FLAG)
+        {
+            std::memcpy(dst, src, rawLength);
+        }
+        else
+        {
+            decompress(src, compressedLength, dst, rawLength);
+        }
+        dst += rawLength;
+        pos += BLOCK_HEADER_SIZE + compressedLength;
+    }
+}
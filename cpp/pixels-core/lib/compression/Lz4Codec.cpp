@@ -0,0 +1,49 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifdef PIXELS_WITH_LZ4
+#include "compression/Lz4Codec.h"
+#include "exception/InvalidArgumentException.h"
+#include <lz4.h>
+
+size_t Lz4Codec::maxCompressedLength(size_t length) const
+{
+    return LZ4_compressBound((int) length);
+}
+
+size_t Lz4Codec::compress(const uint8_t *src, size_t length, uint8_t *dst, size_t capacity) const
+{
+    int result = LZ4_compress_default((const char *) src, (char *) dst, (int) length, (int) capacity);
+    return result <= 0 ? 0 : result;
+}
+
+void Lz4Codec::decompress(const uint8_t *src, size_t length, uint8_t *dst, size_t rawLength) const
+{
+    int result = LZ4_decompress_safe((const char *) src, (char *) dst, (int) length, (int) rawLength);
+    if (result < 0 || (size_t) result != rawLength)
+    {
+        throw InvalidArgumentException("Lz4Codec::decompress: the block is corrupted. ");
+    }
+}
+#endif
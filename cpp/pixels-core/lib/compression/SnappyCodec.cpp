@@ -0,0 +1,52 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifdef PIXELS_WITH_SNAPPY
+#include "compression/SnappyCodec.h"
+#include "exception/InvalidArgumentException.h"
+#include <snappy.h>
+
+size_t SnappyCodec::maxCompressedLength(size_t length) const
+{
+    return snappy::MaxCompressedLength(length);
+}
+
+size_t SnappyCodec::compress(const uint8_t *src, size_t length, uint8_t *dst, size_t capacity) const
+{
+    size_t result = 0;
+    snappy::RawCompress((const char *) src, length, (char *) dst, &result);
+    return result;
+}
+
+void SnappyCodec::decompress(const uint8_t *src, size_t length, uint8_t *dst, size_t rawLength) const
+{
+    size_t uncompressedLength = 0;
+    if (!snappy::GetUncompressedLength((const char *) src, length, &uncompressedLength) ||
+        uncompressedLength != rawLength ||
+        !snappy::RawUncompress((const char *) src, length, (char *) dst))
+    {
+        throw InvalidArgumentException("SnappyCodec::decompress: the block is corrupted. ");
+    }
+}
+#endif
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#ifdef PIXELS_WITH_ZSTD
+#include "compression/ZstdCodec.h"
+#include "exception/InvalidArgumentException.h"
+#include <zstd.h>
+
+namespace
+{
+// a low level keeps the writer fast, zstd decompresses at the same speed for all levels
+const int COMPRESSION_LEVEL = 3;
+
+/**
+ * The decompression contexts are reused by the reader threads, which saves the
+ * allocation of the zstd working memory for every block.
+ */
+ZSTD_DCtx *getThreadContext()
+{
+    static thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx *)> context(
+            ZSTD_createDCtx(), ZSTD_freeDCtx);
+    return context.get();
+}
+}
+
+size_t ZstdCodec::maxCompressedLength(size_t length) const
+{
+    return ZSTD_compressBound(length);
+}
+
+size_t ZstdCodec::compress(const uint8_t *src, size_t length, uint8_t *dst, size_t capacity) const
+{
+    size_t result = ZSTD_compress(dst, capacity, src, length, COMPRESSION_LEVEL);
+    return ZSTD_isError(result) ? 0 : result;
+}
+
+void ZstdCodec::decompress(const uint8_t *src, size_t length, uint8_t *dst, size_t rawLength) const
+{
+    size_t result = ZSTD_decompressDCtx(getThreadContext(), dst, rawLength, src, length);
+    if (ZSTD_isError(result) || result != rawLength)
+    {
+        throw InvalidArgumentException("ZstdCodec::decompress: the block is corrupted. ");
+    }
+}
+#endif
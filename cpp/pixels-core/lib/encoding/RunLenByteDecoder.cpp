@@ -0,0 +1,118 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "encoding/RunLenByteDecoder.h"
+#include "exception/InvalidArgumentException.h"
+#include <algorithm>
+#include <cstring>
+
+RunLenByteDecoder::RunLenByteDecoder(const std::shared_ptr <ByteBuffer> &bb)
+{
+    inputStream = bb;
+    remaining = 0;
+    repeat = false;
+    repeatValue = 0;
+}
+
+void RunLenByteDecoder::close()
+{
+
+}
+
+void RunLenByteDecoder::readRun()
+{
+    if (inputStream->bytesRemaining() < 2)
+    {
+        throw InvalidArgumentException("RunLenByteDecoder::readRun: reading beyond the end of the input. ");
+    }
+    auto control = (int8_t) inputStream->get();
+    repeat = control >= 0;
+    if (repeat)
+    {
+        remaining = control + MIN_REPEAT_SIZE;
+        repeatValue = inputStream->get();
+    }
+    else
+    {
+        remaining = -control;
+    }
+}
+
+long RunLenByteDecoder::next()
+{
+    uint8_t value;
+    next(&value, 1);
+    return (int8_t) value;
+}
+
+void RunLenByteDecoder::next(uint8_t *values, int len)
+{
+    while (len > 0)
+    {
+        if (remaining == 0)
+        {
+            readRun();
+        }
+        int num = std::min(len, remaining);
+        if (repeat)
+        {
+            std::memset(values, repeatValue, num);
+        }
+        else
+        {
+            if (inputStream->bytesRemaining() < (uint32_t) num)
+            {
+                throw InvalidArgumentException("RunLenByteDecoder::next: reading beyond the end of the input. ");
+            }
+            std::memcpy(values, inputStream->getPointer() + inputStream->getReadPos(), num);
+            inputStream->setReadPos(inputStream->getReadPos() + num);
+        }
+        values += num;
+        len -= num;
+        remaining -= num;
+    }
+}
+
+void RunLenByteDecoder::skip(long numValues)
+{
+    while (numValues > 0)
+    {
+        if (remaining == 0)
+        {
+            readRun();
+        }
+        int num = (int) std::min(numValues, (long) remaining);
+        if (!repeat)
+        {
+            inputStream->setReadPos(inputStream->getReadPos() + num);
+        }
+        numValues -= num;
+        remaining -= num;
+    }
+}
+
+bool RunLenByteDecoder::hasNext()
+{
+    return remaining > 0 || inputStream->bytesRemaining() > 0;
+}
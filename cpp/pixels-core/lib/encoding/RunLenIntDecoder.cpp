@@ -23,6 +23,8 @@
  * @create 2023-03-20
  */
 #include "encoding/RunLenIntDecoder.h"
+#include <algorithm>
+#include <type_traits>
 
 RunLenIntDecoder::RunLenIntDecoder(const std::shared_ptr <ByteBuffer> &bb, bool isSigned)
 {
@@ -61,6 +63,290 @@ long RunLenIntDecoder::next()
     return result;
 }
 
+void RunLenIntDecoder::next(int32_t *values, int len)
+{
+    nextBatch(values, len);
+}
+
+void RunLenIntDecoder::next(int64_t *values, int len)
+{
+    nextBatch(values, len);
+}
+
+template<typename T>
+void RunLenIntDecoder::nextBatch(T *values, int len)
+{
+    int pos = 0;
+    while (pos < len)
+    {
+        if (used == numLiterals)
+        {
+            numLiterals = 0;
+            used = 0;
+            int decoded = decodeRun(values + pos, len - pos);
+            if (decoded > 0)
+            {
+                pos += decoded;
+                continue;
+            }
+            readValues();
+        }
+        int num = std::min(len - pos, numLiterals - used);
+        for (int i = 0; i < num; i++)
+        {
+            values[pos + i] = (T) literals[used + i];
+        }
+        used += num;
+        pos += num;
+    }
+}
+
+/**
+ * Decode the next run in the input stream into values if it is not longer than maxValues.
+ * The repeats and the fixed deltas are filled, and the bit-packed values are unpacked
+ * and zigzag decoded in a single pass by EncodingUtils::unpack.
+ * @param values the destination of the decoded values
+ * @param maxValues the maximum number of values to decode
+ * @return the length of the decoded run, or 0 if the run is not decoded
+ */
+template<typename T>
+int RunLenIntDecoder::decodeRun(T *values, int maxValues)
+{
+    uint32_t runStart = inputStream->getReadPos();
+    int firstByte = (int) inputStream->get();
+    auto currentEncoding = (EncodingType)((firstByte >> 6) & 0x03);
+    switch (currentEncoding)
+    {
+        case RunLenIntEncoder::SHORT_REPEAT:
+        {
+            int size = ((((uint32_t) firstByte) >> 3) & 0x07) + 1;
+            int len = (firstByte & 0x07) + Constants::MIN_REPEAT;
+            if (len > maxValues)
+            {
+                break;
+            }
+            long val = bytesToLongBE(inputStream, size);
+            if (isSigned)
+            {
+                val = zigzagDecode(val);
+            }
+            std::fill(values, values + len, (T) val);
+            return len;
+        }
+        case RunLenIntEncoder::DIRECT:
+        {
+            int fb = encodingUtils.decodeBitWidth((firstByte >> 1) & 0x1f);
+            int len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len > maxValues)
+            {
+                break;
+            }
+            int bytes = EncodingUtils::unpack(values, len, fb,
+                                              inputStream->getPointer() + inputStream->getReadPos(), isSigned);
+            inputStream->skipBytes(bytes);
+            return len;
+        }
+        case RunLenIntEncoder::DELTA:
+        {
+            uint8_t fbo = (((uint32_t) firstByte) >> 1) & 0x1f;
+            int len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len > maxValues || len < 2)
+            {
+                break;
+            }
+            long firstVal = isSigned ? readVslong(inputStream) : readVulong(inputStream);
+            values[0] = (T) firstVal;
+            if (fbo == 0)
+            {
+                // all values have the same fixed delta
+                long fd = readVslong(inputStream);
+                for (int i = 1; i < len; i++)
+                {
+                    values[i] = (T) (firstVal + fd * i);
+                }
+                return len;
+            }
+            int fb = encodingUtils.decodeBitWidth(fbo);
+            long deltaBase = readVslong(inputStream);
+            long prevVal = firstVal + deltaBase;
+            values[1] = (T) prevVal;
+            int bytes = EncodingUtils::unpack(values + 2, len - 2, fb,
+                                              inputStream->getPointer() + inputStream->getReadPos(), false);
+            inputStream->skipBytes(bytes);
+            // prefix sum over the unpacked deltas, the sign of the delta base tells the direction
+            using UT = typename std::make_unsigned<T>::type;
+            for (int i = 2; i < len; i++)
+            {
+                long delta = (long) (UT) values[i];
+                prevVal = deltaBase < 0 ? prevVal - delta : prevVal + delta;
+                values[i] = (T) prevVal;
+            }
+            return len;
+        }
+        case RunLenIntEncoder::PATCHED_BASE:
+        {
+            int fb = encodingUtils.decodeBitWidth((firstByte >> 1) & 0x1f);
+            int len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len > maxValues)
+            {
+                break;
+            }
+            int thirdByte = inputStream->get();
+            int fourthByte = inputStream->get();
+            int baseBytes = ((thirdByte >> 5) & 0x07) + 1;
+            int patchWidth = encodingUtils.decodeBitWidth(thirdByte & 0x1f);
+            int patchGapWidth = ((fourthByte >> 5) & 0x07) + 1;
+            int patchLength = fourthByte & 0x1f;
+            if (patchWidth + patchGapWidth > 64)
+            {
+                throw InvalidArgumentException("RunLenIntDecoder::decodeRun: "
+                                               "corrupted patch list.");
+            }
+            long base = bytesToLongBE(inputStream, baseBytes);
+            long signMask = 1L << (baseBytes * 8 - 1);
+            if ((base & signMask) != 0)
+            {
+                base = -(base & ~signMask);
+            }
+            int bytes = EncodingUtils::unpack(values, len, fb,
+                                              inputStream->getPointer() + inputStream->getReadPos(), false);
+            inputStream->skipBytes(bytes);
+            long gapVsPatchList[32];
+            readInts(gapVsPatchList, 0, patchLength,
+                     encodingUtils.getClosestFixedBits(patchWidth + patchGapWidth), inputStream);
+            // put the patches back to the msb of the patched values, then add the base
+            using UT = typename std::make_unsigned<T>::type;
+            long patchMask = (1L << patchWidth) - 1;
+            long gap = 0;
+            for (int patchIdx = 0; patchIdx < patchLength; patchIdx++)
+            {
+                long entryGap = ((uint64_t) gapVsPatchList[patchIdx]) >> patchWidth;
+                long patch = gapVsPatchList[patchIdx] & patchMask;
+                gap += entryGap;
+                if (gap >= len)
+                {
+                    throw InvalidArgumentException("RunLenIntDecoder::decodeRun: "
+                                                   "patch gap out of range.");
+                }
+                if (patch != 0 || entryGap != 255)
+                {
+                    values[gap] = (T) ((long) (UT) values[gap] | (patch << fb));
+                }
+            }
+            for (int i = 0; i < len; i++)
+            {
+                values[i] = (T) (base + (long) (UT) values[i]);
+            }
+            return len;
+        }
+        default:
+            break;
+    }
+    inputStream->setReadPos(runStart);
+    return 0;
+}
+
+void RunLenIntDecoder::skip(long numValues)
+{
+    while (numValues > 0)
+    {
+        if (used == numLiterals)
+        {
+            numLiterals = 0;
+            used = 0;
+            long skipped = skipRun(numValues);
+            if (skipped > 0)
+            {
+                numValues -= skipped;
+                continue;
+            }
+            readValues();
+        }
+        long consumed = std::min(numValues, (long) (numLiterals - used));
+        used += (int) consumed;
+        numValues -= consumed;
+    }
+}
+
+/**
+ * Skip the next run in the input stream if it is not longer than maxValues.
+ * The bit-packed values of a skipped run are jumped over without unpacking.
+ * @param maxValues the maximum number of values to skip
+ * @return the length of the skipped run, or 0 if the run is not skipped
+ */
+long RunLenIntDecoder::skipRun(long maxValues)
+{
+    uint32_t runStart = inputStream->getReadPos();
+    int firstByte = (int) inputStream->get();
+    auto currentEncoding = (EncodingType)((firstByte >> 6) & 0x03);
+    switch (currentEncoding)
+    {
+        case RunLenIntEncoder::SHORT_REPEAT:
+        {
+            int size = ((((uint32_t) firstByte) >> 3) & 0x07) + 1;
+            long len = (firstByte & 0x07) + Constants::MIN_REPEAT;
+            if (len <= maxValues)
+            {
+                inputStream->skipBytes(size);
+                return len;
+            }
+            break;
+        }
+        case RunLenIntEncoder::DIRECT:
+        {
+            int fb = encodingUtils.decodeBitWidth((firstByte >> 1) & 0x1f);
+            long len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len <= maxValues)
+            {
+                inputStream->skipBytes((len * fb + 7) / 8);
+                return len;
+            }
+            break;
+        }
+        case RunLenIntEncoder::DELTA:
+        {
+            uint8_t fbo = (((uint32_t) firstByte) >> 1) & 0x1f;
+            // the first value and the delta base are not bit-packed
+            long len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len <= maxValues)
+            {
+                // the first value, then the fixed delta or the delta base
+                readVulong(inputStream);
+                readVulong(inputStream);
+                if (fbo != 0)
+                {
+                    int fb = encodingUtils.decodeBitWidth(fbo);
+                    inputStream->skipBytes(((len - 2) * fb + 7) / 8);
+                }
+                return len;
+            }
+            break;
+        }
+        case RunLenIntEncoder::PATCHED_BASE:
+        {
+            int fb = encodingUtils.decodeBitWidth((firstByte >> 1) & 0x1f);
+            long len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len <= maxValues)
+            {
+                int thirdByte = inputStream->get();
+                int fourthByte = inputStream->get();
+                int baseBytes = ((thirdByte >> 5) & 0x07) + 1;
+                int patchWidth = encodingUtils.decodeBitWidth(thirdByte & 0x1f);
+                int patchGapWidth = ((fourthByte >> 5) & 0x07) + 1;
+                int patchLength = fourthByte & 0x1f;
+                int patchBits = encodingUtils.getClosestFixedBits(patchWidth + patchGapWidth);
+                inputStream->skipBytes(baseBytes + (len * fb + 7) / 8 + (patchLength * patchBits + 7) / 8);
+                return len;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    inputStream->setReadPos(runStart);
+    return 0;
+}
+
 void RunLenIntDecoder::readValues()
 {
     // read the first 2 bits and determine the encoding type
@@ -84,8 +370,8 @@ void RunLenIntDecoder::readValues()
             readDirectValues(firstByte);
             break;
         case RunLenIntEncoder::PATCHED_BASE:
-            throw InvalidArgumentException("Currently "
-                                           "we don't support PATCHED_BASE encoding.");
+            readPatchedBaseValues(firstByte);
+            break;
         case RunLenIntEncoder::DELTA:
             readDeltaValues(firstByte);
             break;
@@ -171,10 +457,91 @@ void RunLenIntDecoder::readInts(long *buffer, int offset, int len, int bitSize,
             encodingUtils.unrolledUnPack64(buffer, offset, len, input);
             return;
         default:
-            throw InvalidArgumentException("RunLenIntDecoder::readInts: "
-                                           "not supported bitSize.");
+            break;
+    }
+    // the bit widths that are not byte aligned, e.g., in PATCHED_BASE runs
+    for (int i = offset; i < offset + len; i++)
+    {
+        long result = 0;
+        int bitsLeftToRead = bitSize;
+        while (bitsLeftToRead > bitsLeft)
+        {
+            result <<= bitsLeft;
+            result |= current & ((1 << bitsLeft) - 1);
+            bitsLeftToRead -= bitsLeft;
+            current = input->get();
+            bitsLeft = 8;
+        }
+        if (bitsLeftToRead > 0)
+        {
+            result <<= bitsLeftToRead;
+            bitsLeft -= bitsLeftToRead;
+            result |= (current >> bitsLeft) & ((1 << bitsLeftToRead) - 1);
+        }
+        buffer[i] = result;
+    }
+}
+
+void RunLenIntDecoder::readPatchedBaseValues(int firstByte)
+{
+    // extract the number of fixed bits
+    int fb = encodingUtils.decodeBitWidth((((uint32_t) firstByte) >> 1) & 0x1f);
+
+    // extract the run length of the data blob, runs are one off
+    int len = ((firstByte & 0x01) << 8) | inputStream->get();
+    len += 1;
+
+    // the third byte has 3 bits for the bytes of the base and 5 bits for the patch width
+    int thirdByte = inputStream->get();
+    int baseBytes = ((((uint32_t) thirdByte) >> 5) & 0x07) + 1;
+    int patchWidth = encodingUtils.decodeBitWidth(thirdByte & 0x1f);
+
+    // the fourth byte has 3 bits for the patch gap width and 5 bits for the patch length
+    int fourthByte = inputStream->get();
+    int patchGapWidth = ((((uint32_t) fourthByte) >> 5) & 0x07) + 1;
+    int patchLength = fourthByte & 0x1f;
+
+    // the base is stored in big endian, and its msb is the sign
+    long base = bytesToLongBE(inputStream, baseBytes);
+    long signMask = 1L << (baseBytes * 8 - 1);
+    if ((base & signMask) != 0)
+    {
+        base = -(base & ~signMask);
+    }
+
+    if (patchWidth + patchGapWidth > 64)
+    {
+        throw InvalidArgumentException("RunLenIntDecoder::readPatchedBaseValues: "
+                                       "corrupted patch list.");
+    }
+    // the base reduced values go to the literals, then the patch list follows them
+    readInts(literals, numLiterals, len, fb, inputStream);
+    long gapVsPatchList[32];
+    readInts(gapVsPatchList, 0, patchLength,
+             encodingUtils.getClosestFixedBits(patchWidth + patchGapWidth), inputStream);
+
+    // gaps longer than 255 are split into entries of 255 with a zero patch
+    long patchMask = (1L << patchWidth) - 1;
+    long gap = 0;
+    for (int patchIdx = 0; patchIdx < patchLength; patchIdx++)
+    {
+        gap += ((uint64_t) gapVsPatchList[patchIdx]) >> patchWidth;
+        long patch = gapVsPatchList[patchIdx] & patchMask;
+        if (gap >= len)
+        {
+            throw InvalidArgumentException("RunLenIntDecoder::readPatchedBaseValues: "
+                                           "patch gap out of range.");
+        }
+        if (patch != 0 || (((uint64_t) gapVsPatchList[patchIdx]) >> patchWidth) != 255)
+        {
+            literals[numLiterals + gap] |= patch << fb;
+        }
+    }
+    for (int i = 0; i < len; i++)
+    {
+        literals[numLiterals + i] += base;
     }
-    // TODO: if notthe case, we should write the following code.
+    numLiterals += len;
 }
 
 void RunLenIntDecoder::readDeltaValues(int firstByte)
@@ -370,6 +370,8 @@ void RunLenIntEncoder::preparePatchedBlob()
     // 1 gap => actual patch value
     if (patchGapWidth > 8)
     {
+        // the gaps are split into entries of at most 255, which fit in 8 bits
+        patchGapWidth = 8;
         // for gap = 511, we need two extra entries in patch list
         if (maxGap == 511)
         {
@@ -971,7 +973,7 @@ int RunLenIntEncoder::percentileBits(long *data, int offset, int length, double
         return -1;
     }
 
-    int hist[32];
+    int hist[32] = {0};
     for (int i = offset; i < (offset + length); ++i)
     {
         // QUESTION: there is calling of getClosestFixedBits in encodeBitWidth function, 
@@ -1087,7 +1089,7 @@ void RunLenIntEncoder::computeZigZagLiterals()
 
 long RunLenIntEncoder::zigzagEncode(long val)
 {
-    return (val << 1) ^ (val >> 63);
+    return (long) (((uint64_t) val << 1) ^ (val >> 63));
 }
 
 void RunLenIntEncoder::writeVulong(std::shared_ptr <ByteBuffer> output, long value)
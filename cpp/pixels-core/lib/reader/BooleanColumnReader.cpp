@@ -0,0 +1,117 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "reader/BooleanColumnReader.h"
+#include "utils/BitUtils.h"
+
+/**
+ * The column reader of booleans. The booleans of each pixel are compacted into bits
+ * in little endian, and the bits of each pixel start from a new byte.
+ */
+BooleanColumnReader::BooleanColumnReader(std::shared_ptr <TypeDescription> type) : ColumnReader(type)
+{
+    bitOffset = 0;
+}
+
+void BooleanColumnReader::close()
+{
+
+}
+
+void BooleanColumnReader::read(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                               int size, int pixelStride, int vectorIndex, std::shared_ptr <ColumnVector> vector,
+                               pixels::proto::ColumnChunkIndex &chunkIndex,
+                               std::shared_ptr <PixelsBitMask> filterMask)
+{
+    std::shared_ptr <ByteColumnVector> columnVector =
+            std::static_pointer_cast<ByteColumnVector>(vector);
+    if (offset == 0)
+    {
+        ColumnReader::elementIndex = 0;
+        isNullOffset = chunkIndex.isnulloffset();
+        bitOffset = (uint64_t) input->getReadPos() * 8;
+    }
+    if (elementIndex % pixelStride == 0)
+    {
+        bitOffset = (bitOffset + 7) / 8 * 8;
+    }
+
+    int pixelId = elementIndex / pixelStride;
+    bool hasNull = chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
+    setValid(input, pixelStride, vector, pixelId, hasNull);
+
+    const uint8_t *chunk = input->getPointer();
+    uint8_t *values = columnVector->ownedVector(vectorIndex) + vectorIndex;
+    if (!hasNull || chunkIndex.nullspadding())
+    {
+        BitUtils::bitWiseDeCompactLE(chunk, bitOffset, size, values);
+        // the filters are evaluated on the bits if they are byte aligned with the rows of the vector
+        columnVector->bits = vectorIndex == 0 && bitOffset % 8 == 0 ? chunk + bitOffset / 8 : nullptr;
+        bitOffset += size;
+    }
+    else
+    {
+        // the nulls take no bit in the chunk, so move the values to their rows
+        int valueNum = 0;
+        for (int i = 0; i < size; i++)
+        {
+            if (vector->checkValid(i))
+            {
+                values[i] = (chunk[(bitOffset + valueNum) / 8] >> ((bitOffset + valueNum) % 8)) & 1;
+                valueNum++;
+            }
+            else
+            {
+                values[i] = 0;
+            }
+        }
+        columnVector->bits = nullptr;
+        bitOffset += valueNum;
+    }
+    elementIndex += size;
+}
+
+void BooleanColumnReader::skip(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                               int size, int pixelStride, pixels::proto::ColumnChunkIndex &chunkIndex)
+{
+    if (offset == 0)
+    {
+        isNullOffset = chunkIndex.isnulloffset();
+        bitOffset = (uint64_t) input->getReadPos() * 8;
+    }
+    // skip pixel by pixel, since the bits of each pixel start from a new byte
+    for (int start = offset; start < offset + size;)
+    {
+        int end = std::min((start / pixelStride + 1) * pixelStride, offset + size);
+        if (start % pixelStride == 0)
+        {
+            bitOffset = (bitOffset + 7) / 8 * 8;
+        }
+        int valueNum = chunkIndex.nullspadding() ? end - start :
+                       end - start - countNulls(input, start, end - start, pixelStride, chunkIndex);
+        ColumnReader::skip(input, encoding, start, end - start, pixelStride, chunkIndex);
+        bitOffset += valueNum;
+        start = end;
+    }
+}
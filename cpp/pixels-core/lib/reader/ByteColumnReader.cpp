@@ -0,0 +1,143 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "reader/ByteColumnReader.h"
+
+ByteColumnReader::ByteColumnReader(std::shared_ptr <TypeDescription> type) : ColumnReader(type)
+{
+
+}
+
+void ByteColumnReader::close()
+{
+
+}
+
+void ByteColumnReader::read(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                            int size, int pixelStride, int vectorIndex, std::shared_ptr <ColumnVector> vector,
+                            pixels::proto::ColumnChunkIndex &chunkIndex, std::shared_ptr <PixelsBitMask> filterMask)
+{
+    std::shared_ptr <ByteColumnVector> columnVector =
+            std::static_pointer_cast<ByteColumnVector>(vector);
+    if (offset == 0)
+    {
+        decoder = std::make_shared<RunLenByteDecoder>(input);
+        ColumnReader::elementIndex = 0;
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+
+    int pixelId = elementIndex / pixelStride;
+    bool hasNull = chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
+    setValid(input, pixelStride, vector, pixelId, hasNull);
+
+    if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH)
+    {
+        uint8_t *values = columnVector->ownedVector(vectorIndex) + vectorIndex;
+        for (int i = 0; i < size;)
+        {
+            // decode the selected rows in bulk and skip the rows filtered out
+            bool selected = filterMask == nullptr || filterMask->get(i);
+            int runEnd = filterMask == nullptr ? size : i + 1;
+            while (runEnd < size && (bool) filterMask->get(runEnd) == selected)
+            {
+                runEnd++;
+            }
+            if (selected)
+            {
+                decoder->next(values + i, runEnd - i);
+            }
+            else
+            {
+                decoder->skip(runEnd - i);
+            }
+            i = runEnd;
+        }
+    }
+    else
+    {
+        uint8_t *values = input->getPointer() + input->getReadPos();
+        if (!hasNull || chunkIndex.nullspadding())
+        {
+            if (vectorIndex == 0)
+            {
+                // each row has a value in the chunk, so the vector points straight into the chunk
+                columnVector->vector = values;
+            }
+            else
+            {
+                std::memcpy(columnVector->ownedVector(vectorIndex) + vectorIndex, values, size);
+            }
+            input->setReadPos(input->getReadPos() + size);
+        }
+        else
+        {
+            // the nulls take no space in the chunk, so move the values to their rows
+            uint8_t *target = columnVector->ownedVector(vectorIndex) + vectorIndex;
+            int valueNum = 0;
+            for (int i = 0; i < size; i++)
+            {
+                if (vector->checkValid(i))
+                {
+                    target[i] = values[valueNum++];
+                }
+            }
+            input->setReadPos(input->getReadPos() + valueNum);
+        }
+    }
+    elementIndex += size;
+}
+
+void ByteColumnReader::skip(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                            int size, int pixelStride, pixels::proto::ColumnChunkIndex &chunkIndex)
+{
+    if (offset == 0)
+    {
+        decoder = std::make_shared<RunLenByteDecoder>(input);
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+    if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH)
+    {
+        ColumnReader::skip(input, encoding, offset, size, pixelStride, chunkIndex);
+        if ((offset + size) % pixelStride == 0)
+        {
+            // each pixel is encoded separately, so restart the decoder at the next pixel
+            int nextPixelId = (offset + size) / pixelStride;
+            if (nextPixelId < chunkIndex.pixelpositions_size())
+            {
+                input->setReadPos(chunkIndex.pixelpositions(nextPixelId));
+            }
+            decoder = std::make_shared<RunLenByteDecoder>(input);
+        }
+        else
+        {
+            decoder->skip(size);
+        }
+    }
+    else
+    {
+        int valueNum = chunkIndex.nullspadding() ? size : size - countNulls(input, offset, size, pixelStride, chunkIndex);
+        ColumnReader::skip(input, encoding, offset, size, pixelStride, chunkIndex);
+        input->setReadPos(input->getReadPos() + valueNum);
+    }
+}
@@ -79,6 +79,43 @@ ColumnReader::read(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEnco
 {
 }
 
+void ColumnReader::skip(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                        int size, int pixelStride, pixels::proto::ColumnChunkIndex &chunkIndex)
+{
+    // only the pixels containing nulls have their isNull bitmaps stored in the chunk
+    for (int start = offset; start < offset + size; start += pixelStride)
+    {
+        int pixelId = start / pixelStride;
+        if (chunkIndex.pixelstatistics(pixelId).statistic().hasnull())
+        {
+            int elementSizeInCurrPixels = std::min(pixelStride, offset + size - start);
+            isNullOffset += (int) ceil(1.0 * elementSizeInCurrPixels / 8);
+        }
+    }
+    elementIndex = offset + size;
+}
+
+int ColumnReader::countNulls(const std::shared_ptr <ByteBuffer> &input, int offset, int size, int pixelStride,
+                             const pixels::proto::ColumnChunkIndex &chunkIndex) const
+{
+    int nullNum = 0;
+    uint32_t nullOffset = isNullOffset;
+    for (int start = offset; start < offset + size; start += pixelStride)
+    {
+        int pixelId = start / pixelStride;
+        if (chunkIndex.pixelstatistics(pixelId).statistic().hasnull())
+        {
+            // the bits after the last element of a bitmap are zero
+            int byteSize = (int) ceil(1.0 * std::min(pixelStride, offset + size - start) / 8);
+            for (int i = 0; i < byteSize; i++)
+            {
+                nullNum += __builtin_popcount(input->getPointer()[nullOffset + i]);
+            }
+            nullOffset += byteSize;
+        }
+    }
+    return nullNum;
+}
 
 void ColumnReader::setValid(const std::shared_ptr <ByteBuffer> &input, int pixelStride,
                             const std::shared_ptr <ColumnVector> &columnVector, int pixelId, bool hasNull)
@@ -30,17 +30,13 @@ ColumnReaderBuilder::newColumnReader(std::shared_ptr<TypeDescription> type)
 {
   switch (type->getCategory())
   {
-    //        case TypeDescription::BOOLEAN:
-    //            break;
-    //        case TypeDescription::BYTE:
-    //            break;
+    case TypeDescription::BOOLEAN:return std::make_shared<BooleanColumnReader>(type);
+    case TypeDescription::BYTE:return std::make_shared<ByteColumnReader>(type);
     case TypeDescription::SHORT:
     case TypeDescription::INT:return std::make_shared<IntColumnReader>(type);
     case TypeDescription::LONG:return std::make_shared<LongColumnReader>(type);
-      //        case TypeDescription::FLOAT:
-      //            break;
-      //        case TypeDescription::DOUBLE:
-      //            break;
+    case TypeDescription::FLOAT:return std::make_shared<FloatColumnReader>(type);
+    case TypeDescription::DOUBLE:return std::make_shared<DoubleColumnReader>(type);
     case TypeDescription::DECIMAL:
     {
       if (type->getPrecision() <= TypeDescription::SHORT_DECIMAL_MAX_PRECISION)
@@ -48,8 +44,7 @@ ColumnReaderBuilder::newColumnReader(std::shared_ptr<TypeDescription> type)
         return std::make_shared<DecimalColumnReader>(type);
       } else
       {
-        throw InvalidArgumentException(
-            "Currently we didn't implement LongDecimalColumnVector.");
+        return std::make_shared<LongDecimalColumnReader>(type);
       }
     }
     case TypeDescription::STRING:return std::make_shared<StringColumnReader>(type);
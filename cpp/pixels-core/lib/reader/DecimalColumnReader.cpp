@@ -65,8 +65,21 @@ void DecimalColumnReader::read(std::shared_ptr <ByteBuffer> input, pixels::proto
     bool hasNull = chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
     setValid(input, pixelStride, vector, pixelId, hasNull);
 
+    // the values are referenced in the chunk instead of being decoded, so the rows filtered out
+    // by filterMask already cost nothing here and there is no run of them to step over
     columnVector->vector = (long *) (input->getPointer() + input->getReadPos());
     input->setReadPos(input->getReadPos() + size * sizeof(long));
 
 
 }
+
+void DecimalColumnReader::skip(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                               int size, int pixelStride, pixels::proto::ColumnChunkIndex &chunkIndex)
+{
+    if (offset == 0)
+    {
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+    ColumnReader::skip(input, encoding, offset, size, pixelStride, chunkIndex);
+    input->setReadPos(input->getReadPos() + size * sizeof(long));
+}
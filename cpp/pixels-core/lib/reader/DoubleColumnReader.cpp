@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "reader/DoubleColumnReader.h"
+
+/**
+ * The column reader of doubles, which are stored as little endian doubles of the IEEE 754 format.
+ */
+DoubleColumnReader::DoubleColumnReader(std::shared_ptr <TypeDescription> type) : ColumnReader(type)
+{
+
+}
+
+void DoubleColumnReader::close()
+{
+
+}
+
+void DoubleColumnReader::read(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                              int size, int pixelStride, int vectorIndex, std::shared_ptr <ColumnVector> vector,
+                              pixels::proto::ColumnChunkIndex &chunkIndex, std::shared_ptr <PixelsBitMask> filterMask)
+{
+    std::shared_ptr <DoubleColumnVector> columnVector =
+            std::static_pointer_cast<DoubleColumnVector>(vector);
+    if (offset == 0)
+    {
+        ColumnReader::elementIndex = 0;
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+
+    int pixelId = elementIndex / pixelStride;
+    bool hasNull = chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
+    setValid(input, pixelStride, vector, pixelId, hasNull);
+
+    uint8_t *values = input->getPointer() + input->getReadPos();
+    if (!hasNull || chunkIndex.nullspadding())
+    {
+        if (vectorIndex == 0)
+        {
+            // each row has a value in the chunk, so the vector points straight into the chunk
+            columnVector->vector = (double *) values;
+        }
+        else
+        {
+            std::memcpy(columnVector->ownedVector(vectorIndex) + vectorIndex, values, size * sizeof(double));
+        }
+        input->setReadPos(input->getReadPos() + size * sizeof(double));
+    }
+    else
+    {
+        // the nulls take no space in the chunk, so move the values to their rows
+        double *target = columnVector->ownedVector(vectorIndex) + vectorIndex;
+        int valueNum = 0;
+        for (int i = 0; i < size; i++)
+        {
+            if (vector->checkValid(i))
+            {
+                std::memcpy(target + i, values + valueNum * sizeof(double), sizeof(double));
+                valueNum++;
+            }
+        }
+        input->setReadPos(input->getReadPos() + valueNum * sizeof(double));
+    }
+    elementIndex += size;
+}
+
+void DoubleColumnReader::skip(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                              int size, int pixelStride, pixels::proto::ColumnChunkIndex &chunkIndex)
+{
+    if (offset == 0)
+    {
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+    int valueNum = chunkIndex.nullspadding() ? size : size - countNulls(input, offset, size, pixelStride, chunkIndex);
+    ColumnReader::skip(input, encoding, offset, size, pixelStride, chunkIndex);
+    input->setReadPos(input->getReadPos() + valueNum * sizeof(double));
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "reader/FloatColumnReader.h"
+
+/**
+ * The column reader of floats, which are stored as little endian floats of the IEEE 754 format.
+ */
+FloatColumnReader::FloatColumnReader(std::shared_ptr <TypeDescription> type) : ColumnReader(type)
+{
+
+}
+
+void FloatColumnReader::close()
+{
+
+}
+
+void FloatColumnReader::read(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                             int size, int pixelStride, int vectorIndex, std::shared_ptr <ColumnVector> vector,
+                             pixels::proto::ColumnChunkIndex &chunkIndex, std::shared_ptr <PixelsBitMask> filterMask)
+{
+    std::shared_ptr <FloatColumnVector> columnVector =
+            std::static_pointer_cast<FloatColumnVector>(vector);
+    if (offset == 0)
+    {
+        ColumnReader::elementIndex = 0;
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+
+    int pixelId = elementIndex / pixelStride;
+    bool hasNull = chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
+    setValid(input, pixelStride, vector, pixelId, hasNull);
+
+    uint8_t *values = input->getPointer() + input->getReadPos();
+    if (!hasNull || chunkIndex.nullspadding())
+    {
+        if (vectorIndex == 0)
+        {
+            // each row has a value in the chunk, so the vector points straight into the chunk
+            columnVector->vector = (float *) values;
+        }
+        else
+        {
+            std::memcpy(columnVector->ownedVector(vectorIndex) + vectorIndex, values, size * sizeof(float));
+        }
+        input->setReadPos(input->getReadPos() + size * sizeof(float));
+    }
+    else
+    {
+        // the nulls take no space in the chunk, so move the values to their rows
+        float *target = columnVector->ownedVector(vectorIndex) + vectorIndex;
+        int valueNum = 0;
+        for (int i = 0; i < size; i++)
+        {
+            if (vector->checkValid(i))
+            {
+                std::memcpy(target + i, values + valueNum * sizeof(float), sizeof(float));
+                valueNum++;
+            }
+        }
+        input->setReadPos(input->getReadPos() + valueNum * sizeof(float));
+    }
+    elementIndex += size;
+}
+
+void FloatColumnReader::skip(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                             int size, int pixelStride, pixels::proto::ColumnChunkIndex &chunkIndex)
+{
+    if (offset == 0)
+    {
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+    int valueNum = chunkIndex.nullspadding() ? size : size - countNulls(input, offset, size, pixelStride, chunkIndex);
+    ColumnReader::skip(input, encoding, offset, size, pixelStride, chunkIndex);
+    input->setReadPos(input->getReadPos() + valueNum * sizeof(float));
+}
@@ -64,13 +64,25 @@ void IntColumnReader::read(std::shared_ptr<ByteBuffer> input,
 
   if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH)
   {
-    for (int i = 0; i < size; i++)
+    for (int i = 0; i < size;)
     {
-
-      *(reinterpret_cast<int *>(columnVector->intVector) + i + vectorIndex) =
-          decoder->next();
-      elementIndex++;
+      // decode the selected rows in bulk and skip the rows filtered out
+      bool selected = filterMask == nullptr || filterMask->get(i);
+      int runEnd = filterMask == nullptr ? size : i + 1;
+      while (runEnd < size && (bool) filterMask->get(runEnd) == selected)
+      {
+        runEnd++;
+      }
+      if (selected)
+      {
+        decoder->next(reinterpret_cast<int *>(columnVector->intVector) + vectorIndex + i, runEnd - i);
+      } else
+      {
+        decoder->skip(runEnd - i);
+      }
+      i = runEnd;
     }
+    elementIndex += size;
   } else
   {
     // if int
@@ -79,3 +91,36 @@ void IntColumnReader::read(std::shared_ptr<ByteBuffer> input,
     input->setReadPos(input->getReadPos() + size * sizeof(int32_t));
   }
 }
+
+void IntColumnReader::skip(std::shared_ptr<ByteBuffer> input,
+                           pixels::proto::ColumnEncoding &encoding, int offset,
+                           int size, int pixelStride,
+                           pixels::proto::ColumnChunkIndex &chunkIndex)
+{
+  if (offset == 0)
+  {
+    decoder = std::make_shared<RunLenIntDecoder>(input, true);
+    isNullOffset = chunkIndex.isnulloffset();
+  }
+  ColumnReader::skip(input, encoding, offset, size, pixelStride, chunkIndex);
+
+  if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH)
+  {
+    if ((offset + size) % pixelStride == 0)
+    {
+      // each pixel is encoded separately, so restart the decoder at the next pixel
+      int nextPixelId = (offset + size) / pixelStride;
+      if (nextPixelId < chunkIndex.pixelpositions_size())
+      {
+        input->setReadPos(chunkIndex.pixelpositions(nextPixelId));
+      }
+      decoder = std::make_shared<RunLenIntDecoder>(input, true);
+    } else
+    {
+      decoder->skip(size);
+    }
+  } else
+  {
+    input->setReadPos(input->getReadPos() + size * sizeof(int32_t));
+  }
+}
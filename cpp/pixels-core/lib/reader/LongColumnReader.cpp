@@ -62,15 +62,62 @@ void LongColumnReader::read(std::shared_ptr<ByteBuffer> input,
 
   if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH)
   {
-    for (int i = 0; i < size; i++)
+    for (int i = 0; i < size;)
     {
-      columnVector->longVector[i + vectorIndex] = decoder->next();
-
-      elementIndex++;
+      // decode the selected rows in bulk and skip the rows filtered out
+      bool selected = filterMask == nullptr || filterMask->get(i);
+      int runEnd = filterMask == nullptr ? size : i + 1;
+      while (runEnd < size && (bool) filterMask->get(runEnd) == selected)
+      {
+        runEnd++;
+      }
+      if (selected)
+      {
+        decoder->next(columnVector->longVector + vectorIndex + i, runEnd - i);
+      } else
+      {
+        decoder->skip(runEnd - i);
+      }
+      i = runEnd;
     }
+    elementIndex += size;
   } else
   {
     columnVector->longVector =
         (int64_t *) (input->getPointer() + input->getReadPos());
+    input->setReadPos(input->getReadPos() + size * sizeof(int64_t));
+  }
+}
+
+void LongColumnReader::skip(std::shared_ptr<ByteBuffer> input,
+                            pixels::proto::ColumnEncoding &encoding, int offset,
+                            int size, int pixelStride,
+                            pixels::proto::ColumnChunkIndex &chunkIndex)
+{
+  if (offset == 0)
+  {
+    decoder = std::make_shared<RunLenIntDecoder>(input, true);
+    isNullOffset = chunkIndex.isnulloffset();
   }
-}
\ No newline at end of file
+  ColumnReader::skip(input, encoding, offset, size, pixelStride, chunkIndex);
+
+  if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH)
+  {
+    if ((offset + size) % pixelStride == 0)
+    {
+      // each pixel is encoded separately, so restart the decoder at the next pixel
+      int nextPixelId = (offset + size) / pixelStride;
+      if (nextPixelId < chunkIndex.pixelpositions_size())
+      {
+        input->setReadPos(chunkIndex.pixelpositions(nextPixelId));
+      }
+      decoder = std::make_shared<RunLenIntDecoder>(input, true);
+    } else
+    {
+      decoder->skip(size);
+    }
+  } else
+  {
+    input->setReadPos(input->getReadPos() + size * sizeof(int64_t));
+  }
+}
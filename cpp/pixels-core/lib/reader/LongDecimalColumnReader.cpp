@@ -0,0 +1,138 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "reader/LongDecimalColumnReader.h"
+#include <cstring>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/**
+ * The column reader of long decimals, whose precision is larger than 18.
+ * The unscaled values are read into the hugeint layout of duckdb, so that
+ * the HUGEINT backed DECIMAL vectors of duckdb reference them without copying.
+ */
+LongDecimalColumnReader::LongDecimalColumnReader(std::shared_ptr <TypeDescription> type) : ColumnReader(type)
+{
+
+}
+
+void LongDecimalColumnReader::close()
+{
+
+}
+
+void LongDecimalColumnReader::toHugeint(const uint8_t *input, duckdb::hugeint_t *output, int num, bool littleEndian)
+{
+    int i = 0;
+#ifdef __AVX2__
+    // little endian words only swap the high and the low word of each value, while big endian
+    // words reverse all the 16 bytes of each value
+    const __m256i swapWords = _mm256_setr_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+                                               8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i reverseBytes = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                                  15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i shuffle = littleEndian ? swapWords : reverseBytes;
+    for (; i + 2 <= num; i += 2)
+    {
+        __m256i values = _mm256_loadu_si256((const __m256i *) (input + i * VALUE_SIZE));
+        _mm256_storeu_si256((__m256i *) (output + i), _mm256_shuffle_epi8(values, shuffle));
+    }
+#endif
+    for (; i < num; i++)
+    {
+        uint64_t high, low;
+        std::memcpy(&high, input + i * VALUE_SIZE, sizeof(uint64_t));
+        std::memcpy(&low, input + i * VALUE_SIZE + sizeof(uint64_t), sizeof(uint64_t));
+        if (!littleEndian)
+        {
+            high = __builtin_bswap64(high);
+            low = __builtin_bswap64(low);
+        }
+        output[i].lower = low;
+        output[i].upper = (int64_t) high;
+    }
+}
+
+void LongDecimalColumnReader::read(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding,
+                                   int offset, int size, int pixelStride, int vectorIndex,
+                                   std::shared_ptr <ColumnVector> vector, pixels::proto::ColumnChunkIndex &chunkIndex,
+                                   std::shared_ptr <PixelsBitMask> filterMask)
+{
+    std::shared_ptr <LongDecimalColumnVector> columnVector =
+            std::static_pointer_cast<LongDecimalColumnVector>(vector);
+    if (type->getPrecision() != columnVector->getPrecision() || type->getScale() != columnVector->getScale())
+    {
+        throw InvalidArgumentException("reader of long decimal(" + std::to_string(type->getPrecision())
+                                       + "," + std::to_string(type->getScale()) + ") doesn't match the column "
+                                                                                  "vector of long decimal(" +
+                                       std::to_string(columnVector->getPrecision()) + ","
+                                       + std::to_string(columnVector->getScale()) + ")");
+    }
+    if (offset == 0)
+    {
+        ColumnReader::elementIndex = 0;
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+
+    int pixelId = elementIndex / pixelStride;
+    bool hasNull = chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
+    setValid(input, pixelStride, vector, pixelId, hasNull);
+
+    const uint8_t *values = input->getPointer() + input->getReadPos();
+    bool littleEndian = chunkIndex.littleendian();
+    if (!hasNull || chunkIndex.nullspadding())
+    {
+        toHugeint(values, columnVector->vector + vectorIndex, size, littleEndian);
+        input->setReadPos(input->getReadPos() + size * VALUE_SIZE);
+    }
+    else
+    {
+        // the nulls take no space in the chunk, so move the values to their rows
+        int valueNum = 0;
+        for (int i = 0; i < size; i++)
+        {
+            if (vector->checkValid(i))
+            {
+                toHugeint(values + valueNum * VALUE_SIZE, columnVector->vector + vectorIndex + i, 1, littleEndian);
+                valueNum++;
+            }
+        }
+        input->setReadPos(input->getReadPos() + valueNum * VALUE_SIZE);
+    }
+    elementIndex += size;
+}
+
+void LongDecimalColumnReader::skip(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding,
+                                   int offset, int size, int pixelStride,
+                                   pixels::proto::ColumnChunkIndex &chunkIndex)
+{
+    if (offset == 0)
+    {
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+    int valueNum = chunkIndex.nullspadding() ? size : size - countNulls(input, offset, size, pixelStride, chunkIndex);
+    ColumnReader::skip(input, encoding, offset, size, pixelStride, chunkIndex);
+    input->setReadPos(input->getReadPos() + valueNum * VALUE_SIZE);
+}
@@ -141,6 +141,16 @@ int PixelsReaderOption::getBatchSize() const
     return batchSize;
 }
 
+void PixelsReaderOption::setFilterColumnStats(std::shared_ptr<FilterColumnStats> stats)
+{
+    filterColumnStats = std::move(stats);
+}
+
+std::shared_ptr<FilterColumnStats> PixelsReaderOption::getFilterColumnStats() const
+{
+    return filterColumnStats;
+}
+
 
 
 
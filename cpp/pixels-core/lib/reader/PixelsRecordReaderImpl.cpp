@@ -25,6 +25,7 @@
 #include "reader/PixelsRecordReaderImpl.h"
 #include "physical/io/PhysicalLocalReader.h"
 #include "profiler/CountProfiler.h"
+#include "physical/BufferPool/BufferPoolArena.h"
 std::mutex PixelsRecordReaderImpl::mutex_;
 PixelsRecordReaderImpl::PixelsRecordReaderImpl(std::shared_ptr <PhysicalReader> reader,
                                                const pixels::proto::PostScript &pixelsPostScript,
@@ -36,6 +37,7 @@ PixelsRecordReaderImpl::PixelsRecordReaderImpl(std::shared_ptr <PhysicalReader>
     footer = pixelsFooter;
     postScript = pixelsPostScript;
     footerCache = pixelsFooterCache;
+    chunkCache = PixelsChunkCache::Instance();
     option = opt;
     // TODO: intialize all kinds of variable
     queryId = option.getQueryId();
@@ -55,13 +57,34 @@ PixelsRecordReaderImpl::PixelsRecordReaderImpl(std::shared_ptr <PhysicalReader>
         filter = nullptr;
     }
     filterMask = nullptr;
+    // the column chunks are never compressed unless blockCompressed is set, whatever their compression kind
+    compressionCodec = postScript.blockcompressed() ?
+                       CompressionCodec::create(postScript.compression()) : nullptr;
+    decompressedBufferIdx = 0;
+    filterRankInterval = std::stoi(ConfigFactory::Instance().getProperty("filter.rank.interval"));
+    // the readers of the other morsels of the scan may have learned the order of the filter columns
+    filterColumnStats = option.getFilterColumnStats();
+    if (filterColumnStats == nullptr)
+    {
+        filterColumnStats = std::make_shared<FilterColumnStats>();
+    }
+    if (filter != nullptr && filterColumnStats->stats.empty())
+    {
+        for (auto &filterCol: filter->filters)
+        {
+            filterColumnStats->stats.emplace_back((int) filterCol.first, filterCol.second.get());
+        }
+    }
     everRead = false;
     everPrepareRead = false;
     targetRGNum = 0;
+    prunedRGNum = 0;
+    prunedPixelNum = 0;
     curRGIdx = 0;
     curRowInRG = 0;
     curRGRowCount = 0;
     fileName = physicalReader->getName();
+    filePath = physicalReader->getPath();
     enableEncodedVector = option.isEnableEncodedColumnVector();
     includedColumnNum = 0;
     endOfFile = false;
@@ -200,6 +223,19 @@ std::shared_ptr <VectorizedRowBatch> PixelsRecordReaderImpl::readBatch(bool reus
         {
             throw std::runtime_error("failed to read file");
         }
+        if (endOfFile)
+        {
+            return createEmptyEOFRowBatch(0);
+        }
+    }
+
+    if (filter != nullptr)
+    {
+        skipPixels();
+        if (endOfFile)
+        {
+            return createEmptyEOFRowBatch(0);
+        }
     }
 
 
@@ -225,6 +261,11 @@ std::shared_ptr <VectorizedRowBatch> PixelsRecordReaderImpl::readBatch(bool reus
     if (filterMask != nullptr)
     {
         filterMask->set();
+        // the last batch of a row group may be shorter than the mask
+        for (int i = curBatchSize; i < filterMask->maskLength; i++)
+        {
+            filterMask->set(i, 0);
+        }
     }
 
     if(asyncReadRequestNum > 0)
@@ -235,34 +276,47 @@ std::shared_ptr <VectorizedRowBatch> PixelsRecordReaderImpl::readBatch(bool reus
     std::vector<int> filterColumnIndex;
     if (filter != nullptr)
     {
-        for (auto &filterCol: filter->filters)
+        for (auto &filterStat: filterColumnStats->stats)
         {
-            if (filterMask->isNone())
+            long inputRows = filterMask->count();
+            if (inputRows == 0)
             {
                 break;
             }
-            int i = filterCol.first;
+            auto startTime = std::chrono::steady_clock::now();
+            int i = filterStat.columnIndex;
             int index = curChunkBufferIndex.at(i);
             auto &encoding = curEncoding.at(i);
             auto &chunkIndex = curChunkIndex.at(i);
+            // the rows already filtered out by the previous filter columns are not decoded
             readers.at(i)->read(chunkBuffers.at(index), *encoding, curRowInRG, curBatchSize,
                                 postScript.pixelstride(), resultRowBatch->rowCount,
                                 columnVectors.at(i), *chunkIndex, filterMask);
             filterColumnIndex.emplace_back(index);
-            PixelsFilter::ApplyFilter(columnVectors.at(i), *filterCol.second, *filterMask,
+            // evaluate into a copy of the mask, so that the rows already filtered out are not compared,
+            // and intersect, since ApplyFilter overwrites the bits it visits
+            PixelsBitMask columnMask(*filterMask);
+            PixelsFilter::ApplyFilter(columnVectors.at(i), *filterStat.filter, columnMask,
                                       resultSchema->getChildren().at(i));
+            filterMask->And(columnMask);
+            auto endTime = std::chrono::steady_clock::now();
+            filterStat.inputRows += inputRows;
+            filterStat.passedRows += filterMask->count();
+            filterStat.costNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    endTime - startTime).count();
+        }
+        if (++filterColumnStats->batchNum % filterRankInterval == 0)
+        {
+            rankFilterColumns();
         }
     }
 
+    // late materialization: if no row in this batch survives the filters,
+    // the payload columns are skipped instead of decoded
+    bool selectNone = filterMask != nullptr && filter != nullptr && filterMask->isNone();
     // read vectors
     for (int i = 0; i < resultColumns.size(); i++)
     {
-        // TODO: Refer to Issue #564. Disable data skipping
-        //if(filterMask != nullptr) {
-        //    if(filterMask->isNone()) {
-        //        break;
-        //    }
-        //}
         // Skip the columns that calculate the filter mask, since they are already processed
         int index = curChunkBufferIndex.at(i);
         if (std::find(filterColumnIndex.begin(), filterColumnIndex.end(), index) != filterColumnIndex.end())
@@ -271,6 +325,12 @@ std::shared_ptr <VectorizedRowBatch> PixelsRecordReaderImpl::readBatch(bool reus
         }
         auto &encoding = curEncoding.at(i);
         auto &chunkIndex = curChunkIndex.at(i);
+        if (selectNone)
+        {
+            readers.at(i)->skip(chunkBuffers.at(index), *encoding, curRowInRG, curBatchSize,
+                                postScript.pixelstride(), *chunkIndex);
+            continue;
+        }
         readers.at(i)->read(chunkBuffers.at(index), *encoding, curRowInRG, curBatchSize,
                             postScript.pixelstride(), resultRowBatch->rowCount,
                             columnVectors.at(i), *chunkIndex, filterMask);
@@ -306,11 +366,23 @@ void PixelsRecordReaderImpl::prepareRead()
     includedRGs.resize(RGLen);
 
     uint64_t includedRowNum = 0;
+    prunedRGNum = 0;
     // read row group statistics and find target row groups
     for (int i = 0; i < RGLen; i++)
     {
-        includedRGs.at(i) = true;
-        includedRowNum += footer.rowgroupinfos(RGStart + i).numberofrows();
+        includedRGs.at(i) = checkRowGroupStatistic(RGStart + i);
+        if (includedRGs.at(i))
+        {
+            includedRowNum += footer.rowgroupinfos(RGStart + i).numberofrows();
+        }
+        else
+        {
+            prunedRGNum++;
+        }
+    }
+    if (prunedRGNum > 0)
+    {
+        ::CountProfiler::Instance().Count("pruned row groups", prunedRGNum);
     }
     targetRGs.clear();
     targetRGs.resize(RGLen);
@@ -325,13 +397,16 @@ void PixelsRecordReaderImpl::prepareRead()
     }
     targetRGNum = targetRGIdx;
 
-    // TODO: if taregetRGNum == 0
+    if (targetRGNum == 0)
+    {
+        // all row groups are pruned, there is nothing to read from this file
+        endOfFile = true;
+        return;
+    }
 
     // read row group footers
     rowGroupFooters.clear();
     rowGroupFooters.resize(targetRGNum);
-    std::vector<bool> rowGroupFooterCacheHit;
-    rowGroupFooterCacheHit.resize(targetRGNum);
 
     /**
      * Issue #114:
@@ -342,17 +417,32 @@ void PixelsRecordReaderImpl::prepareRead()
      */
     RequestBatch requestBatch;
     std::vector<int> fis;
-    std::vector <std::string> rgCacheIds;
+    std::shared_ptr <PixelsFooterIndex> footerIndex;
+    if (footerCache != nullptr || PixelsFooterIndex::isEnabled() || chunkCache != nullptr)
+    {
+        fileVersion = PixelsFooterCache::getFileVersion(filePath);
+    }
+    if (PixelsFooterIndex::isEnabled())
+    {
+        footerIndex = PixelsFooterIndex::openForFile(filePath);
+    }
     for (int i = 0; i < targetRGNum; i++)
     {
         int rgId = targetRGs[i];
-        std::string rgCacheId = fileName + "-" + std::to_string(rgId);
-        rgCacheIds.emplace_back(rgCacheId);
-        if (footerCache != nullptr && footerCache->containsRGFooter(rgCacheId))
+        std::shared_ptr <pixels::proto::RowGroupFooter> cached =
+                footerCache != nullptr ? footerCache->getRGFooter(filePath, fileVersion, rgId) : nullptr;
+        if (cached == nullptr && footerIndex != nullptr)
+        {
+            cached = footerIndex->getRGFooter(filePath, fileVersion, rgId);
+            if (cached != nullptr && footerCache != nullptr)
+            {
+                footerCache->putRGFooter(filePath, fileVersion, rgId, cached);
+            }
+        }
+        if (cached != nullptr)
         {
             // cache hit
-            rowGroupFooters.at(i) = footerCache->getRGFooter(rgCacheId);
-            rowGroupFooterCacheHit.at(i) = true;
+            rowGroupFooters.at(i) = cached;
         }
         else
         {
@@ -362,24 +452,21 @@ void PixelsRecordReaderImpl::prepareRead()
             uint64_t footerLength = rowGroupInformation.footerlength();
             fis.push_back(i);
             requestBatch.add(queryId, (int) footerOffset, (int) footerLength,ringIndex);
-            rowGroupFooterCacheHit.at(i) = false;
         }
     }
     Scheduler *scheduler = SchedulerFactory::Instance()->getScheduler();
     auto bbs = scheduler->executeBatch(physicalReader, requestBatch, queryId);
     // TODO: the return value should be unique_ptr?
 
+    // the i-th buffer is the footer of the i-th missed row group
     for (int i = 0; i < bbs.size(); i++)
     {
-        if (!rowGroupFooterCacheHit.at(i))
+        auto parsed = std::make_shared<pixels::proto::RowGroupFooter>();
+        parsed->ParseFromArray(bbs[i]->getPointer(), (int) bbs[i]->size());
+        rowGroupFooters.at(fis[i]) = parsed;
+        if (footerCache != nullptr)
         {
-            auto parsed = std::make_shared<pixels::proto::RowGroupFooter>();
-            parsed->ParseFromArray(bbs[i]->getPointer(), (int) bbs[i]->size());
-            rowGroupFooters.at(fis[i]) = parsed;
-            if (footerCache != nullptr)
-            {
-                footerCache->putRGFooter(rgCacheIds[fis[i]], parsed);
-            }
+            footerCache->putRGFooter(filePath, fileVersion, targetRGs[fis[i]], parsed);
         }
     }
 
@@ -393,17 +480,230 @@ void PixelsRecordReaderImpl::prepareRead()
     UpdateRowGroupInfo();
 }
 
+bool PixelsRecordReaderImpl::checkRowGroupStatistic(int rgId)
+{
+    if (filter == nullptr || rgId >= footer.rowgroupstats_size())
+    {
+        return true;
+    }
+    const pixels::proto::RowGroupStatistic &rowGroupStatistic = footer.rowgroupstats(rgId);
+    for (auto &filterCol: filter->filters)
+    {
+        int i = filterCol.first;
+        int colId = resultColumns.at(i);
+        if (colId >= rowGroupStatistic.columnchunkstats_size())
+        {
+            continue;
+        }
+        if (!PixelsFilter::CheckStatistic(*filterCol.second, rowGroupStatistic.columnchunkstats(colId),
+                                          resultSchema->getChildren().at(i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int PixelsRecordReaderImpl::getPrunedRGNum() const
+{
+    return prunedRGNum;
+}
+
+std::vector<bool> PixelsRecordReaderImpl::getSurvivingPixels()
+{
+    std::vector<bool> survivingPixels;
+    if (filter == nullptr || filter->filters.empty())
+    {
+        return survivingPixels;
+    }
+    int pixelStride = (int) postScript.pixelstride();
+    int pixelNum = (curRGRowCount + pixelStride - 1) / pixelStride;
+    survivingPixels.resize(pixelNum);
+    bool allSurvive = true;
+    for (int pixelId = 0; pixelId < pixelNum; pixelId++)
+    {
+        survivingPixels.at(pixelId) = checkPixelStatistic(pixelId);
+        allSurvive = allSurvive && survivingPixels.at(pixelId);
+    }
+    if (allSurvive)
+    {
+        survivingPixels.clear();
+    }
+    return survivingPixels;
+}
+
+bool PixelsRecordReaderImpl::isPixelAddressable(const std::shared_ptr <TypeDescription> &type)
+{
+    switch (type->getCategory())
+    {
+        case TypeDescription::BOOLEAN:
+        case TypeDescription::BYTE:
+        case TypeDescription::SHORT:
+        case TypeDescription::INT:
+        case TypeDescription::LONG:
+        case TypeDescription::DATE:
+        case TypeDescription::TIMESTAMP:
+        case TypeDescription::FLOAT:
+        case TypeDescription::DOUBLE:
+        case TypeDescription::DECIMAL:
+            return true;
+        default:
+            // strings need the dictionary or the starts array of the whole chunk
+            return false;
+    }
+}
+
+bool PixelsRecordReaderImpl::planChunkRanges(const pixels::proto::ColumnChunkIndex &chunkIndex,
+                                             const std::vector<bool> &survivingPixels, int coalesceGap,
+                                             std::vector <ChunkRange> &ranges)
+{
+    ranges.clear();
+    int pixelNum = chunkIndex.pixelpositions_size();
+    if (pixelNum != survivingPixels.size())
+    {
+        // read the whole chunk if the pixel positions are not as expected
+        return false;
+    }
+    auto addRange = [&ranges, coalesceGap](uint32_t start, uint32_t end)
+    {
+        if (start >= end)
+        {
+            return;
+        }
+        if (!ranges.empty() && start <= ranges.back().end + coalesceGap)
+        {
+            ranges.back().end = std::max(ranges.back().end, end);
+        }
+        else
+        {
+            ranges.emplace_back(start, end);
+        }
+    };
+    for (int pixelId = 0; pixelId < pixelNum; pixelId++)
+    {
+        if (survivingPixels.at(pixelId))
+        {
+            uint32_t end = pixelId + 1 < pixelNum ? chunkIndex.pixelpositions(pixelId + 1)
+                                                  : chunkIndex.isnulloffset();
+            addRange(chunkIndex.pixelpositions(pixelId), end);
+        }
+    }
+    // the isNull bitmaps of the surviving pixels are stored at the end of the chunk
+    if (!ranges.empty())
+    {
+        addRange(chunkIndex.isnulloffset(), chunkIndex.chunklength());
+    }
+    if (ranges.size() == 1 && ranges.front().start == 0 && ranges.front().end >= chunkIndex.chunklength())
+    {
+        // nothing to save, read the whole chunk
+        ranges.clear();
+        return false;
+    }
+    return true;
+}
+
+bool PixelsRecordReaderImpl::checkPixelStatistic(int pixelId)
+{
+    for (auto &filterCol: filter->filters)
+    {
+        int i = filterCol.first;
+        auto &chunkIndex = curChunkIndex.at(i);
+        if (pixelId >= chunkIndex->pixelstatistics_size())
+        {
+            continue;
+        }
+        if (!PixelsFilter::CheckStatistic(*filterCol.second, chunkIndex->pixelstatistics(pixelId).statistic(),
+                                          resultSchema->getChildren().at(i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PixelsRecordReaderImpl::rankFilterColumns()
+{
+    auto &stats = filterColumnStats->stats;
+    std::stable_sort(stats.begin(), stats.end(),
+                     [](const FilterColumnStat &a, const FilterColumnStat &b)
+                     {
+                         return a.rank() < b.rank();
+                     });
+    for (auto &filterStat: stats)
+    {
+        // halve the history, so that the recent batches weigh more
+        filterStat.inputRows /= 2;
+        filterStat.passedRows /= 2;
+        filterStat.costNanos /= 2;
+    }
+}
+
+void PixelsRecordReaderImpl::skipPixels()
+{
+    int pixelStride = (int) postScript.pixelstride();
+    int skippedPixelNum = 0;
+    // the statistics are kept per pixel, so if the pixel containing curRowInRG cannot match
+    // the filter, the rows from curRowInRG up to the next pixel boundary are skipped. This also
+    // works for batches that do not start at a pixel boundary.
+    while (!checkPixelStatistic(curRowInRG / pixelStride))
+    {
+        if (asyncReadRequestNum > 0)
+        {
+            asyncReadComplete(asyncReadRequestNum);
+        }
+        int nextBoundary = (curRowInRG / pixelStride + 1) * pixelStride;
+        int skipSize = std::min(nextBoundary, curRGRowCount) - curRowInRG;
+        for (int i = 0; i < resultColumns.size(); i++)
+        {
+            int index = curChunkBufferIndex.at(i);
+            readers.at(i)->skip(chunkBuffers.at(index), *curEncoding.at(i), curRowInRG, skipSize,
+                                pixelStride, *curChunkIndex.at(i));
+        }
+        curRowInRG += skipSize;
+        skippedPixelNum++;
+        if (curRowInRG >= curRGRowCount)
+        {
+            curRowInRG = 0;
+            curRGIdx++;
+            if (curRGIdx >= targetRGNum)
+            {
+                endOfFile = true;
+                break;
+            }
+            UpdateRowGroupInfo();
+            if (!read())
+            {
+                throw std::runtime_error("failed to read file");
+            }
+        }
+    }
+    if (skippedPixelNum > 0)
+    {
+        prunedPixelNum += skippedPixelNum;
+        ::CountProfiler::Instance().Count("pruned pixels", skippedPixelNum);
+    }
+}
+
+int PixelsRecordReaderImpl::getPrunedPixelNum() const
+{
+    return prunedPixelNum;
+}
+
 void PixelsRecordReaderImpl::asyncReadComplete(int requestSize)
 {
     if (ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io")
-        && asyncReadRequestNum >= requestSize)
+        && asyncReadRequestNum > 0)
     {
         if (ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring")
         {
             auto localReader = std::static_pointer_cast<PhysicalLocalReader>(physicalReader);
             auto ringIndexCountMap=localReader->getRingIndexCountMap();
             localReader->readAsyncComplete(ringIndexCountMap,localReader->getRingIndexes());
-            asyncReadRequestNum -= requestSize;
+            // all the submitted requests are reaped at once, a chunk may have issued several of them
+            asyncReadRequestNum = 0;
+            // the chunks are cached compressed
+            cacheReadChunks();
+            decompressChunks();
         }
         else if (ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio")
         {
@@ -415,12 +715,44 @@ void PixelsRecordReaderImpl::asyncReadComplete(int requestSize)
 }
 
 
+void PixelsRecordReaderImpl::decompressChunks()
+{
+    if (compressionCodec == nullptr)
+    {
+        return;
+    }
+    for (int index = 0; index < compressedChunks.size(); index++)
+    {
+        if (!compressedChunks.at(index))
+        {
+            continue;
+        }
+        auto &chunkBuffer = chunkBuffers.at(index);
+        uint64_t rawLength = CompressionCodec::getRawChunkLength(chunkBuffer->getPointer(), chunkBuffer->size());
+        auto &rawBuffer = decompressedBuffers[decompressedBufferIdx].at(index);
+        if (rawBuffer == nullptr || rawBuffer->size() < rawLength)
+        {
+            // give the smaller buffer back to the arena before taking a larger one
+            rawBuffer = nullptr;
+            rawBuffer = BufferPoolArena::Instance()->allocate(rawLength);
+        }
+        compressionCodec->decompressChunk(chunkBuffer->getPointer(), chunkBuffer->size(), rawBuffer->getPointer());
+        chunkBuffer = std::make_shared<ByteBuffer>(*rawBuffer, 0, rawLength);
+        compressedChunks.at(index) = false;
+    }
+}
+
 std::shared_ptr <PixelsBitMask> PixelsRecordReaderImpl::getFilterMask()
 {
     return filterMask;
 }
 
 bool PixelsRecordReaderImpl::read()
+{
+    return read(true);
+}
+
+bool PixelsRecordReaderImpl::read(bool mayWait)
 {
     if (!everPrepareRead)
     {
@@ -429,17 +761,27 @@ bool PixelsRecordReaderImpl::read()
 
     everRead = true;
 
+    if (curRGIdx >= targetRGNum)
+    {
+        // no row group left to read, e.g., all the row groups are pruned by statistics
+        return true;
+    }
+
     // read chunk offset and length of each target column chunks
 
     // TODO: this should remove later
     chunkBuffers.clear();
     chunkBuffers.resize(includedColumns.size());
+    chunksToCache.clear();
+    compressedChunks.assign(includedColumns.size(), false);
+    decompressedBufferIdx = 1 - decompressedBufferIdx;
+    decompressedBuffers[decompressedBufferIdx].resize(includedColumns.size());
     std::vector <ChunkId> diskChunks;
     diskChunks.reserve(targetColumns.size());
 
 
-    // TODO: support cache read
-
+    // the chunks in the chunk cache are not read from the disk
+    int cachedChunkNum = 0;
     const pixels::proto::RowGroupIndex &rowGroupIndex =
             rowGroupFooters[curRGIdx]->rowgroupindexentry();
     for (int colId: targetColumns)
@@ -450,13 +792,49 @@ bool PixelsRecordReaderImpl::read()
         {
             throw InvalidArgumentException("Pixels C++ reader only supports little endianness. ");
         }
+        if (chunkCache != nullptr)
+        {
+            auto cached = chunkCache->get(filePath, fileVersion, targetRGs.at(curRGIdx), colId);
+            if (cached != nullptr)
+            {
+                chunkBuffers.at(colId) = cached;
+                compressedChunks.at(colId) = compressionCodec != nullptr;
+                cachedChunkNum++;
+                continue;
+            }
+        }
         ChunkId chunk(curRGIdx, colId, chunkIndex.chunkoffset(), chunkIndex.chunklength());
         diskChunks.emplace_back(chunk);
     }
+    if (cachedChunkNum > 0)
+    {
+        ::CountProfiler::Instance().Count("cached chunks", cachedChunkNum);
+    }
 
 
     if (!diskChunks.empty())
     {
+        // plan the byte ranges to read for the chunks in which some pixels can be skipped
+        std::vector<bool> survivingPixels = getSurvivingPixels();
+        std::vector<bool> partialChunks(diskChunks.size(), false);
+        std::vector <std::vector<ChunkRange>> chunkRanges(diskChunks.size());
+        // the pixel positions of a compressed chunk are offsets after decompression, and a batch
+        // that ends inside a pixel would decode the skipped part of the pixel with the next batch
+        if (!survivingPixels.empty() && compressionCodec == nullptr &&
+            postScript.pixelstride() > 0 && batchSize % postScript.pixelstride() == 0)
+        {
+            int coalesceGap = std::stoi(ConfigFactory::Instance().getProperty("pixel.read.coalesce.gap"));
+            for (int i = 0; i < diskChunks.size(); i++)
+            {
+                uint32_t colId = diskChunks.at(i).columnId;
+                if (isPixelAddressable(fileSchema->getChildren().at(colId)))
+                {
+                    partialChunks.at(i) = planChunkRanges(rowGroupIndex.columnchunkindexentries(colId),
+                                                          survivingPixels, coalesceGap, chunkRanges.at(i));
+                }
+            }
+        }
+
         // std::lock_guard<std::mutex> lock(mutex_);
         RequestBatch requestBatch((int) diskChunks.size());
         Scheduler *scheduler = SchedulerFactory::Instance()->getScheduler();
@@ -465,65 +843,177 @@ bool PixelsRecordReaderImpl::read()
         for (int i = 0; i < diskChunks.size(); i++)
         {
             ChunkId chunk = diskChunks.at(i);
-            requestBatch.add(queryId, chunk.offset, (int) chunk.length, ::BufferPool::GetBufferId());
             colIds.emplace_back(chunk.columnId);
             bytes.emplace_back(chunk.length);
         }
 
+        if (poolBufferId >= 0)
+        {
+            ::BufferPool::Switch(poolBufferId);
+        }
         std::thread::id thread_id=std::this_thread::get_id();
         auto columnNames=fileSchema->getFieldNames();
-        ::BufferPool::Initialize(colIds, bytes, columnNames);
+        if (!::BufferPool::Initialize(colIds, bytes, columnNames, mayWait))
+        {
+            // the memory budget is used up, the row group is read later, maybe into another buffer
+            decompressedBufferIdx = 1 - decompressedBufferIdx;
+            return false;
+        }
+        poolBufferId = (int) ::BufferPool::GetBufferId();
         ::DirectUringRandomAccessFile::RegisterBufferFromPool(colIds);
+        bool enableDirect = ConfigFactory::Instance().boolCheckProperty("localfs.enable.direct.io");
+        long blockSize = std::stol(ConfigFactory::Instance().getProperty("localfs.block.size"));
+        auto alignOffset = [enableDirect, blockSize](uint64_t offset) -> uint64_t
+        {
+            return enableDirect ? offset / blockSize * blockSize : offset;
+        };
         std::vector <std::shared_ptr<ByteBuffer>> originalByteBuffers;
+        std::vector <std::shared_ptr<ByteBuffer>> chunkBaseBuffers;
+        // the chunk and the start offset in the chunk of each request
+        std::vector<int> requestChunks;
+        std::vector <uint32_t> requestStarts;
         std::vector<int> ring_col;
+        uint64_t skippedBytes = 0;
         for (int i = 0; i < colIds.size(); i++)
         {
             auto colId = colIds.at(i);
             auto byte=bytes.at(i);
+            ChunkId chunk = diskChunks.at(i);
             auto currentBufferEntry=::BufferPool::GetBuffer(colId,byte,columnNames[colId]);
-            originalByteBuffers.emplace_back(currentBufferEntry);
-            requestBatch.getRequest(i).ringIndex=::BufferPool::getRingIndex(colId);
-            if (currentBufferEntry->size()-requestBatch.getRequest(i).length<=4096) {
-                std::cout<<"i:"<<i<<" ringIndex:"<<requestBatch.getRequest(i).ringIndex<<
+            int ringIndex = ::BufferPool::getRingIndex(colId);
+            int64_t bufferId = ::BufferPool::getBufferIndex(colId);
+            if (currentBufferEntry->size()-byte<=4096) {
+                std::cout<<"i:"<<i<<" ringIndex:"<<ringIndex<<
                     " colId:"<<colId<<" byte:"<<byte<<" currentBuffer size"<<currentBufferEntry->size()<<
-                " requestBatch.length"<<requestBatch.getRequest(i).length<<
+                " requestBatch.length"<<byte<<
                     " columnNames:"<<columnNames[colId]<<std::endl;
                 throw InvalidArgumentException("PixelsRecordReaderImpl:read 临界区");
             }
 
-            if (requestBatch.getRequest(i).ringIndex !=0) {
-                requestBatch.getRequest(i).bufferId=0;
+            if (!partialChunks.at(i))
+            {
+                requestBatch.add(queryId, chunk.offset, (int) chunk.length, bufferId);
+                requestBatch.getRequest(requestBatch.getSize() - 1).ringIndex = ringIndex;
+                originalByteBuffers.emplace_back(currentBufferEntry);
+                requestChunks.emplace_back(i);
+                requestStarts.emplace_back(0);
+                chunkBaseBuffers.emplace_back(nullptr);
+            }
+            else
+            {
+                // each range is read into the buffer at the place it would take in a whole chunk read,
+                // so that the column readers can address the pixels by pixelPositions as usual
+                uint64_t chunkBase = chunk.offset - alignOffset(chunk.offset);
+                chunkBaseBuffers.emplace_back(std::make_shared<ByteBuffer>(
+                        *currentBufferEntry, chunkBase, chunk.length));
+                uint64_t rangeBytes = 0;
+                for (auto &range: chunkRanges.at(i))
+                {
+                    uint64_t sliceStart = alignOffset(chunk.offset + range.start) - alignOffset(chunk.offset);
+                    requestBatch.add(queryId, chunk.offset + range.start, range.end - range.start, bufferId);
+                    requestBatch.getRequest(requestBatch.getSize() - 1).ringIndex = ringIndex;
+                    originalByteBuffers.emplace_back(std::make_shared<ByteBuffer>(
+                            *currentBufferEntry, sliceStart, currentBufferEntry->size() - sliceStart));
+                    requestChunks.emplace_back(i);
+                    requestStarts.emplace_back(range.start);
+                    rangeBytes += range.end - range.start;
+                }
+                skippedBytes += chunk.length - rangeBytes;
+            }
+            if (ringIndex != 0) {
                 ring_col.emplace_back(i);
             }
         }
+        if (skippedBytes > 0)
+        {
+            ::CountProfiler::Instance().Count("skipped chunk bytes", (int) skippedBytes);
+        }
+        // only the whole chunks are cached, the chunks read in ranges lack the skipped pixels
+        if (chunkCache != nullptr)
+        {
+            chunksToCacheRGId = targetRGs.at(curRGIdx);
+            for (int i = 0; i < diskChunks.size(); i++)
+            {
+                if (!partialChunks.at(i))
+                {
+                    chunksToCache.emplace_back(diskChunks.at(i).columnId);
+                }
+            }
+        }
 
         // ::BufferPool::PrintStats();
 
-           auto byteBuffers = scheduler->executeBatch(
-            physicalReader, requestBatch, originalByteBuffers, queryId);
+        std::vector <std::shared_ptr<ByteBuffer>> byteBuffers;
+        if (requestBatch.getSize() > 0)
+        {
+            byteBuffers = scheduler->executeBatch(
+                    physicalReader, requestBatch, originalByteBuffers, queryId);
+        }
 
-        if(ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io")
-            && originalByteBuffers.size() > 0)
+        bool asyncRead = ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io")
+                         && originalByteBuffers.size() > 0;
+        if(asyncRead)
         {
-            asyncReadRequestNum += diskChunks.size();
+            asyncReadRequestNum += requestBatch.getSize();
         }
 
         for (int index = 0; index < diskChunks.size(); index++)
         {
-            ChunkId chunk = diskChunks.at(index);
+            if (chunkBaseBuffers.at(index) != nullptr)
+            {
+                chunkBuffers.at(diskChunks.at(index).columnId) = chunkBaseBuffers.at(index);
+            }
+        }
+        for (int index = 0; index < byteBuffers.size(); index++)
+        {
             std::shared_ptr <ByteBuffer> bb = byteBuffers.at(index);
-            uint32_t colId = chunk.columnId;
-
-            if (bb != nullptr)
+            int chunkIdx = requestChunks.at(index);
+            uint32_t colId = diskChunks.at(chunkIdx).columnId;
+            auto &base = chunkBaseBuffers.at(chunkIdx);
+            if (base == nullptr)
             {
-                chunkBuffers.at(colId) = bb;
+                if (bb != nullptr)
+                {
+                    chunkBuffers.at(colId) = bb;
+                }
+            }
+            else if (!asyncRead && bb != nullptr && bb->getPointer() != base->getPointer() + requestStarts.at(index))
+            {
+                // the scheduler did not read into the given buffer, move the range to its place
+                memcpy(base->getPointer() + requestStarts.at(index), bb->getPointer(), bb->size());
             }
         }
+        if (compressionCodec != nullptr)
+        {
+            for (auto &chunk: diskChunks)
+            {
+                compressedChunks.at(chunk.columnId) = true;
+            }
+        }
+        if (!asyncRead)
+        {
+            cacheReadChunks();
+        }
+    }
+    // the chunks not waiting for asynchronous reads, including those in the chunk cache,
+    // are decompressed now, the others once asyncReadComplete reaps their reads
+    if (asyncReadRequestNum == 0)
+    {
+        decompressChunks();
     }
     return true;
 
 }
 
+void PixelsRecordReaderImpl::cacheReadChunks()
+{
+    for (uint32_t colId: chunksToCache)
+    {
+        chunkCache->put(filePath, fileVersion, chunksToCacheRGId, colId, chunkBuffers.at(colId));
+    }
+    chunksToCache.clear();
+}
+
 PixelsRecordReaderImpl::~PixelsRecordReaderImpl()
 {
     // TODO: chunkBuffers, physicalReader should be deleted?
@@ -24,6 +24,7 @@
  */
 #include "reader/StringColumnReader.h"
 #include "profiler/CountProfiler.h"
+#include "utils/ConfigFactory.h"
 
 StringColumnReader::StringColumnReader(std::shared_ptr <TypeDescription> type) : ColumnReader(type)
 {
@@ -39,6 +40,8 @@ StringColumnReader::StringColumnReader(std::shared_ptr <TypeDescription> type) :
     dictStartsOffset = 0;
     dictStarts = nullptr;
     startsLength = 0;
+    dictionaryVector = ConfigFactory::Instance().boolCheckProperty("pixel.read.dictionary.vector");
+    dictEntriesRenewed = false;
 }
 
 void StringColumnReader::close()
@@ -76,6 +79,13 @@ void StringColumnReader::read(std::shared_ptr <ByteBuffer> input, pixels::proto:
             cascadeRLE = true;
         }
 
+        if (dictionaryVector)
+        {
+            readDictionaryIds(columnVector, size, vectorIndex, cascadeRLE);
+            elementIndex += size;
+            return;
+        }
+        columnVector->setDictionary(nullptr, nullptr, 0);
         for (int i = 0; i < size; i++)
         {
             bool valid = vector->checkValid(i);
@@ -113,41 +123,99 @@ void StringColumnReader::read(std::shared_ptr <ByteBuffer> input, pixels::proto:
     }
     else
     {
-        for (int i = 0; i < size; i++)
+        columnVector->setDictionary(nullptr, nullptr, 0);
+        for (int i = 0; i < size;)
         {
-            if (elementIndex % pixelStride == 0)
-            {
-                int pixelId = elementIndex / pixelStride;
-                // TODO: should write the remaining code
-            }
-            bool valid = vector->checkValid(i);
-            if (valid && (filterMask == nullptr || filterMask->get(i)))
+            if (vector->checkValid(i) && (filterMask == nullptr || filterMask->get(i)))
             {
                 currentStart = nextStart;
                 nextStart = startsBuf->getInt();
-                int len = nextStart - currentStart;
                 // use setRef instead of setVal to reduce memory copy
                 columnVector->setRef(
-                        i + vectorIndex, contentBuf->getPointer(), bufferOffset, len);
-                bufferOffset += len;
+                        i + vectorIndex, contentBuf->getPointer(), currentStart, nextStart - currentStart);
+                i++;
+                continue;
             }
-            else if (!valid)
+            // step over the run of null or filtered out rows, only the start of the row after it is needed
+            int runEnd = i + 1;
+            while (runEnd < size && !(vector->checkValid(runEnd) && (filterMask == nullptr || filterMask->get(runEnd))))
             {
-                // is null: skip this number
-                currentStart = nextStart;
-                nextStart = startsBuf->getInt();
+                runEnd++;
             }
-            else
+            startsBuf->skipBytes((runEnd - i - 1) * sizeof(int));
+            currentStart = nextStart;
+            nextStart = startsBuf->getInt();
+            i = runEnd;
+        }
+        bufferOffset = nextStart;
+        elementIndex += size;
+    }
+}
+
+void StringColumnReader::readDictionaryIds(std::shared_ptr <BinaryColumnVector> columnVector, int size,
+                                           int vectorIndex, bool cascadeRLE)
+{
+    columnVector->setDictionary(dictEntries.data(), dictEntriesValid.data(), (int) dictEntries.size(),
+                                dictEntriesRenewed);
+    dictEntriesRenewed = false;
+    uint32_t *ids = columnVector->dictIds + vectorIndex;
+    // each row has a dictionary id, including the null rows
+    if (cascadeRLE)
+    {
+        contentDecoder->next(reinterpret_cast<int32_t *>(ids), size);
+    }
+    else
+    {
+        for (int i = 0; i < size; i++)
+        {
+            ids[i] = contentBuf->getInt();
+        }
+    }
+    // the null rows reference the null entry at the end of the dictionary
+    uint32_t nullId = dictEntries.size() - 1;
+    for (int i = 0; i < size; i++)
+    {
+        if (!columnVector->checkValid(i))
+        {
+            ids[i] = nullId;
+        }
+    }
+}
+
+void StringColumnReader::skip(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                              int size, int pixelStride, pixels::proto::ColumnChunkIndex &chunkIndex)
+{
+    if (offset == 0)
+    {
+        bufferOffset = 0;
+        isNullOffset = chunkIndex.isnulloffset();
+        readContent(input, input->bytesRemaining(), encoding);
+    }
+    ColumnReader::skip(input, encoding, offset, size, pixelStride, chunkIndex);
+
+    if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_DICTIONARY)
+    {
+        if (contentDecoder != nullptr)
+        {
+            // the dictionary ids are run-length encoded through the whole chunk
+            for (int i = 0; i < size; i++)
             {
-                // filter out: skip this number
-                currentStart = nextStart;
-                nextStart = startsBuf->getInt();
-                int len = nextStart - currentStart;
-                bufferOffset += len;
+                contentDecoder->next();
             }
-            elementIndex++;
+        }
+        else
+        {
+            contentBuf->skipBytes(size * sizeof(int));
         }
     }
+    else
+    {
+        // each element has a start offset, null elements have empty content
+        startsBuf->skipBytes((size - 1) * sizeof(int));
+        currentStart = nextStart;
+        nextStart = startsBuf->getInt();
+        bufferOffset = nextStart;
+    }
 }
 
 void StringColumnReader::readContent(std::shared_ptr <ByteBuffer> input,
@@ -178,6 +246,7 @@ void StringColumnReader::readContent(std::shared_ptr <ByteBuffer> input,
             if (encoding.has_dictionarysize())
             {
                 startsLength = (int) encoding.dictionarysize() + 1;
+                delete[] dictStarts;
                 dictStarts = new int[startsLength];
                 int i = 0;
                 while (startsDecoder->hasNext())
@@ -204,6 +273,8 @@ void StringColumnReader::readContent(std::shared_ptr <ByteBuffer> input,
                 throw new InvalidArgumentException(
                         "the dictionary size is inconsistent with the size of the starts array");
             }
+            startsLength = startsSize;
+            delete[] dictStarts;
             dictStarts = new int[startsSize];
             for (int i = 0; i < startsSize; ++i)
             {
@@ -211,6 +282,21 @@ void StringColumnReader::readContent(std::shared_ptr <ByteBuffer> input,
             }
             contentDecoder = nullptr;
         }
+        if (dictionaryVector)
+        {
+            // materialize the dictionary once per chunk, the batches only carry the ids
+            int dictSize = startsLength - 1;
+            dictEntries.resize(dictSize + 1);
+            for (int i = 0; i < dictSize; i++)
+            {
+                dictEntries[i] = duckdb::string_t((char *) dictContentBuf->getPointer() + dictStarts[i],
+                                                  dictStarts[i + 1] - dictStarts[i]);
+            }
+            dictEntries[dictSize] = duckdb::string_t((uint32_t) 0);
+            dictEntriesValid.assign((dictSize + 1 + 63) / 64, ~0UL);
+            dictEntriesValid[dictSize / 64] &= ~(1UL << (dictSize % 64));
+            dictEntriesRenewed = true;
+        }
     }
     else
     {
@@ -56,15 +56,30 @@ TimestampColumnReader::read(std::shared_ptr <ByteBuffer> input, pixels::proto::C
 
     if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH)
     {
-        for (int i = 0; i < size; i++)
+        for (int i = 0; i < size;)
         {
-            if (elementIndex % pixelStride == 0)
+            // decode the selected rows in bulk and skip the rows filtered out
+            bool selected = filterMask == nullptr || filterMask->get(i);
+            int runEnd = filterMask == nullptr ? size : i + 1;
+            while (runEnd < size && (bool) filterMask->get(runEnd) == selected)
             {
-                int pixelId = elementIndex / pixelStride;
+                runEnd++;
             }
-            columnVector->set(i + vectorIndex, decoder->next());
-            elementIndex++;
+            if (selected)
+            {
+                decoder->next(columnVector->times + vectorIndex + i, runEnd - i);
+            }
+            else
+            {
+                decoder->skip(runEnd - i);
+            }
+            i = runEnd;
         }
+        if (columnVector->writeIndex < vectorIndex + size)
+        {
+            columnVector->writeIndex = vectorIndex + size;
+        }
+        elementIndex += size;
     }
     else
     {
@@ -72,3 +87,36 @@ TimestampColumnReader::read(std::shared_ptr <ByteBuffer> input, pixels::proto::C
         input->setReadPos(input->getReadPos() + size * sizeof(int64_t));
     }
 }
+
+void TimestampColumnReader::skip(std::shared_ptr <ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                                 int size, int pixelStride, pixels::proto::ColumnChunkIndex &chunkIndex)
+{
+    if (offset == 0)
+    {
+        decoder = std::make_shared<RunLenIntDecoder>(input, true);
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+    ColumnReader::skip(input, encoding, offset, size, pixelStride, chunkIndex);
+
+    if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH)
+    {
+        if ((offset + size) % pixelStride == 0)
+        {
+            // each pixel is encoded separately, so restart the decoder at the next pixel
+            int nextPixelId = (offset + size) / pixelStride;
+            if (nextPixelId < chunkIndex.pixelpositions_size())
+            {
+                input->setReadPos(chunkIndex.pixelpositions(nextPixelId));
+            }
+            decoder = std::make_shared<RunLenIntDecoder>(input, true);
+        }
+        else
+        {
+            decoder->skip(size);
+        }
+    }
+    else
+    {
+        input->setReadPos(input->getReadPos() + size * sizeof(int64_t));
+    }
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "stats/DateStatsRecorder.h"
+#include <stdexcept>
+
+DateStatsRecorder::DateStatsRecorder() = default;
+
+DateStatsRecorder::DateStatsRecorder(const pixels::proto::ColumnStatistic &statistic)
+        : StatsRecorder(statistic)
+{
+    const auto &dateStat = statistic.datestatistics();
+    if (dateStat.has_minimum())
+    {
+        hasMin = true;
+        minimum = dateStat.minimum();
+    }
+    if (dateStat.has_maximum())
+    {
+        hasMax = true;
+        maximum = dateStat.maximum();
+    }
+}
+
+void DateStatsRecorder::updateDate(int value)
+{
+    numberOfValues++;
+    if (!hasMin || value < minimum)
+    {
+        hasMin = true;
+        minimum = value;
+    }
+    if (!hasMax || value > maximum)
+    {
+        hasMax = true;
+        maximum = value;
+    }
+}
+
+void DateStatsRecorder::updateDate(const int *values, const uint8_t *isNull, int length)
+{
+    numberOfValues += length;
+    int localMin = INT_MAX;
+    int localMax = INT_MIN;
+    int nonNulls = 0;
+    for (int i = 0; i < length; i++)
+    {
+        if (isNull != nullptr && isNull[i])
+        {
+            continue;
+        }
+        localMin = values[i] < localMin ? values[i] : localMin;
+        localMax = values[i] > localMax ? values[i] : localMax;
+        nonNulls++;
+    }
+    if (nonNulls == 0)
+    {
+        return;
+    }
+    if (!hasMin || localMin < minimum)
+    {
+        hasMin = true;
+        minimum = localMin;
+    }
+    if (!hasMax || localMax > maximum)
+    {
+        hasMax = true;
+        maximum = localMax;
+    }
+}
+
+void DateStatsRecorder::merge(const StatsRecorder &other)
+{
+    auto dateStat = dynamic_cast<const DateStatsRecorder *>(&other);
+    if (dateStat != nullptr)
+    {
+        if (dateStat->hasMin && (!hasMin || dateStat->minimum < minimum))
+        {
+            hasMin = true;
+            minimum = dateStat->minimum;
+        }
+        if (dateStat->hasMax && (!hasMax || dateStat->maximum > maximum))
+        {
+            hasMax = true;
+            maximum = dateStat->maximum;
+        }
+    }
+    else if (isStatsExists() && hasMin)
+    {
+        throw std::invalid_argument("Incompatible merging of date column statistics");
+    }
+    StatsRecorder::merge(other);
+}
+
+void DateStatsRecorder::reset()
+{
+    StatsRecorder::reset();
+    minimum = INT_MAX;
+    maximum = INT_MIN;
+    hasMin = false;
+    hasMax = false;
+}
+
+pixels::proto::ColumnStatistic DateStatsRecorder::serialize() const
+{
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    auto dateStat = statistic.mutable_datestatistics();
+    if (hasMin)
+    {
+        dateStat->set_minimum(minimum);
+    }
+    if (hasMax)
+    {
+        dateStat->set_maximum(maximum);
+    }
+    return statistic;
+}
+
+int DateStatsRecorder::getMinimum() const
+{ return minimum; }
+
+int DateStatsRecorder::getMaximum() const
+{ return maximum; }
+
+bool DateStatsRecorder::hasMinimum() const
+{ return hasMin; }
+
+bool DateStatsRecorder::hasMaximum() const
+{ return hasMax; }
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "stats/DoubleStatsRecorder.h"
+#include <stdexcept>
+
+DoubleStatsRecorder::DoubleStatsRecorder() = default;
+
+DoubleStatsRecorder::DoubleStatsRecorder(const pixels::proto::ColumnStatistic &statistic)
+        : StatsRecorder(statistic)
+{
+    const auto &doubleStat = statistic.doublestatistics();
+    if (doubleStat.has_minimum())
+    {
+        hasMin = true;
+        minimum = doubleStat.minimum();
+    }
+    if (doubleStat.has_maximum())
+    {
+        hasMax = true;
+        maximum = doubleStat.maximum();
+    }
+    if (doubleStat.has_sum())
+    {
+        sum = doubleStat.sum();
+    }
+}
+
+void DoubleStatsRecorder::updateFloat(float value)
+{
+    updateDouble(value);
+}
+
+void DoubleStatsRecorder::updateDouble(double value)
+{
+    numberOfValues++;
+    if (!hasMin || value < minimum)
+    {
+        hasMin = true;
+        minimum = value;
+    }
+    if (!hasMax || value > maximum)
+    {
+        hasMax = true;
+        maximum = value;
+    }
+    sum += value;
+}
+
+void DoubleStatsRecorder::updateDouble(const double *values, const uint8_t *isNull, int length)
+{
+    numberOfValues += length;
+    for (int i = 0; i < length; i++)
+    {
+        if (isNull != nullptr && isNull[i])
+        {
+            continue;
+        }
+        double value = values[i];
+        if (!hasMin || value < minimum)
+        {
+            hasMin = true;
+            minimum = value;
+        }
+        if (!hasMax || value > maximum)
+        {
+            hasMax = true;
+            maximum = value;
+        }
+        sum += value;
+    }
+}
+
+void DoubleStatsRecorder::merge(const StatsRecorder &other)
+{
+    auto doubleStat = dynamic_cast<const DoubleStatsRecorder *>(&other);
+    if (doubleStat != nullptr)
+    {
+        if (doubleStat->hasMin && (!hasMin || doubleStat->minimum < minimum))
+        {
+            hasMin = true;
+            minimum = doubleStat->minimum;
+        }
+        if (doubleStat->hasMax && (!hasMax || doubleStat->maximum > maximum))
+        {
+            hasMax = true;
+            maximum = doubleStat->maximum;
+        }
+        sum += doubleStat->sum;
+    }
+    else if (isStatsExists() && hasMin)
+    {
+        throw std::invalid_argument("Incompatible merging of double column statistics");
+    }
+    StatsRecorder::merge(other);
+}
+
+void DoubleStatsRecorder::reset()
+{
+    StatsRecorder::reset();
+    minimum = 0;
+    maximum = 0;
+    sum = 0;
+    hasMin = false;
+    hasMax = false;
+}
+
+pixels::proto::ColumnStatistic DoubleStatsRecorder::serialize() const
+{
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    auto doubleStat = statistic.mutable_doublestatistics();
+    if (hasMin)
+    {
+        doubleStat->set_minimum(minimum);
+    }
+    if (hasMax)
+    {
+        doubleStat->set_maximum(maximum);
+    }
+    doubleStat->set_sum(sum);
+    return statistic;
+}
+
+double DoubleStatsRecorder::getMinimum() const
+{ return minimum; }
+
+double DoubleStatsRecorder::getMaximum() const
+{ return maximum; }
+
+bool DoubleStatsRecorder::hasMinimum() const
+{ return hasMin; }
+
+bool DoubleStatsRecorder::hasMaximum() const
+{ return hasMax; }
+
+double DoubleStatsRecorder::getSum() const
+{ return sum; }
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "stats/Integer128StatsRecorder.h"
+#include <stdexcept>
+
+Integer128StatsRecorder::Integer128StatsRecorder() = default;
+
+Integer128StatsRecorder::Integer128StatsRecorder(const pixels::proto::ColumnStatistic &statistic)
+        : StatsRecorder(statistic)
+{
+    const auto &int128Stat = statistic.int128statistics();
+    if (int128Stat.has_minimum_low())
+    {
+        hasMin = true;
+        long low = (long) int128Stat.minimum_low();
+        // the high bits are omitted if the value fits in 64 bits
+        long high = int128Stat.has_minimum_high() ? (long) int128Stat.minimum_high() : low >> 63;
+        minimum = toInt128(high, low);
+    }
+    if (int128Stat.has_maximum_low())
+    {
+        hasMax = true;
+        long low = (long) int128Stat.maximum_low();
+        long high = int128Stat.has_maximum_high() ? (long) int128Stat.maximum_high() : low >> 63;
+        maximum = toInt128(high, low);
+    }
+}
+
+__int128 Integer128StatsRecorder::toInt128(long high, long low)
+{
+    return (__int128) (((unsigned __int128) (uint64_t) high << 64) | (uint64_t) low);
+}
+
+void Integer128StatsRecorder::updateInteger128(long high, long low, int repetitions)
+{
+    numberOfValues += repetitions;
+    __int128 value = toInt128(high, low);
+    if (!hasMin || value < minimum)
+    {
+        hasMin = true;
+        minimum = value;
+    }
+    if (!hasMax || value > maximum)
+    {
+        hasMax = true;
+        maximum = value;
+    }
+}
+
+void Integer128StatsRecorder::updateInteger128(const long *values, const uint8_t *isNull, int length)
+{
+    numberOfValues += length;
+    for (int i = 0; i < length; i++)
+    {
+        if (isNull != nullptr && isNull[i])
+        {
+            continue;
+        }
+        __int128 value = toInt128(values[i << 1], values[(i << 1) + 1]);
+        if (!hasMin || value < minimum)
+        {
+            hasMin = true;
+            minimum = value;
+        }
+        if (!hasMax || value > maximum)
+        {
+            hasMax = true;
+            maximum = value;
+        }
+    }
+}
+
+void Integer128StatsRecorder::updateInteger(const long *values, const uint8_t *isNull, int length)
+{
+    numberOfValues += length;
+    for (int i = 0; i < length; i++)
+    {
+        if (isNull != nullptr && isNull[i])
+        {
+            continue;
+        }
+        __int128 value = values[i];
+        if (!hasMin || value < minimum)
+        {
+            hasMin = true;
+            minimum = value;
+        }
+        if (!hasMax || value > maximum)
+        {
+            hasMax = true;
+            maximum = value;
+        }
+    }
+}
+
+void Integer128StatsRecorder::merge(const StatsRecorder &other)
+{
+    auto int128Stat = dynamic_cast<const Integer128StatsRecorder *>(&other);
+    if (int128Stat != nullptr)
+    {
+        if (int128Stat->hasMin && (!hasMin || int128Stat->minimum < minimum))
+        {
+            hasMin = true;
+            minimum = int128Stat->minimum;
+        }
+        if (int128Stat->hasMax && (!hasMax || int128Stat->maximum > maximum))
+        {
+            hasMax = true;
+            maximum = int128Stat->maximum;
+        }
+    }
+    else if (isStatsExists() && hasMin)
+    {
+        throw std::invalid_argument("Incompatible merging of integer128 column statistics");
+    }
+    StatsRecorder::merge(other);
+}
+
+void Integer128StatsRecorder::reset()
+{
+    StatsRecorder::reset();
+    minimum = 0;
+    maximum = 0;
+    hasMin = false;
+    hasMax = false;
+}
+
+pixels::proto::ColumnStatistic Integer128StatsRecorder::serialize() const
+{
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    auto int128Stat = statistic.mutable_int128statistics();
+    if (hasMin)
+    {
+        int128Stat->set_minimum_high((long) (minimum >> 64));
+        int128Stat->set_minimum_low((long) minimum);
+    }
+    if (hasMax)
+    {
+        int128Stat->set_maximum_high((long) (maximum >> 64));
+        int128Stat->set_maximum_low((long) maximum);
+    }
+    return statistic;
+}
+
+__int128 Integer128StatsRecorder::getMinimum() const
+{ return minimum; }
+
+__int128 Integer128StatsRecorder::getMaximum() const
+{ return maximum; }
+
+bool Integer128StatsRecorder::hasMinimum() const
+{ return hasMin; }
+
+bool Integer128StatsRecorder::hasMaximum() const
+{ return hasMax; }
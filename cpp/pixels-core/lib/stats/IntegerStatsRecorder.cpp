@@ -0,0 +1,218 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "stats/IntegerStatsRecorder.h"
+#include <stdexcept>
+
+IntegerStatsRecorder::IntegerStatsRecorder() = default;
+
+IntegerStatsRecorder::IntegerStatsRecorder(const pixels::proto::ColumnStatistic &statistic)
+        : StatsRecorder(statistic)
+{
+    const auto &intStat = statistic.intstatistics();
+    if (intStat.has_minimum())
+    {
+        hasMin = true;
+        minimum = intStat.minimum();
+    }
+    if (intStat.has_maximum())
+    {
+        hasMax = true;
+        maximum = intStat.maximum();
+    }
+    if (intStat.has_sum())
+    {
+        sum = intStat.sum();
+    }
+    else
+    {
+        overflow = true;
+    }
+}
+
+void IntegerStatsRecorder::updateInteger(long value, int repetitions)
+{
+    numberOfValues += repetitions;
+    if (!hasMin || value < minimum)
+    {
+        hasMin = true;
+        minimum = value;
+    }
+    if (!hasMax || value > maximum)
+    {
+        hasMax = true;
+        maximum = value;
+    }
+    mergeSum((__int128) value * repetitions);
+}
+
+void IntegerStatsRecorder::updateInteger(const int *values, const uint8_t *isNull, int length)
+{
+    updateIntegers(values, isNull, length);
+}
+
+void IntegerStatsRecorder::updateInteger(const long *values, const uint8_t *isNull, int length)
+{
+    updateIntegers(values, isNull, length);
+}
+
+template<typename T>
+void IntegerStatsRecorder::updateIntegers(const T *values, const uint8_t *isNull, int length)
+{
+    numberOfValues += length;
+    // the local min/max/sum are kept in registers so that the null-free loop can be vectorized
+    long localMin = LONG_MAX;
+    long localMax = LONG_MIN;
+    __int128 localSum = 0;
+    int nonNulls = 0;
+    if (isNull == nullptr)
+    {
+        for (int i = 0; i < length; i++)
+        {
+            long value = values[i];
+            localMin = value < localMin ? value : localMin;
+            localMax = value > localMax ? value : localMax;
+            localSum += value;
+        }
+        nonNulls = length;
+    }
+    else
+    {
+        for (int i = 0; i < length; i++)
+        {
+            if (isNull[i])
+            {
+                continue;
+            }
+            long value = values[i];
+            localMin = value < localMin ? value : localMin;
+            localMax = value > localMax ? value : localMax;
+            localSum += value;
+            nonNulls++;
+        }
+    }
+    if (nonNulls == 0)
+    {
+        return;
+    }
+    if (!hasMin || localMin < minimum)
+    {
+        hasMin = true;
+        minimum = localMin;
+    }
+    if (!hasMax || localMax > maximum)
+    {
+        hasMax = true;
+        maximum = localMax;
+    }
+    mergeSum(localSum);
+}
+
+void IntegerStatsRecorder::mergeSum(__int128 delta)
+{
+    if (overflow)
+    {
+        return;
+    }
+    __int128 newSum = (__int128) sum + delta;
+    if (newSum > LONG_MAX || newSum < LONG_MIN)
+    {
+        overflow = true;
+        return;
+    }
+    sum = (long) newSum;
+}
+
+void IntegerStatsRecorder::merge(const StatsRecorder &other)
+{
+    auto intStat = dynamic_cast<const IntegerStatsRecorder *>(&other);
+    if (intStat != nullptr)
+    {
+        if (intStat->hasMin && (!hasMin || intStat->minimum < minimum))
+        {
+            hasMin = true;
+            minimum = intStat->minimum;
+        }
+        if (intStat->hasMax && (!hasMax || intStat->maximum > maximum))
+        {
+            hasMax = true;
+            maximum = intStat->maximum;
+        }
+        overflow |= intStat->overflow;
+        mergeSum(intStat->sum);
+    }
+    else if (isStatsExists() && hasMin)
+    {
+        throw std::invalid_argument("Incompatible merging of integer column statistics");
+    }
+    StatsRecorder::merge(other);
+}
+
+void IntegerStatsRecorder::reset()
+{
+    StatsRecorder::reset();
+    minimum = LONG_MAX;
+    maximum = LONG_MIN;
+    sum = 0L;
+    hasMin = false;
+    hasMax = false;
+    overflow = false;
+}
+
+pixels::proto::ColumnStatistic IntegerStatsRecorder::serialize() const
+{
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    auto intStat = statistic.mutable_intstatistics();
+    if (hasMin)
+    {
+        intStat->set_minimum(minimum);
+    }
+    if (hasMax)
+    {
+        intStat->set_maximum(maximum);
+    }
+    if (!overflow)
+    {
+        intStat->set_sum(sum);
+    }
+    return statistic;
+}
+
+long IntegerStatsRecorder::getMinimum() const
+{ return minimum; }
+
+long IntegerStatsRecorder::getMaximum() const
+{ return maximum; }
+
+bool IntegerStatsRecorder::hasMinimum() const
+{ return hasMin; }
+
+bool IntegerStatsRecorder::hasMaximum() const
+{ return hasMax; }
+
+bool IntegerStatsRecorder::isSumDefined() const
+{ return !overflow; }
+
+long IntegerStatsRecorder::getSum() const
+{ return sum; }
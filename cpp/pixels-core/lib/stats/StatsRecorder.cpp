@@ -23,6 +23,12 @@
  * @create 2024-11-19
  */
 #include "stats/StatsRecorder.h"
+#include "stats/IntegerStatsRecorder.h"
+#include "stats/Integer128StatsRecorder.h"
+#include "stats/DoubleStatsRecorder.h"
+#include "stats/StringStatsRecorder.h"
+#include "stats/DateStatsRecorder.h"
+#include "stats/TimestampStatsRecorder.h"
 #include <stdexcept>
 
 
@@ -105,6 +111,41 @@ void StatsRecorder::updateVector()
     throw std::logic_error("Can't update vector");
 }
 
+void StatsRecorder::updateInteger(const int *, const uint8_t *, int)
+{
+    throw std::logic_error("Can't update integer");
+}
+
+void StatsRecorder::updateInteger(const long *, const uint8_t *, int)
+{
+    throw std::logic_error("Can't update integer");
+}
+
+void StatsRecorder::updateInteger128(const long *, const uint8_t *, int)
+{
+    throw std::logic_error("Can't update integer128");
+}
+
+void StatsRecorder::updateDouble(const double *, const uint8_t *, int)
+{
+    throw std::logic_error("Can't update double");
+}
+
+void StatsRecorder::updateString(const std::string *, const uint8_t *, int)
+{
+    throw std::logic_error("Can't update string");
+}
+
+void StatsRecorder::updateDate(const int *, const uint8_t *, int)
+{
+    throw std::logic_error("Can't update date");
+}
+
+void StatsRecorder::updateTimestamp(const long *, const uint8_t *, int)
+{
+    throw std::logic_error("Can't update timestamp");
+}
+
 bool StatsRecorder::isStatsExists() const
 {
     return (numberOfValues > 0 || hasNull);
@@ -145,11 +186,28 @@ std::unique_ptr <StatsRecorder> StatsRecorder::create(TypeDescription type)
 {
     switch (type.getCategory())
     {
-
-        case TypeDescription::BOOLEAN:
-            // return std::make_unique<BooleanStatsRecorder>();
-            break;
-
+        case TypeDescription::BYTE:
+        case TypeDescription::SHORT:
+        case TypeDescription::INT:
+        case TypeDescription::LONG:
+            return std::make_unique<IntegerStatsRecorder>();
+        case TypeDescription::DECIMAL:
+            if (type.getPrecision() <= TypeDescription::SHORT_DECIMAL_MAX_PRECISION)
+            {
+                return std::make_unique<IntegerStatsRecorder>();
+            }
+            return std::make_unique<Integer128StatsRecorder>();
+        case TypeDescription::FLOAT:
+        case TypeDescription::DOUBLE:
+            return std::make_unique<DoubleStatsRecorder>();
+        case TypeDescription::STRING:
+        case TypeDescription::CHAR:
+        case TypeDescription::VARCHAR:
+            return std::make_unique<StringStatsRecorder>();
+        case TypeDescription::DATE:
+            return std::make_unique<DateStatsRecorder>();
+        case TypeDescription::TIMESTAMP:
+            return std::make_unique<TimestampStatsRecorder>();
         default:
             return std::make_unique<StatsRecorder>();
     }
@@ -159,12 +217,12 @@ std::unique_ptr <StatsRecorder> StatsRecorder::create(TypeDescription type)
 std::unique_ptr <StatsRecorder>
 StatsRecorder::create(TypeDescription type, const pixels::proto::ColumnStatistic &statistic)
 {
-    switch (type.getCategory())
+    if (type.getCategory() == TypeDescription::DECIMAL &&
+        type.getPrecision() > TypeDescription::SHORT_DECIMAL_MAX_PRECISION)
     {
-
-        default:
-            return std::make_unique<StatsRecorder>(statistic);
+        return std::make_unique<Integer128StatsRecorder>(statistic);
     }
+    return create(type.getCategory(), statistic);
 }
 
 
@@ -173,7 +231,29 @@ StatsRecorder::create(TypeDescription::Category category, const pixels::proto::C
 {
     switch (category)
     {
-
+        case TypeDescription::BYTE:
+        case TypeDescription::SHORT:
+        case TypeDescription::INT:
+        case TypeDescription::LONG:
+            return std::make_unique<IntegerStatsRecorder>(statistic);
+        case TypeDescription::DECIMAL:
+            // without the precision, the statistic itself tells short decimals from long decimals
+            if (statistic.has_int128statistics())
+            {
+                return std::make_unique<Integer128StatsRecorder>(statistic);
+            }
+            return std::make_unique<IntegerStatsRecorder>(statistic);
+        case TypeDescription::FLOAT:
+        case TypeDescription::DOUBLE:
+            return std::make_unique<DoubleStatsRecorder>(statistic);
+        case TypeDescription::STRING:
+        case TypeDescription::CHAR:
+        case TypeDescription::VARCHAR:
+            return std::make_unique<StringStatsRecorder>(statistic);
+        case TypeDescription::DATE:
+            return std::make_unique<DateStatsRecorder>(statistic);
+        case TypeDescription::TIMESTAMP:
+            return std::make_unique<TimestampStatsRecorder>(statistic);
         default:
             return std::make_unique<StatsRecorder>(statistic);
     }
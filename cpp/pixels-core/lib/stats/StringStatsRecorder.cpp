@@ -0,0 +1,184 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "stats/StringStatsRecorder.h"
+#include <stdexcept>
+
+StringStatsRecorder::StringStatsRecorder() = default;
+
+StringStatsRecorder::StringStatsRecorder(const pixels::proto::ColumnStatistic &statistic)
+        : StatsRecorder(statistic)
+{
+    const auto &strStat = statistic.stringstatistics();
+    if (strStat.has_minimum() && strStat.has_maximum())
+    {
+        hasMinMax = true;
+        minimum = strStat.minimum();
+        maximum = strStat.maximum();
+    }
+    if (strStat.has_sum())
+    {
+        sum = strStat.sum();
+    }
+}
+
+void StringStatsRecorder::updateString(const std::string &value, int repetitions)
+{
+    if (!hasMinMax)
+    {
+        hasMinMax = true;
+        minimum = value;
+        maximum = value;
+    }
+    else if (value < minimum)
+    {
+        minimum = value;
+    }
+    else if (value > maximum)
+    {
+        maximum = value;
+    }
+    sum += (long) value.size() * repetitions;
+    numberOfValues += repetitions;
+}
+
+void StringStatsRecorder::updateString(const std::string *values, const uint8_t *isNull, int length)
+{
+    numberOfValues += length;
+    // track the positions of min/max first, so that each of them is copied at most once
+    const std::string *localMin = nullptr;
+    const std::string *localMax = nullptr;
+    for (int i = 0; i < length; i++)
+    {
+        if (isNull != nullptr && isNull[i])
+        {
+            continue;
+        }
+        const std::string &value = values[i];
+        if (localMin == nullptr)
+        {
+            localMin = &value;
+            localMax = &value;
+        }
+        else if (value < *localMin)
+        {
+            localMin = &value;
+        }
+        else if (value > *localMax)
+        {
+            localMax = &value;
+        }
+        sum += (long) value.size();
+    }
+    if (localMin == nullptr)
+    {
+        return;
+    }
+    if (!hasMinMax)
+    {
+        hasMinMax = true;
+        minimum = *localMin;
+        maximum = *localMax;
+        return;
+    }
+    if (*localMin < minimum)
+    {
+        minimum = *localMin;
+    }
+    if (*localMax > maximum)
+    {
+        maximum = *localMax;
+    }
+}
+
+void StringStatsRecorder::merge(const StatsRecorder &other)
+{
+    auto strStat = dynamic_cast<const StringStatsRecorder *>(&other);
+    if (strStat != nullptr)
+    {
+        if (strStat->hasMinMax)
+        {
+            if (!hasMinMax)
+            {
+                hasMinMax = true;
+                minimum = strStat->minimum;
+                maximum = strStat->maximum;
+            }
+            else
+            {
+                if (strStat->minimum < minimum)
+                {
+                    minimum = strStat->minimum;
+                }
+                if (strStat->maximum > maximum)
+                {
+                    maximum = strStat->maximum;
+                }
+            }
+        }
+        sum += strStat->sum;
+    }
+    else if (isStatsExists() && hasMinMax)
+    {
+        throw std::invalid_argument("Incompatible merging of string column statistics");
+    }
+    StatsRecorder::merge(other);
+}
+
+void StringStatsRecorder::reset()
+{
+    StatsRecorder::reset();
+    minimum.clear();
+    maximum.clear();
+    sum = 0L;
+    hasMinMax = false;
+}
+
+pixels::proto::ColumnStatistic StringStatsRecorder::serialize() const
+{
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    auto strStat = statistic.mutable_stringstatistics();
+    if (hasMinMax)
+    {
+        strStat->set_minimum(minimum);
+        strStat->set_maximum(maximum);
+    }
+    strStat->set_sum(sum);
+    return statistic;
+}
+
+const std::string &StringStatsRecorder::getMinimum() const
+{ return minimum; }
+
+const std::string &StringStatsRecorder::getMaximum() const
+{ return maximum; }
+
+bool StringStatsRecorder::hasMinimum() const
+{ return hasMinMax; }
+
+bool StringStatsRecorder::hasMaximum() const
+{ return hasMinMax; }
+
+long StringStatsRecorder::getSum() const
+{ return sum; }
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "stats/TimestampStatsRecorder.h"
+#include <stdexcept>
+
+TimestampStatsRecorder::TimestampStatsRecorder() = default;
+
+TimestampStatsRecorder::TimestampStatsRecorder(const pixels::proto::ColumnStatistic &statistic)
+        : StatsRecorder(statistic)
+{
+    const auto &timestampStat = statistic.timestampstatistics();
+    if (timestampStat.has_minimum())
+    {
+        hasMin = true;
+        minimum = timestampStat.minimum();
+    }
+    if (timestampStat.has_maximum())
+    {
+        hasMax = true;
+        maximum = timestampStat.maximum();
+    }
+}
+
+void TimestampStatsRecorder::updateTimestamp(long value)
+{
+    numberOfValues++;
+    if (!hasMin || value < minimum)
+    {
+        hasMin = true;
+        minimum = value;
+    }
+    if (!hasMax || value > maximum)
+    {
+        hasMax = true;
+        maximum = value;
+    }
+}
+
+void TimestampStatsRecorder::updateTimestamp(const long *values, const uint8_t *isNull, int length)
+{
+    numberOfValues += length;
+    long localMin = LONG_MAX;
+    long localMax = LONG_MIN;
+    int nonNulls = 0;
+    for (int i = 0; i < length; i++)
+    {
+        if (isNull != nullptr && isNull[i])
+        {
+            continue;
+        }
+        localMin = values[i] < localMin ? values[i] : localMin;
+        localMax = values[i] > localMax ? values[i] : localMax;
+        nonNulls++;
+    }
+    if (nonNulls == 0)
+    {
+        return;
+    }
+    if (!hasMin || localMin < minimum)
+    {
+        hasMin = true;
+        minimum = localMin;
+    }
+    if (!hasMax || localMax > maximum)
+    {
+        hasMax = true;
+        maximum = localMax;
+    }
+}
+
+void TimestampStatsRecorder::merge(const StatsRecorder &other)
+{
+    auto timestampStat = dynamic_cast<const TimestampStatsRecorder *>(&other);
+    if (timestampStat != nullptr)
+    {
+        if (timestampStat->hasMin && (!hasMin || timestampStat->minimum < minimum))
+        {
+            hasMin = true;
+            minimum = timestampStat->minimum;
+        }
+        if (timestampStat->hasMax && (!hasMax || timestampStat->maximum > maximum))
+        {
+            hasMax = true;
+            maximum = timestampStat->maximum;
+        }
+    }
+    else if (isStatsExists() && hasMin)
+    {
+        throw std::invalid_argument("Incompatible merging of timestamp column statistics");
+    }
+    StatsRecorder::merge(other);
+}
+
+void TimestampStatsRecorder::reset()
+{
+    StatsRecorder::reset();
+    minimum = LONG_MAX;
+    maximum = LONG_MIN;
+    hasMin = false;
+    hasMax = false;
+}
+
+pixels::proto::ColumnStatistic TimestampStatsRecorder::serialize() const
+{
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    auto timestampStat = statistic.mutable_timestampstatistics();
+    if (hasMin)
+    {
+        timestampStat->set_minimum(minimum);
+    }
+    if (hasMax)
+    {
+        timestampStat->set_maximum(maximum);
+    }
+    return statistic;
+}
+
+long TimestampStatsRecorder::getMinimum() const
+{ return minimum; }
+
+long TimestampStatsRecorder::getMaximum() const
+{ return maximum; }
+
+bool TimestampStatsRecorder::hasMinimum() const
+{ return hasMin; }
+
+bool TimestampStatsRecorder::hasMaximum() const
+{ return hasMax; }
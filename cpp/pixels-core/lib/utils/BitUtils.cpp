@@ -23,8 +23,13 @@
  * @create 2024-11-27
  */
 #include <stdexcept>
+#include <cstring>
 #include "utils/BitUtils.h"
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 std::vector <uint8_t> BitUtils::bitWiseCompactLE(std::vector<bool> values)
 {
     return bitWiseCompactLE(values, values.size());
@@ -318,3 +323,32 @@ std::vector <uint8_t> BitUtils::bitWiseCompactBE(bool *values, int length)
 
     return bitWiseOutput;
 }
+
+void BitUtils::bitWiseDeCompactLE(const uint8_t *input, uint64_t bitOffset, int length, uint8_t *values)
+{
+    int i = 0;
+    // expand the bits one by one until the next value starts a byte
+    for (; i < length && (bitOffset + i) % 8 != 0; i++)
+    {
+        values[i] = (input[(bitOffset + i) / 8] >> ((bitOffset + i) % 8)) & 1;
+    }
+#ifdef __AVX2__
+    // spread each of the 4 bytes of 32 bits over 8 lanes, and test the bit of each lane
+    const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                            2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i bitMask = _mm256_set1_epi64x(0x8040201008040201L);
+    const __m256i ones = _mm256_set1_epi8(1);
+    for (; i + 32 <= length; i += 32)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, input + (bitOffset + i) / 8, sizeof(bits));
+        __m256i lanes = _mm256_shuffle_epi8(_mm256_set1_epi32((int) bits), spread);
+        __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(lanes, bitMask), bitMask);
+        _mm256_storeu_si256((__m256i *) (values + i), _mm256_and_si256(set, ones));
+    }
+#endif
+    for (; i < length; i++)
+    {
+        values[i] = (input[(bitOffset + i) / 8] >> ((bitOffset + i) % 8)) & 1;
+    }
+}
@@ -23,6 +23,11 @@
  * @create 2023-03-21
  */
 #include "utils/EncodingUtils.h"
+#include <algorithm>
+#include <cstring>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 int EncodingUtils::BUFFER_SIZE = 64;
 
@@ -1030,3 +1035,154 @@ void EncodingUtils::writeRemainingLongs(std::shared_ptr <ByteBuffer> output, int
     int toWrite = numHops * numBytes;
     output->putBytes(writeBuffer, toWrite);
 }
+
+template<typename T>
+static inline T zigzagDecodeTo(uint64_t val)
+{
+    return (T) ((val >> 1) ^ -(val & 1));
+}
+
+#ifdef __AVX2__
+static inline __m256i zigzagDecodeEpi32(__m256i val)
+{
+    __m256i sign = _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_and_si256(val, _mm256_set1_epi32(1)));
+    return _mm256_xor_si256(_mm256_srli_epi32(val, 1), sign);
+}
+
+static inline __m256i zigzagDecodeEpi64(__m256i val)
+{
+    __m256i sign = _mm256_sub_epi64(_mm256_setzero_si256(), _mm256_and_si256(val, _mm256_set1_epi64x(1)));
+    return _mm256_xor_si256(_mm256_srli_epi64(val, 1), sign);
+}
+
+/**
+ * Unpack the values of 1, 2 or 4 bytes with AVX2.
+ * @return the number of values unpacked, the rest are left to the scalar loop
+ */
+template<typename T>
+static int unpackBytesAvx2(T *values, int len, int numBytes, const uint8_t *input, bool zigzag)
+{
+    // reverse the bytes of each 2 and 4 byte big-endian value
+    const __m128i swap16 = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    const __m128i swap32 = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    constexpr int step = 32 / sizeof(T);
+    int i = 0;
+    for (; i + step <= len; i += step)
+    {
+        const uint8_t *in = input + i * numBytes;
+        __m256i val;
+        if constexpr (sizeof(T) == 4)
+        {
+            if (numBytes == 1)
+            {
+                val = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) in));
+            }
+            else if (numBytes == 2)
+            {
+                val = _mm256_cvtepu16_epi32(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) in), swap16));
+            }
+            else
+            {
+                __m128i low = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) in), swap32);
+                __m128i high = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (in + 16)), swap32);
+                val = _mm256_set_m128i(high, low);
+            }
+            if (zigzag)
+            {
+                val = zigzagDecodeEpi32(val);
+            }
+        }
+        else
+        {
+            if (numBytes == 1)
+            {
+                int32_t packed;
+                memcpy(&packed, in, sizeof(packed));
+                val = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed));
+            }
+            else if (numBytes == 2)
+            {
+                val = _mm256_cvtepu16_epi64(_mm_shuffle_epi8(_mm_loadl_epi64((const __m128i *) in), swap16));
+            }
+            else
+            {
+                val = _mm256_cvtepu32_epi64(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) in), swap32));
+            }
+            if (zigzag)
+            {
+                val = zigzagDecodeEpi64(val);
+            }
+        }
+        _mm256_storeu_si256((__m256i *) (values + i), val);
+    }
+    return i;
+}
+#endif
+
+template<typename T>
+int EncodingUtils::unpack(T *values, int len, int bitSize, const uint8_t *input, bool zigzag)
+{
+    if (len <= 0)
+    {
+        return 0;
+    }
+    if (bitSize == 1 || bitSize == 2 || bitSize == 4)
+    {
+        // several values in each byte from the most significant bits
+        int valuesPerByte = 8 / bitSize;
+        uint32_t mask = (1 << bitSize) - 1;
+        for (int i = 0; i < len; i++)
+        {
+            int shift = 8 - bitSize * (i % valuesPerByte + 1);
+            uint64_t val = (input[i / valuesPerByte] >> shift) & mask;
+            values[i] = zigzag ? zigzagDecodeTo<T>(val) : (T) val;
+        }
+        return (len * bitSize + 7) / 8;
+    }
+    if (bitSize % 8 != 0)
+    {
+        // the widths that are not byte aligned, e.g., in PATCHED_BASE runs
+        uint64_t bitPos = 0;
+        for (int i = 0; i < len; i++)
+        {
+            uint64_t val = 0;
+            int bitsToRead = bitSize;
+            while (bitsToRead > 0)
+            {
+                int bitsInByte = 8 - (int) (bitPos % 8);
+                int bits = std::min(bitsInByte, bitsToRead);
+                uint32_t byteVal = input[bitPos / 8];
+                val = (val << bits) | ((byteVal >> (bitsInByte - bits)) & ((1u << bits) - 1));
+                bitPos += bits;
+                bitsToRead -= bits;
+            }
+            values[i] = zigzag ? zigzagDecodeTo<T>(val) : (T) val;
+        }
+        return (int) ((bitPos + 7) / 8);
+    }
+    int numBytes = bitSize / 8;
+    int i = 0;
+#ifdef __AVX2__
+    if (numBytes == 1 || numBytes == 2 || numBytes == 4)
+    {
+        i = unpackBytesAvx2(values, len, numBytes, input, zigzag);
+    }
+#endif
+    const uint8_t *in = input + i * numBytes;
+    for (; i < len; i++)
+    {
+        uint64_t val = 0;
+        for (int b = 0; b < numBytes; b++)
+        {
+            val = (val << 8) | *in++;
+        }
+        values[i] = zigzag ? zigzagDecodeTo<T>(val) : (T) val;
+    }
+    return len * numBytes;
+}
+
+template int EncodingUtils::unpack<int32_t>(int32_t *values, int len, int bitSize,
+                                            const uint8_t *input, bool zigzag);
+
+template int EncodingUtils::unpack<int64_t>(int64_t *values, int len, int bitSize,
+                                            const uint8_t *input, bool zigzag);
@@ -30,6 +30,10 @@ BinaryColumnVector::BinaryColumnVector(uint64_t len, bool encoding) : ColumnVect
                  len * sizeof(duckdb::string_t));
   str_vec.resize(len);
   memoryUsage += (long) sizeof(uint8_t) * len;
+  dictionary = nullptr;
+  dictionaryValid = nullptr;
+  dictionarySize = 0;
+  dictIds = nullptr;
 }
 
 void BinaryColumnVector::close()
@@ -39,7 +43,44 @@ void BinaryColumnVector::close()
     ColumnVector::close();
     free(vector);
     vector = nullptr;
+    if (dictIds != nullptr)
+    {
+      free(dictIds);
+      dictIds = nullptr;
+    }
+  }
+}
+
+void BinaryColumnVector::setDictionary(duckdb::string_t *entries, uint64_t *valid, int size, bool renewed)
+{
+  if (renewed || entries == nullptr)
+  {
+    dictionaryFilterResults.clear();
   }
+  dictionary = entries;
+  dictionaryValid = valid;
+  dictionarySize = size;
+  if (entries != nullptr && dictIds == nullptr)
+  {
+    // the ids are only allocated once the vector is used for a dictionary encoded chunk
+    posix_memalign(reinterpret_cast<void **>(&dictIds), 32, length * sizeof(uint32_t));
+    memoryUsage += (long) sizeof(uint32_t) * length;
+  }
+}
+
+bool BinaryColumnVector::isDictionaryEncoded() const
+{
+  return dictionary != nullptr;
+}
+
+duckdb::string_t BinaryColumnVector::getValue(int elementNum) const
+{
+  return dictionary != nullptr ? dictionary[dictIds[elementNum]] : vector[elementNum];
+}
+
+uint32_t *BinaryColumnVector::currentDictIds()
+{
+  return dictIds == nullptr ? nullptr : dictIds + readIndex;
 }
 
 void BinaryColumnVector::setRef(int elementNum, uint8_t *const &sourceBuf, int start, int length)
@@ -116,7 +157,17 @@ void BinaryColumnVector::ensureSize(uint64_t size, bool preserveData)
     {
       std::copy(oldVector, oldVector + length, vector);
     }
-    delete[] oldVector;
+    free(oldVector);
+    if (dictIds != nullptr)
+    {
+      uint32_t *oldDictIds = dictIds;
+      posix_memalign(reinterpret_cast<void **>(&dictIds), 32, size * sizeof(uint32_t));
+      if (preserveData)
+      {
+        std::copy(oldDictIds, oldDictIds + length, dictIds);
+      }
+      free(oldDictIds);
+    }
     memoryUsage += (long) sizeof(duckdb::string_t) * (size - length);
     resize(size);
   }
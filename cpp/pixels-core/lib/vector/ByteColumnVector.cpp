@@ -23,10 +23,13 @@
  * @create 2023-03-17
  */
 #include "vector/ByteColumnVector.h"
+#include <cstring>
 
 ByteColumnVector::ByteColumnVector(int len, bool encoding) : ColumnVector(len, encoding)
 {
-    vector = new uint8_t[len];
+    posix_memalign(reinterpret_cast<void **>(&buffer), 32, len * sizeof(uint8_t));
+    vector = buffer;
+    bits = nullptr;
     memoryUsage += (long) sizeof(uint8_t) * len;
 }
 
@@ -35,7 +38,78 @@ void ByteColumnVector::close()
     if (!closed)
     {
         ColumnVector::close();
-        delete[] vector;
+        free(buffer);
+        buffer = nullptr;
         vector = nullptr;
+        bits = nullptr;
     }
-}
\ No newline at end of file
+}
+
+ByteColumnVector::~ByteColumnVector()
+{
+    if (!closed)
+    {
+        ByteColumnVector::close();
+    }
+}
+
+uint8_t *ByteColumnVector::ownedVector(int preserved)
+{
+    if (vector != buffer && vector != nullptr && preserved > 0)
+    {
+        std::memcpy(buffer, vector, preserved * sizeof(uint8_t));
+    }
+    vector = buffer;
+    return buffer;
+}
+
+void *ByteColumnVector::current()
+{
+    if (vector == nullptr)
+    {
+        return nullptr;
+    }
+    else
+    {
+        return vector + readIndex;
+    }
+}
+
+void ByteColumnVector::add(bool value)
+{
+    add((int64_t) (value ? 1 : 0));
+}
+
+void ByteColumnVector::add(int64_t value)
+{
+    if (writeIndex >= length)
+    {
+        ensureSize(writeIndex * 2, true);
+    }
+    int index = writeIndex++;
+    ownedVector()[index] = (uint8_t) value;
+    isNull[index] = false;
+}
+
+void ByteColumnVector::add(int value)
+{
+    add((int64_t) value);
+}
+
+void ByteColumnVector::ensureSize(uint64_t size, bool preserveData)
+{
+    ColumnVector::ensureSize(size, preserveData);
+    if (length < size)
+    {
+        uint8_t *oldBuffer = buffer;
+        posix_memalign(reinterpret_cast<void **>(&buffer), 32, size * sizeof(uint8_t));
+        if (preserveData)
+        {
+            std::memcpy(buffer, vector, length);
+        }
+        free(oldBuffer);
+        vector = buffer;
+        memoryUsage += (long) sizeof(uint8_t) * (size - length);
+        resize(size);
+    }
+}
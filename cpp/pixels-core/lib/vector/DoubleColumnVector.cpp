@@ -0,0 +1,130 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "vector/DoubleColumnVector.h"
+#include <algorithm>
+#include <cstring>
+
+DoubleColumnVector::DoubleColumnVector(uint64_t len, bool encoding)
+        : ColumnVector (len, encoding)
+{
+    posix_memalign (reinterpret_cast<void **>(&buffer), 32,
+                    len * sizeof (double));
+    vector = buffer;
+    memoryUsage += (long) sizeof (double) * len;
+}
+
+void DoubleColumnVector::close()
+{
+    if (!closed)
+    {
+        ColumnVector::close ();
+        free (buffer);
+        buffer = nullptr;
+        vector = nullptr;
+    }
+}
+
+DoubleColumnVector::~DoubleColumnVector()
+{
+    if (!closed)
+    {
+        DoubleColumnVector::close ();
+    }
+}
+
+double *DoubleColumnVector::ownedVector(int preserved)
+{
+    if (vector != buffer && vector != nullptr && preserved > 0)
+    {
+        std::memcpy(buffer, vector, preserved * sizeof(double));
+    }
+    vector = buffer;
+    return buffer;
+}
+
+void *DoubleColumnVector::current()
+{
+    if (vector == nullptr)
+    {
+        return nullptr;
+    } else
+    {
+        return vector + readIndex;
+    }
+}
+
+void DoubleColumnVector::print(int rowCount)
+{
+    for (int i = 0; i < rowCount; i++)
+    {
+        std::cout << vector[i] << std::endl;
+    }
+}
+
+void DoubleColumnVector::add(std::string &value)
+{
+    if (writeIndex >= length)
+    {
+        ensureSize (writeIndex * 2, true);
+    }
+    int index = writeIndex++;
+    ownedVector ()[index] = std::stod (value);
+    isNull[index] = false;
+}
+
+void DoubleColumnVector::add(int64_t value)
+{
+    if (writeIndex >= length)
+    {
+        ensureSize (writeIndex * 2, true);
+    }
+    int index = writeIndex++;
+    ownedVector ()[index] = (double) value;
+    isNull[index] = false;
+}
+
+void DoubleColumnVector::add(int value)
+{
+    add ((int64_t) value);
+}
+
+void DoubleColumnVector::ensureSize(uint64_t size, bool preserveData)
+{
+    ColumnVector::ensureSize (size, preserveData);
+    if (length < size)
+    {
+        double *oldBuffer = buffer;
+        posix_memalign (reinterpret_cast<void **>(&buffer), 32,
+                        size * sizeof (double));
+        if (preserveData)
+        {
+            std::copy (vector, vector + length, buffer);
+        }
+        free (oldBuffer);
+        vector = buffer;
+        memoryUsage += (long) sizeof (double) * (size - length);
+        resize (size);
+    }
+}
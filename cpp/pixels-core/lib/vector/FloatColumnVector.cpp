@@ -0,0 +1,130 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "vector/FloatColumnVector.h"
+#include <algorithm>
+#include <cstring>
+
+FloatColumnVector::FloatColumnVector(uint64_t len, bool encoding)
+        : ColumnVector (len, encoding)
+{
+    posix_memalign (reinterpret_cast<void **>(&buffer), 32,
+                    len * sizeof (float));
+    vector = buffer;
+    memoryUsage += (long) sizeof (float) * len;
+}
+
+void FloatColumnVector::close()
+{
+    if (!closed)
+    {
+        ColumnVector::close ();
+        free (buffer);
+        buffer = nullptr;
+        vector = nullptr;
+    }
+}
+
+FloatColumnVector::~FloatColumnVector()
+{
+    if (!closed)
+    {
+        FloatColumnVector::close ();
+    }
+}
+
+float *FloatColumnVector::ownedVector(int preserved)
+{
+    if (vector != buffer && vector != nullptr && preserved > 0)
+    {
+        std::memcpy(buffer, vector, preserved * sizeof(float));
+    }
+    vector = buffer;
+    return buffer;
+}
+
+void *FloatColumnVector::current()
+{
+    if (vector == nullptr)
+    {
+        return nullptr;
+    } else
+    {
+        return vector + readIndex;
+    }
+}
+
+void FloatColumnVector::print(int rowCount)
+{
+    for (int i = 0; i < rowCount; i++)
+    {
+        std::cout << vector[i] << std::endl;
+    }
+}
+
+void FloatColumnVector::add(std::string &value)
+{
+    if (writeIndex >= length)
+    {
+        ensureSize (writeIndex * 2, true);
+    }
+    int index = writeIndex++;
+    ownedVector ()[index] = std::stof (value);
+    isNull[index] = false;
+}
+
+void FloatColumnVector::add(int64_t value)
+{
+    if (writeIndex >= length)
+    {
+        ensureSize (writeIndex * 2, true);
+    }
+    int index = writeIndex++;
+    ownedVector ()[index] = (float) value;
+    isNull[index] = false;
+}
+
+void FloatColumnVector::add(int value)
+{
+    add ((int64_t) value);
+}
+
+void FloatColumnVector::ensureSize(uint64_t size, bool preserveData)
+{
+    ColumnVector::ensureSize (size, preserveData);
+    if (length < size)
+    {
+        float *oldBuffer = buffer;
+        posix_memalign (reinterpret_cast<void **>(&buffer), 32,
+                        size * sizeof (float));
+        if (preserveData)
+        {
+            std::copy (vector, vector + length, buffer);
+        }
+        free (oldBuffer);
+        vector = buffer;
+        memoryUsage += (long) sizeof (float) * (size - length);
+        resize (size);
+    }
+}
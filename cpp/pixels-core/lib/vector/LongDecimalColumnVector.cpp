@@ -0,0 +1,154 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include <algorithm>
+#include <cstring>
+#include "vector/LongDecimalColumnVector.h"
+
+LongDecimalColumnVector::LongDecimalColumnVector(int precision, int scale, bool encoding)
+        : LongDecimalColumnVector (VectorizedRowBatch::DEFAULT_SIZE, precision, scale, encoding)
+{
+}
+
+LongDecimalColumnVector::LongDecimalColumnVector(uint64_t len, int precision, int scale,
+                                                 bool encoding)
+        : ColumnVector (len, encoding)
+{
+    this->precision = precision;
+    this->scale = scale;
+    posix_memalign (reinterpret_cast<void **>(&vector), 32,
+                    len * sizeof (duckdb::hugeint_t));
+    memoryUsage += (uint64_t) sizeof (duckdb::hugeint_t) * len;
+}
+
+void LongDecimalColumnVector::close()
+{
+    if (!closed)
+    {
+        ColumnVector::close ();
+        free (vector);
+        vector = nullptr;
+    }
+}
+
+void LongDecimalColumnVector::print(int rowCount)
+{
+    for (int i = 0; i < rowCount; i++)
+    {
+        std::cout << vector[i].upper << " " << vector[i].lower << std::endl;
+    }
+}
+
+LongDecimalColumnVector::~LongDecimalColumnVector()
+{
+    if (!closed)
+    {
+        LongDecimalColumnVector::close ();
+    }
+}
+
+void *LongDecimalColumnVector::current()
+{
+    if (vector == nullptr)
+    {
+        return nullptr;
+    } else
+    {
+        return vector + readIndex;
+    }
+}
+
+int LongDecimalColumnVector::getPrecision()
+{
+    return precision;
+}
+
+int LongDecimalColumnVector::getScale()
+{
+    return scale;
+}
+
+void LongDecimalColumnVector::add(std::string &value)
+{
+    size_t pos = value.find ('.');
+    std::string digits = pos == std::string::npos ? value : value.substr (0, pos) + value.substr (pos + 1);
+    int fraction = pos == std::string::npos ? 0 : (int) (value.length () - pos - 1);
+    bool negative = !digits.empty () && digits[0] == '-';
+    __int128 unscaled = 0;
+    for (size_t i = negative ? 1 : 0; i < digits.length (); i++)
+    {
+        unscaled = unscaled * 10 + (digits[i] - '0');
+    }
+    for (int i = fraction; i < scale; i++)
+    {
+        unscaled *= 10;
+    }
+    if (negative)
+    {
+        unscaled = -unscaled;
+    }
+    if (writeIndex >= length)
+    {
+        ensureSize (writeIndex * 2, true);
+    }
+    int index = writeIndex++;
+    vector[index].lower = (uint64_t) unscaled;
+    vector[index].upper = (int64_t) (unscaled >> 64);
+    isNull[index] = false;
+}
+
+void LongDecimalColumnVector::add(int64_t value)
+{
+    if (writeIndex >= length)
+    {
+        ensureSize (writeIndex * 2, true);
+    }
+    int index = writeIndex++;
+    vector[index].lower = (uint64_t) value;
+    vector[index].upper = value >> 63;
+    isNull[index] = false;
+}
+
+void LongDecimalColumnVector::add(int value)
+{
+    add ((int64_t) value);
+}
+
+void LongDecimalColumnVector::ensureSize(uint64_t size, bool preserveData)
+{
+    ColumnVector::ensureSize (size, preserveData);
+    if (length < size)
+    {
+        duckdb::hugeint_t *oldVector = vector;
+        posix_memalign (reinterpret_cast<void **>(&vector), 32,
+                        size * sizeof (duckdb::hugeint_t));
+        if (preserveData)
+        {
+            std::copy (oldVector, oldVector + length, vector);
+        }
+        free (oldVector);
+        memoryUsage += (long) sizeof (duckdb::hugeint_t) * (size - length);
+        resize (size);
+    }
+}
@@ -58,6 +58,16 @@ pixels::proto::ColumnEncoding ColumnWriter::getColumnChunkEncoding() const
     return encoding;
 }
 
+pixels::proto::ColumnStatistic ColumnWriter::getColumnChunkStat() const
+{
+    return columnChunkStatRecorder->serialize();
+}
+
+const StatsRecorder &ColumnWriter::getColumnChunkStatRecorder() const
+{
+    return *columnChunkStatRecorder;
+}
+
 void ColumnWriter::flush()
 {
     if (curPixelEleIndex > 0)
@@ -82,23 +92,23 @@ void ColumnWriter::newPixel()
     {
         auto compacted = BitUtils::bitWiseCompact(isNull, curPixelIsNullIndex, byteOrder);
         isNullStream->putBytes(const_cast<uint8_t *>(compacted.data()), compacted.size());
-        pixelStatRecorder.setHasNull();
+        pixelStatRecorder->setHasNull();
     }
     curPixelPosition = static_cast<int>(outputStream->getWritePos());
     curPixelEleIndex = 0;
     curPixelVectorIndex = 0;
     curPixelIsNullIndex = 0;
 
-    columnChunkStatRecorder.merge(pixelStatRecorder);
+    columnChunkStatRecorder->merge(*pixelStatRecorder);
 
     pixels::proto::PixelStatistic pixelStat;
-    *pixelStat.mutable_statistic() = pixelStatRecorder.serialize();
+    *pixelStat.mutable_statistic() = pixelStatRecorder->serialize();
     columnChunkIndex->add_pixelpositions(lastPixelPosition);
     auto new_pixelstatistic = columnChunkIndex->add_pixelstatistics();
     *new_pixelstatistic = pixelStat;
 
     lastPixelPosition = curPixelPosition;
-    pixelStatRecorder.reset();
+    pixelStatRecorder->reset();
     hasNull = false;
 }
 
@@ -108,8 +118,8 @@ void ColumnWriter::reset()
     curPixelPosition = 0;
     columnChunkIndex->Clear();
     columnChunkStat->Clear();
-    pixelStatRecorder.reset();
-    columnChunkStatRecorder.reset();
+    pixelStatRecorder->reset();
+    columnChunkStatRecorder->reset();
     outputStream->resetPosition();
     isNullStream->resetPosition();
 }
@@ -131,6 +141,9 @@ ColumnWriter::ColumnWriter(std::shared_ptr <TypeDescription> type,
     outputStream = std::make_shared<ByteBuffer>();
     isNullStream = std::make_shared<ByteBuffer>();
     columnChunkIndex = std::make_shared<pixels::proto::ColumnChunkIndex>();
+    columnChunkStat = std::make_shared<pixels::proto::ColumnStatistic>();
+    pixelStatRecorder = StatsRecorder::create(*type);
+    columnChunkStatRecorder = StatsRecorder::create(*type);
     columnChunkIndex->set_littleendian(byteOrder == ByteOrder::PIXELS_LITTLE_ENDIAN);
     columnChunkIndex->set_nullspadding(nullsPadding);
     columnChunkIndex->set_isnullalignment(ISNULL_ALIGNMENT);
@@ -38,14 +38,36 @@ int DateColumnWriter::write(std::shared_ptr<ColumnVector> vector, int size)
     }
 
     int *values = columnVector->dates;
-    EncodingUtils encodingUtils;
 
-    for (int i = 0; i < size; i++)
+    int curPartLength; // size of the partition which belongs to current pixel
+    int curPartOffset = 0; // starting offset of the partition which belongs to current pixel
+    int nextPartLength = size; // size of the partition which belongs to next pixel
+
+    // do the calculation to partition the vector into current pixel and next one
+    // doing this pre-calculation to eliminate branch prediction inside the for loop
+    while ((curPixelIsNullIndex + nextPartLength) >= pixelStride)
     {
-        isNull[curPixelIsNullIndex] = columnVector->isNull[i];
-        curPixelEleIndex++;
+        curPartLength = pixelStride - curPixelIsNullIndex;
+        writeCurPartDate(columnVector, values, curPartLength, curPartOffset);
+        newPixel();
+        curPartOffset += curPartLength;
+        nextPartLength = size - curPartOffset;
+    }
+
+    curPartLength = nextPartLength;
+    writeCurPartDate(columnVector, values, curPartLength, curPartOffset);
+
+    return outputStream->getWritePos();
+}
 
-        if (columnVector->isNull[i])
+void DateColumnWriter::writeCurPartDate(std::shared_ptr<DateColumnVector> columnVector, int *values,
+                                         int curPartLength, int curPartOffset)
+{
+    EncodingUtils encodingUtils;
+    for (int i = 0; i < curPartLength; i++)
+    {
+        curPixelEleIndex++;
+        if (columnVector->isNull[i + curPartOffset])
         {
             hasNull = true;
             encodingUtils.writeIntLE(outputStream, 0);
@@ -53,19 +75,18 @@ int DateColumnWriter::write(std::shared_ptr<ColumnVector> vector, int size)
         {
             if (byteOrder == ByteOrder::PIXELS_LITTLE_ENDIAN)
             {
-                encodingUtils.writeIntLE(outputStream, values[i]);
+                encodingUtils.writeIntLE(outputStream, values[i + curPartOffset]);
             } else
             {
-                encodingUtils.writeIntBE(outputStream, values[i]);
+                encodingUtils.writeIntBE(outputStream, values[i + curPartOffset]);
             }
         }
-
-        if (curPixelEleIndex >= pixelStride)
-        {
-            newPixel();
-        }
     }
-    return outputStream->getWritePos();
+    std::copy(columnVector->isNull + curPartOffset,
+              columnVector->isNull + curPartOffset + curPartLength,
+              isNull.begin() + curPixelIsNullIndex);
+    curPixelIsNullIndex += curPartLength;
+    pixelStatRecorder->updateDate(values + curPartOffset, columnVector->isNull + curPartOffset, curPartLength);
 }
 
 bool DateColumnWriter::decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption)
@@ -108,6 +108,8 @@ void IntColumnWriter::writeCurPartInt(
                columnVector->isNull + curPartOffset + curPartLength,
                isNull.begin () + curPixelIsNullIndex);
     curPixelIsNullIndex += curPartLength;
+    pixelStatRecorder->updateInteger (values + curPartOffset, columnVector->isNull + curPartOffset,
+                                      curPartLength);
 }
 
 bool IntColumnWriter::decideNullsPadding(
@@ -107,6 +107,8 @@ void LongColumnWriter::writeCurPartLong(
             columnVector->isNull + curPartOffset + curPartLength,
             isNull.begin() + curPixelIsNullIndex);
   curPixelIsNullIndex += curPartLength;
+  pixelStatRecorder->updateInteger(values + curPartOffset, columnVector->isNull + curPartOffset,
+                                   curPartLength);
 }
 
 bool LongColumnWriter::decideNullsPadding(
@@ -37,32 +37,53 @@ int StringColumnWriter::write(std::shared_ptr<ColumnVector> vector, int length)
         throw std::invalid_argument("Invalid vector type");
     }
 
-    auto values = columnVector->str_vec;
-    EncodingUtils encodingUtils;
+    int curPartLength; // size of the partition which belongs to current pixel
+    int curPartOffset = 0; // starting offset of the partition which belongs to current pixel
+    int nextPartLength = length; // size of the partition which belongs to next pixel
 
-    for (int i = 0; i < length; i++)
+    // do the calculation to partition the vector into current pixel and next one
+    // doing this pre-calculation to eliminate branch prediction inside the for loop
+    while ((curPixelIsNullIndex + nextPartLength) >= pixelStride)
     {
-        isNull[curPixelIsNullIndex] = columnVector->isNull[i];
-        curPixelEleIndex++;
+        curPartLength = pixelStride - curPixelIsNullIndex;
+        writeCurPartString(columnVector, curPartLength, curPartOffset);
+        newPixel();
+        curPartOffset += curPartLength;
+        nextPartLength = length - curPartOffset;
+    }
 
-        if (columnVector->isNull[i])
+    curPartLength = nextPartLength;
+    writeCurPartString(columnVector, curPartLength, curPartOffset);
+
+    return outputStream->getWritePos();
+}
+
+void StringColumnWriter::writeCurPartString(std::shared_ptr<BinaryColumnVector> columnVector,
+                                            int curPartLength, int curPartOffset)
+{
+    const auto &values = columnVector->str_vec;
+    for (int i = 0; i < curPartLength; i++)
+    {
+        curPixelEleIndex++;
+        if (columnVector->isNull[i + curPartOffset])
         {
             hasNull = true;
             startsArray->add(startOffset);
         } else
         {
-            int str_size = values[i].size();
-            outputStream->putBytes((u_int8_t *) values[i].c_str(), str_size, startOffset);
+            const std::string &value = values[i + curPartOffset];
+            int str_size = value.size();
+            outputStream->putBytes((u_int8_t *) value.c_str(), str_size, startOffset);
             startsArray->add(startOffset);
             startOffset += str_size;
         }
-
-        if (curPixelEleIndex >= pixelStride)
-        {
-            newPixel();
-        }
     }
-    return outputStream->getWritePos();
+    std::copy(columnVector->isNull + curPartOffset,
+              columnVector->isNull + curPartOffset + curPartLength,
+              isNull.begin() + curPixelIsNullIndex);
+    curPixelIsNullIndex += curPartLength;
+    pixelStatRecorder->updateString(values.data() + curPartOffset, columnVector->isNull + curPartOffset,
+                                    curPartLength);
 }
 
 void StringColumnWriter::newPixels()
@@ -30,7 +30,6 @@ TimestampColumnWriter::TimestampColumnWriter(std::shared_ptr<TypeDescription> ty
 
 int TimestampColumnWriter::write(std::shared_ptr<ColumnVector> vector, int size)
 {
-    // std::cout<<"In TimestampColumnWriter"<<std::endl;
     auto columnVector = std::static_pointer_cast<TimestampColumnVector>(vector);
 
     if (!columnVector)
@@ -39,14 +38,36 @@ int TimestampColumnWriter::write(std::shared_ptr<ColumnVector> vector, int size)
     }
 
     long *values = columnVector->times;
-    EncodingUtils encodingUtils;
 
-    for (int i = 0; i < size; i++)
+    int curPartLength; // size of the partition which belongs to current pixel
+    int curPartOffset = 0; // starting offset of the partition which belongs to current pixel
+    int nextPartLength = size; // size of the partition which belongs to next pixel
+
+    // do the calculation to partition the vector into current pixel and next one
+    // doing this pre-calculation to eliminate branch prediction inside the for loop
+    while ((curPixelIsNullIndex + nextPartLength) >= pixelStride)
     {
-        isNull[curPixelIsNullIndex] = columnVector->isNull[i];
-        curPixelEleIndex++;
+        curPartLength = pixelStride - curPixelIsNullIndex;
+        writeCurPartTimestamp(columnVector, values, curPartLength, curPartOffset);
+        newPixel();
+        curPartOffset += curPartLength;
+        nextPartLength = size - curPartOffset;
+    }
+
+    curPartLength = nextPartLength;
+    writeCurPartTimestamp(columnVector, values, curPartLength, curPartOffset);
+
+    return outputStream->getWritePos();
+}
 
-        if (columnVector->isNull[i])
+void TimestampColumnWriter::writeCurPartTimestamp(std::shared_ptr<TimestampColumnVector> columnVector, long *values,
+                                                   int curPartLength, int curPartOffset)
+{
+    EncodingUtils encodingUtils;
+    for (int i = 0; i < curPartLength; i++)
+    {
+        curPixelEleIndex++;
+        if (columnVector->isNull[i + curPartOffset])
         {
             hasNull = true;
             encodingUtils.writeLongLE(outputStream, 0L);
@@ -54,19 +75,18 @@ int TimestampColumnWriter::write(std::shared_ptr<ColumnVector> vector, int size)
         {
             if (byteOrder == ByteOrder::PIXELS_LITTLE_ENDIAN)
             {
-                encodingUtils.writeLongLE(outputStream, values[i]);
+                encodingUtils.writeLongLE(outputStream, values[i + curPartOffset]);
             } else
             {
-                encodingUtils.writeLongBE(outputStream, values[i]);
+                encodingUtils.writeLongBE(outputStream, values[i + curPartOffset]);
             }
         }
-
-        if (curPixelEleIndex >= pixelStride)
-        {
-            newPixel();
-        }
     }
-    return outputStream->getWritePos();
+    std::copy(columnVector->isNull + curPartOffset,
+              columnVector->isNull + curPartOffset + curPartLength,
+              isNull.begin() + curPixelIsNullIndex);
+    curPixelIsNullIndex += curPartLength;
+    pixelStatRecorder->updateTimestamp(values + curPartOffset, columnVector->isNull + curPartOffset, curPartLength);
 }
 
 bool TimestampColumnWriter::decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption)
@@ -25,12 +25,20 @@
 #include "PixelsScanFunction.hpp"
 #include "physical/StorageArrayScheduler.h"
 #include "profiler/CountProfiler.h"
+#include "PixelsFilter.h"
+#include "physical/BufferPool/BufferPoolArena.h"
+#include <chrono>
 
 namespace duckdb
 {
 
 bool PixelsScanFunction::enable_filter_pushdown = true;
 
+// the scan reads one more morsel ahead if it waits longer than this for the current morsel
+static constexpr long READ_AHEAD_STALL_NANOS = 50000;
+// and one fewer if this many consecutive morsels are ready when they are scanned
+static constexpr int READ_AHEAD_SHRINK_MORSELS = 8;
+
 static idx_t PixelsScanGetBatchIndex(ClientContext &context, const FunctionData *bind_data_p,
                                      LocalTableFunctionState *local_state,
                                      GlobalTableFunctionState *global_state)
@@ -43,11 +51,12 @@ static double PixelsProgress(ClientContext &context, const FunctionData *bind_da
                              const GlobalTableFunctionState *global_state)
 {
   auto &bind_data = (PixelsReadBindData &) *bind_data_p;
-  if (bind_data.files.empty())
+  auto &gstate = (PixelsReadGlobalState &) *global_state;
+  if (gstate.storageArrayScheduler->getMorselSum() == 0)
     {
     return 100.0;
     }
-  auto percentage = bind_data.curFileId * 100.0 / bind_data.files.size();
+  auto percentage = bind_data.curMorselId * 100.0 / gstate.storageArrayScheduler->getMorselSum();
   return percentage;
 }
 
@@ -55,7 +64,7 @@ static unique_ptr<NodeStatistics> PixelsCardinality(ClientContext &context, cons
 {
   auto &data = (PixelsReadBindData &) *bind_data;
 
-  return make_uniq<NodeStatistics>(data.initialPixelsReader->getNumberOfRows() * data.files.size());
+  return make_uniq<NodeStatistics>(data.totalRows);
 }
 
 TableFunctionSet PixelsScanFunction::GetFunctionSet()
@@ -102,7 +111,6 @@ void PixelsScanFunction::PixelsScanImplementation(ClientContext &context,
         }
       }
     auto currPixelsRecordReader = std::static_pointer_cast<PixelsRecordReaderImpl>(data.currPixelsRecordReader);
-    auto nextPixelsRecordReader = std::static_pointer_cast<PixelsRecordReaderImpl>(data.nextPixelsRecordReader);
 
     if (data.vectorizedRowBatch != nullptr && data.vectorizedRowBatch->isEndOfFile())
       {
@@ -112,6 +120,11 @@ void PixelsScanFunction::PixelsScanImplementation(ClientContext &context,
       {
       data.vectorizedRowBatch = currPixelsRecordReader->readBatch(false);
       }
+    if (data.vectorizedRowBatch->isEndOfFile())
+      {
+      // all the row groups in this file are pruned, move on to the next file
+      continue;
+      }
     uint64_t currentLoc = data.vectorizedRowBatch->position();
     std::shared_ptr<TypeDescription> resultSchema = data.currPixelsRecordReader->getResultSchema();
     uint64_t remaining = data.vectorizedRowBatch->remaining();
@@ -121,13 +134,12 @@ void PixelsScanFunction::PixelsScanImplementation(ClientContext &context,
     std::shared_ptr<PixelsBitMask> filterMask =
         std::static_pointer_cast<PixelsRecordReaderImpl>(data.currPixelsRecordReader)->getFilterMask();
 
-    TransformDuckdbChunk(data, output, resultSchema, thisOutputChunkRows);
-
-    // apply the filter operation
-    if (enable_filter_pushdown)
+    // build the selection before the transform, so that the chunks without
+    // any surviving row are not materialized at all
+    idx_t sel_size = 0;
+    SelectionVector sel;
+    if (enable_filter_pushdown && filterMask != nullptr)
       {
-      idx_t sel_size = 0;
-      SelectionVector sel;
       sel.Initialize(thisOutputChunkRows);
       for (idx_t i = 0; i < thisOutputChunkRows; i++)
         {
@@ -136,6 +148,19 @@ void PixelsScanFunction::PixelsScanImplementation(ClientContext &context,
           sel.set_index(sel_size++, i);
           }
         }
+      if (sel_size == 0)
+        {
+        data.vectorizedRowBatch->increment(thisOutputChunkRows);
+        output.Reset();
+        continue;
+        }
+      }
+
+    TransformDuckdbChunk(data, output, resultSchema, thisOutputChunkRows);
+
+    // apply the filter operation
+    if (enable_filter_pushdown && filterMask != nullptr && sel_size < thisOutputChunkRows)
+      {
       output.Slice(sel, sel_size);
       }
     if (output.size() > 0)
@@ -192,7 +217,11 @@ unique_ptr<FunctionData> PixelsScanFunction::PixelsScanBind(
   // sort the pxl file by file name, so that all SSD arrays can be fully utilized
   sort(filePaths.begin(), filePaths.end(), compare_file_name());
 
-  auto footerCache = std::make_shared<PixelsFooterCache>();
+  // read the file tails of all the files at once to plan the scan, the row group footers are
+  // prefetched in the background once the scan starts
+  auto footerCache = PixelsFooterCache::Instance();
+  std::vector<std::shared_ptr<pixels::proto::FileTail>> fileTails =
+      PixelsFooterPrefetcher::prefetchFileTails(filePaths, footerCache);
   auto builder = std::make_shared<PixelsReaderBuilder>();
 
   std::shared_ptr<::Storage> storage = StorageFactory::getInstance()->getStorage(::Storage::file);
@@ -209,6 +238,15 @@ unique_ptr<FunctionData> PixelsScanFunction::PixelsScanBind(
   result->initialPixelsReader = pixelsReader;
   result->fileSchema = fileSchema;
   result->files = filePaths;
+  result->fileTails = fileTails;
+  result->totalRows = 0;
+  for (const auto &fileTail : fileTails)
+    {
+    // the files whose tails can not be prefetched are assumed to be as large as the first file,
+    // and each of them is scanned as one morsel
+    result->totalRows += fileTail != nullptr ? fileTail->postscript().numberofrows() : pixelsReader->getNumberOfRows();
+    result->fileRGNums.push_back(fileTail != nullptr ? fileTail->footer().rowgroupinfos_size() : -1);
+    }
 
   return std::move(result);
 }
@@ -223,15 +261,63 @@ unique_ptr<GlobalTableFunctionState> PixelsScanFunction::PixelsScanInitGlobal(
 
   result->initialPixelsReader = bind_data.initialPixelsReader;
 
-  int max_threads = std::stoi(ConfigFactory::Instance().getProperty("pixel.threads"));
-  if (max_threads <= 0)
+  // the row groups whose statistics exclude the pushed-down filters are not made into morsels,
+  // so that no reader is opened for them. The readers still prune the row groups of the files
+  // whose tails were not prefetched
+  std::vector<std::vector<bool>> fileRGIncluded(bind_data.files.size());
+  if (enable_filter_pushdown && input.filters != nullptr && !input.filters->filters.empty())
     {
-    max_threads = (int) bind_data.files.size();
+    auto columnTypes = bind_data.fileSchema->getChildren();
+    int prunedRGNum = 0;
+    for (size_t fileId = 0; fileId < bind_data.fileTails.size(); fileId++)
+      {
+      const auto &fileTail = bind_data.fileTails.at(fileId);
+      if (fileTail == nullptr)
+        {
+        continue;
+        }
+      const pixels::proto::Footer &footer = fileTail->footer();
+      auto &included = fileRGIncluded.at(fileId);
+      included.assign(footer.rowgroupinfos_size(), true);
+      for (int rgId = 0; rgId < footer.rowgroupinfos_size() && rgId < footer.rowgroupstats_size(); rgId++)
+        {
+        const pixels::proto::RowGroupStatistic &rowGroupStatistic = footer.rowgroupstats(rgId);
+        for (auto &filterCol : input.filters->filters)
+          {
+          if (filterCol.first >= input.column_ids.size())
+            {
+            continue;
+            }
+          column_t colId = input.column_ids.at(filterCol.first);
+          if (IsRowIdColumnId(colId) || colId >= (column_t) rowGroupStatistic.columnchunkstats_size())
+            {
+            continue;
+            }
+          if (!PixelsFilter::CheckStatistic(*filterCol.second, rowGroupStatistic.columnchunkstats(colId),
+                                            columnTypes.at(colId)))
+            {
+            included.at(rgId) = false;
+            prunedRGNum++;
+            break;
+            }
+          }
+        }
+      }
+    if (prunedRGNum > 0)
+      {
+      ::CountProfiler::Instance().Count("pruned row groups", prunedRGNum);
+      }
     }
 
-  result->storageArrayScheduler = std::make_shared<StorageArrayScheduler>(bind_data.files, max_threads);
+  int morselRGNum = std::stoi(ConfigFactory::Instance().getProperty("pixel.scan.morsel.rowgroups"));
+  result->storageArrayScheduler = std::make_shared<StorageArrayScheduler>(bind_data.files, bind_data.fileRGNums,
+                                                                          fileRGIncluded, morselRGNum);
 
-  result->file_index.resize(result->storageArrayScheduler->getDeviceSum());
+  int max_threads = std::stoi(ConfigFactory::Instance().getProperty("pixel.threads"));
+  if (max_threads <= 0)
+    {
+    max_threads = (int) std::max<uint64_t>(result->storageArrayScheduler->getMorselSum(), 1);
+    }
 
   result->max_threads = max_threads;
 
@@ -243,6 +329,24 @@ unique_ptr<GlobalTableFunctionState> PixelsScanFunction::PixelsScanInitGlobal(
 
   result->filters = input.filters.get();
 
+  // the scan threads read the footers that are not prefetched yet themselves
+  auto files = bind_data.files;
+  auto fileTails = bind_data.fileTails;
+  auto footerCache = PixelsFooterCache::Instance();
+  auto &cancelled = result->footer_prefetch_cancelled;
+  result->footer_prefetch_thread = std::thread([files, fileTails, footerCache, &cancelled]()
+  {
+    try
+      {
+      PixelsFooterPrefetcher::prefetchRGFooters(files, fileTails, footerCache, cancelled);
+      }
+    catch (const std::exception &e)
+      {
+      // the prefetch is only a hint, the scan reads the missing footers itself
+      std::cerr << "failed to prefetch the row group footers: " << e.what() << std::endl;
+      }
+  });
+
   return std::move(result);
 }
 
@@ -258,6 +362,16 @@ unique_ptr<LocalTableFunctionState> PixelsScanFunction::PixelsScanInitLocal(
 
   result->deviceID = gstate.storageArrayScheduler->acquireDeviceId();
 
+  // the morsels are read into the BufferPool buffers of this thread, one of which holds the
+  // morsel being scanned and the others the morsels read ahead
+  int bufferCount = ::BufferPool::GetBufferCount();
+  for (int bufferId = bufferCount - 1; bufferId >= 0; bufferId--)
+    {
+    result->free_buffer_ids.emplace_back(bufferId);
+    }
+  result->read_ahead_max_depth = bufferCount - 1;
+  result->filter_column_stats = std::make_shared<FilterColumnStats>();
+
   result->column_ids = input.column_ids;
 
   auto fieldNames = bind_data.fileSchema->getFieldNames();
@@ -286,19 +400,19 @@ void PixelsScanFunction::TransformDuckdbType(const std::shared_ptr<TypeDescripti
     {
     switch (columnType->getCategory())
       {
-      //        case TypeDescription::BOOLEAN:
-      //            break;
-      //        case TypeDescription::BYTE:
-      //            break;
+      case TypeDescription::BOOLEAN:return_types.emplace_back(LogicalType::BOOLEAN);
+        break;
+      case TypeDescription::BYTE:return_types.emplace_back(LogicalType::TINYINT);
+        break;
       case TypeDescription::SHORT:
       case TypeDescription::INT:return_types.emplace_back(LogicalType::INTEGER);
         break;
       case TypeDescription::LONG:return_types.emplace_back(LogicalType::BIGINT);
         break;
-        //        case TypeDescription::FLOAT:
-        //            break;
-        //        case TypeDescription::DOUBLE:
-        //            break;
+      case TypeDescription::FLOAT:return_types.emplace_back(LogicalType::FLOAT);
+        break;
+      case TypeDescription::DOUBLE:return_types.emplace_back(LogicalType::DOUBLE);
+        break;
       case TypeDescription::DECIMAL:
         return_types.emplace_back(LogicalType::DECIMAL(columnType->getPrecision(),
                                                        columnType->getScale()));
@@ -348,10 +462,22 @@ void PixelsScanFunction::TransformDuckdbChunk(PixelsReadLocalState &data,
     auto colSchema = schema->getChildren().at(row_batch_id);
     switch (colSchema->getCategory())
       {
-      //        case TypeDescription::BOOLEAN:
-      //            break;
-      //        case TypeDescription::BYTE:
-      //            break;
+      case TypeDescription::BOOLEAN:
+        {
+        auto byteCol = std::static_pointer_cast<ByteColumnVector>(col);
+        Vector vector(LogicalType::BOOLEAN,
+                      (data_ptr_t) (byteCol->current()), col->currentValid(),col->getCapacity());
+        output.data.at(col_id).Reference(vector);
+        break;
+        }
+      case TypeDescription::BYTE:
+        {
+        auto byteCol = std::static_pointer_cast<ByteColumnVector>(col);
+        Vector vector(LogicalType::TINYINT,
+                      (data_ptr_t) (byteCol->current()), col->currentValid(),col->getCapacity());
+        output.data.at(col_id).Reference(vector);
+        break;
+        }
       case TypeDescription::SHORT:
       case TypeDescription::INT:
         {
@@ -380,12 +506,32 @@ void PixelsScanFunction::TransformDuckdbChunk(PixelsReadLocalState &data,
 //			    }
         break;
         }
-        //        case TypeDescription::FLOAT:
-        //            break;
-        //        case TypeDescription::DOUBLE:
-        //            break;
+      case TypeDescription::FLOAT:
+        {
+        auto floatCol = std::static_pointer_cast<FloatColumnVector>(col);
+        Vector vector(LogicalType::FLOAT,
+                      (data_ptr_t) (floatCol->current()), col->currentValid(),col->getCapacity());
+        output.data.at(col_id).Reference(vector);
+        break;
+        }
+      case TypeDescription::DOUBLE:
+        {
+        auto doubleCol = std::static_pointer_cast<DoubleColumnVector>(col);
+        Vector vector(LogicalType::DOUBLE,
+                      (data_ptr_t) (doubleCol->current()), col->currentValid(),col->getCapacity());
+        output.data.at(col_id).Reference(vector);
+        break;
+        }
       case TypeDescription::DECIMAL:
         {
+        if (colSchema->getPrecision() > TypeDescription::SHORT_DECIMAL_MAX_PRECISION)
+          {
+          auto longDecimalCol = std::static_pointer_cast<LongDecimalColumnVector>(col);
+          Vector vector(LogicalType::DECIMAL(colSchema->getPrecision(), colSchema->getScale()),
+                        (data_ptr_t) (longDecimalCol->current()), col->currentValid(),col->getCapacity());
+          output.data.at(col_id).Reference(vector);
+          break;
+          }
         auto decimalCol = std::static_pointer_cast<DecimalColumnVector>(col);
         Vector vector(LogicalType::DECIMAL(colSchema->getPrecision(), colSchema->getScale()),
                       (data_ptr_t) (decimalCol->current()), col->currentValid(),col->getCapacity());
@@ -434,6 +580,16 @@ void PixelsScanFunction::TransformDuckdbChunk(PixelsReadLocalState &data,
       case TypeDescription::STRING:
         {
         auto binaryCol = std::static_pointer_cast<BinaryColumnVector>(col);
+        if (binaryCol->isDictionaryEncoded())
+          {
+          // hand the dictionary ids to DuckDB as a dictionary vector, so that the
+          // strings are not materialized per row, the null rows reference the null entry
+          Vector dictionary(LogicalType::VARCHAR, (data_ptr_t) binaryCol->dictionary,
+                            binaryCol->dictionaryValid, binaryCol->dictionarySize);
+          SelectionVector dictSel((sel_t *) binaryCol->currentDictIds());
+          output.data.at(col_id).Slice(dictionary, dictSel, thisOutputChunkRows);
+          break;
+          }
         Vector vector(LogicalType::VARCHAR,
                       (data_ptr_t) (binaryCol->current()), col->currentValid(),col->getCapacity());
         output.data.at(col_id).Reference(vector);
@@ -463,106 +619,217 @@ bool PixelsScanFunction::PixelsParallelStateNext(ClientContext &context, PixelsR
     }
 
   auto &StorageInstance = parallel_state.storageArrayScheduler;
+  // with read-ahead, up to read_ahead_depth morsels are read while the current one is scanned,
+  // otherwise the next morsel is only opened and it is read when it becomes the current one.
+  // pixels.readahead.enabled only sets how deep it may go, see BufferPool::GetBufferCount
+  bool readAhead = ConfigFactory::Instance().getProperty("pixels.doublebuffer") == "true";
+  size_t targetQueued = readAhead ? scan_data.read_ahead_depth : 1;
+  size_t queued = scan_data.read_ahead_morsels.size();
   // In the following two cases, the state ends:
-  // 1. When PixelsScanInitLocal invokes this function, if all files are
+  // 1. When PixelsScanInitLocal invokes this function, if all morsels are
   // fetched by other threads, this means this thread doesn't need do anything, so just return false;
-  // 2. When PixelsScanImplementation invokes this function (scan_data.next_file_index > -1), if
-  // scan_data.next_file_index >= (int) StorageInstance.getFileSum(scan_data.deviceID), it means the current file is already
-  // done, so the function return false.
-  if ((is_init_state &&
-      parallel_state.file_index.at(scan_data.deviceID) >= StorageInstance->getFileSum(scan_data.deviceID)) ||
-      scan_data.next_file_index >= StorageInstance->getFileSum(scan_data.deviceID))
+  // 2. When PixelsScanImplementation invokes this function, if no morsel is read ahead, it means
+  // the current morsel is the last one of this thread, so the function return false.
+  std::vector<StorageArrayScheduler::Morsel> morsels;
+  if (!is_init_state && queued > 0)
+    {
+    // the first morsel read ahead becomes the current one
+    queued--;
+    }
+  // a morsel that could not be read ahead for the lack of memory is read when it becomes the
+  // current one, no morsel is read ahead of it, so that the thread holds no other buffer then
+  if (readAhead && queued > 0 && scan_data.read_ahead_morsels.back().buffer_id < 0)
+    {
+    targetQueued = 0;
+    }
+  StorageArrayScheduler::Morsel morsel;
+  while ((is_init_state || !scan_data.read_ahead_morsels.empty()) && queued + morsels.size() < targetQueued &&
+         StorageInstance->nextMorsel(scan_data.deviceID, morsel))
+    {
+    morsels.emplace_back(morsel);
+    }
+  if ((is_init_state && morsels.empty()) || (!is_init_state && scan_data.read_ahead_morsels.empty()))
     {
     int remaining_threads = --parallel_state.active_threads;
-    if (remaining_threads==0&&!parallel_state.all_done) {
-      ::BufferPool::Reset();
-      // if async io is enabled, we need to unregister uring buffer
-      if (ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io"))
+    // this thread has no more morsels, its buffers go back to the arena for the other scans.
+    // If async io is enabled, we need to unregister uring buffer first
+    if (ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io"))
+    {
+      if (ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring")
       {
-        if (ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring")
-        {
-          ::DirectUringRandomAccessFile::Reset();
-        } else if (ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio")
-        {
-          throw InvalidArgumentException(
-              "PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
-        }
+        ::DirectUringRandomAccessFile::Reset();
+      } else if (ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio")
+      {
+        throw InvalidArgumentException(
+            "PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
       }
+    }
+    ::BufferPool::Release();
+    if (remaining_threads==0&&!parallel_state.all_done) {
       parallel_state.all_done = true;
     }
     parallel_lock.unlock();
     return false;
     }
-
-  scan_data.curr_file_index = scan_data.next_file_index;
-  scan_data.curr_batch_index = scan_data.next_batch_index;
-  scan_data.next_file_index = parallel_state.file_index.at(scan_data.deviceID);
-  scan_data.next_batch_index = StorageInstance->getBatchID(scan_data.deviceID, scan_data.next_file_index);
-  scan_data.curr_file_name = scan_data.next_file_name;
-  bind_data.curFileId.fetch_add(1);
-  parallel_state.file_index.at(scan_data.deviceID)++;
+  if (!is_init_state)
+    {
+    bind_data.curMorselId.fetch_add(1);
+    }
   parallel_lock.unlock();
   // The below code uses global state but no race happens, so we don't need the lock anymore
 
-
-  if (scan_data.currReader != nullptr)
+  if (!is_init_state)
     {
-    scan_data.currReader->close();
-    }
-
-  if (ConfigFactory::Instance().getProperty("pixels.doublebuffer")=="true")
-  {
-    ::BufferPool::Switch();
-  }
-  // double/single buffer
+    auto &head = scan_data.read_ahead_morsels.front();
+    if (scan_data.currReader != nullptr && scan_data.currReader != head.reader)
+      {
+      scan_data.currReader->close();
+      }
+    else if (scan_data.currPixelsRecordReader != nullptr)
+      {
+      // the next morsel is of the same file, keep the file open for it
+      scan_data.currPixelsRecordReader->close();
+      }
+    if (readAhead && scan_data.curr_buffer_id >= 0)
+      {
+      scan_data.free_buffer_ids.emplace_back(scan_data.curr_buffer_id);
+      }
+    scan_data.currReader = head.reader;
+    scan_data.currPixelsRecordReader = head.recordReader;
+    scan_data.curr_batch_index = head.batch_index;
+    scan_data.curr_file_name = head.file_name;
+    scan_data.curr_buffer_id = head.buffer_id;
+    scan_data.read_ahead_morsels.pop_front();
 
-  scan_data.currReader = scan_data.nextReader;
-  scan_data.currPixelsRecordReader = scan_data.nextPixelsRecordReader;
-  // asyncReadComplete is not invoked in the first run (is_init_state = true)
-  if (scan_data.currPixelsRecordReader != nullptr)
-    {
     auto currPixelsRecordReader = std::static_pointer_cast<PixelsRecordReaderImpl>(
         scan_data.currPixelsRecordReader);
-    if (ConfigFactory::Instance().getProperty("pixels.doublebuffer")=="false")
-    {
+    if (!readAhead)
+      {
       //single buffer
       currPixelsRecordReader->read();
-    }
-
+      }
+    else if (scan_data.curr_buffer_id < 0)
+      {
+      // the memory budget was used up when the morsel was to be read ahead, give the memory of
+      // the idle buffers back to the arena and read the morsel now, waiting for memory if need be
+      scan_data.curr_buffer_id = scan_data.free_buffer_ids.back();
+      scan_data.free_buffer_ids.pop_back();
+      for (int bufferId : scan_data.free_buffer_ids)
+        {
+        ::BufferPool::Release(bufferId);
+        }
+      ::BufferPool::Switch(scan_data.curr_buffer_id);
+      currPixelsRecordReader->read(true);
+      }
+    auto waitStart = std::chrono::steady_clock::now();
     currPixelsRecordReader->asyncReadComplete((int) scan_data.column_names.size());
+    auto waitNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - waitStart).count();
+    if (readAhead)
+      {
+      // read further ahead if the scan had to wait for the morsel, and less far ahead once the
+      // morsels are ready in time for a while, so that the idle reads do not contend for the device
+      auto &freeBufferIds = scan_data.free_buffer_ids;
+      if (::BufferPoolArena::Instance()->getWaiterNum() > 0)
+        {
+        // other scans wait for memory, read less far ahead and give the memory of the idle
+        // buffers that the smaller depth does not need back to the arena
+        scan_data.read_ahead_depth = std::max(scan_data.read_ahead_depth - 1, 1);
+        scan_data.read_ahead_ready_num = 0;
+        int needed = scan_data.read_ahead_depth - (int) (scan_data.read_ahead_morsels.size() + morsels.size());
+        for (int k = 0; k + std::max(needed, 0) < (int) freeBufferIds.size(); k++)
+          {
+          ::BufferPool::Release(freeBufferIds.at(k));
+          }
+        }
+      else if (waitNanos > READ_AHEAD_STALL_NANOS)
+        {
+        // only if the arena gives the buffers of the deeper read-ahead without waiting, the buffers
+        // are taken from the back of the free ones, as the reads below take them
+        int depth = std::min(scan_data.read_ahead_depth + 1, scan_data.read_ahead_max_depth);
+        int needed = depth - (int) scan_data.read_ahead_morsels.size();
+        bool reserved = true;
+        for (int k = 0; reserved && k < needed && k < (int) freeBufferIds.size(); k++)
+          {
+          reserved = ::BufferPool::Reserve(freeBufferIds.at(freeBufferIds.size() - 1 - k));
+          }
+        if (reserved)
+          {
+          scan_data.read_ahead_depth = depth;
+          }
+        scan_data.read_ahead_ready_num = 0;
+        }
+      else if (++scan_data.read_ahead_ready_num >= READ_AHEAD_SHRINK_MORSELS)
+        {
+        scan_data.read_ahead_depth = std::max(scan_data.read_ahead_depth - 1, 1);
+        scan_data.read_ahead_ready_num = 0;
+        }
+      }
     }
-  if (scan_data.next_file_index < StorageInstance->getFileSum(scan_data.deviceID))
+
+  // only the first morsel of the thread may wait for memory, as the thread holds no other buffer,
+  // the others are not read ahead if the memory budget is used up
+  bool mayWait = is_init_state;
+  bool memoryUsedUp = false;
+  for (auto &fetchedMorsel : morsels)
     {
-      auto footerCache = std::make_shared<PixelsFooterCache>();
+    PixelsReadAheadMorsel readAheadMorsel;
+    readAheadMorsel.file_name = fetchedMorsel.fileName;
+    readAheadMorsel.batch_index = fetchedMorsel.batchId;
+    readAheadMorsel.buffer_id = -1;
+    // the consecutive morsels of a file share its reader, so that the file is opened and its
+    // tail is read only once
+    if (!scan_data.read_ahead_morsels.empty())
+      {
+      if (scan_data.read_ahead_morsels.back().file_name == fetchedMorsel.fileName)
+        {
+        readAheadMorsel.reader = scan_data.read_ahead_morsels.back().reader;
+        }
+      }
+    else if (scan_data.currReader != nullptr && scan_data.curr_file_name == fetchedMorsel.fileName)
+      {
+      readAheadMorsel.reader = scan_data.currReader;
+      }
+    if (readAheadMorsel.reader == nullptr)
+      {
+      auto footerCache = PixelsFooterCache::Instance();
       auto builder = std::make_shared<PixelsReaderBuilder>();
       std::shared_ptr<::Storage> storage = StorageFactory::getInstance()->getStorage(::Storage::file);
-      scan_data.next_file_name = StorageInstance->getFileName(scan_data.deviceID, scan_data.next_file_index);
-      scan_data.nextReader = builder->setPath(scan_data.next_file_name)
+      readAheadMorsel.reader = builder->setPath(fetchedMorsel.fileName)
           ->setStorage(storage)
           ->setPixelsFooterCache(footerCache)
           ->build();
+      }
 
-    PixelsReaderOption option = GetPixelsReaderOption(scan_data, parallel_state);
-    scan_data.nextPixelsRecordReader = scan_data.nextReader->read(option);
-    auto nextPixelsRecordReader = std::static_pointer_cast<PixelsRecordReaderImpl>(
-        scan_data.nextPixelsRecordReader);
-
-    if (ConfigFactory::Instance().getProperty("pixels.doublebuffer")=="true")
-    {
-      //double buffer
-      nextPixelsRecordReader->read();
-    }
-
-    } else
-    {
-    scan_data.nextReader = nullptr;
-    scan_data.nextPixelsRecordReader = nullptr;
+    PixelsReaderOption option = GetPixelsReaderOption(scan_data, parallel_state, fetchedMorsel, readAheadMorsel.reader);
+    readAheadMorsel.recordReader = readAheadMorsel.reader->read(option);
+    if (readAhead && !memoryUsedUp)
+      {
+      // submit the reads of the morsel into a buffer that no other morsel is using
+      int bufferId = scan_data.free_buffer_ids.back();
+      ::BufferPool::Switch(bufferId);
+      if (std::static_pointer_cast<PixelsRecordReaderImpl>(readAheadMorsel.recordReader)->read(mayWait))
+        {
+        readAheadMorsel.buffer_id = bufferId;
+        scan_data.free_buffer_ids.pop_back();
+        }
+      else
+        {
+        // the memory budget only holds the morsels read ahead so far
+        memoryUsedUp = true;
+        scan_data.read_ahead_depth = std::max((int) scan_data.read_ahead_morsels.size(), 1);
+        }
+      }
+    mayWait = false;
+    scan_data.read_ahead_morsels.emplace_back(std::move(readAheadMorsel));
     }
   return true;
 }
 
 PixelsReaderOption
-PixelsScanFunction::GetPixelsReaderOption(PixelsReadLocalState &local_state, PixelsReadGlobalState &global_state)
+PixelsScanFunction::GetPixelsReaderOption(PixelsReadLocalState &local_state, PixelsReadGlobalState &global_state,
+                                          const StorageArrayScheduler::Morsel &morsel,
+                                          const std::shared_ptr<PixelsReader> &reader)
 {
   PixelsReaderOption option;
   option.setSkipCorruptRecords(true);
@@ -570,9 +837,11 @@ PixelsScanFunction::GetPixelsReaderOption(PixelsReadLocalState &local_state, Pix
   option.setEnableEncodedColumnVector(true);
   option.setFilter(global_state.filters);
   option.setEnabledFilterPushDown(enable_filter_pushdown);
+  option.setFilterColumnStats(local_state.filter_column_stats);
   // includeCols comes from the caller of PixelsPageSource
   option.setIncludeCols(local_state.column_names);
-  option.setRGRange(0, local_state.nextReader->getRowGroupNum());
+  int rgLen = morsel.rgLen >= 0 ? morsel.rgLen : reader->getRowGroupNum() - morsel.rgStart;
+  option.setRGRange(morsel.rgStart, rgLen);
   option.setQueryId(1);
   int stride = std::stoi(ConfigFactory::Instance().getProperty("pixel.stride"));
   option.setBatchSize(stride);
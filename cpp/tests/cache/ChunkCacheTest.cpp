@@ -0,0 +1,104 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "PixelsChunkCache.h"
+
+#include "gtest/gtest.h"
+#include <cstring>
+#include <string>
+
+namespace
+{
+constexpr uint32_t kChunkSize = 1 << 16;
+// ten chunks with their keys and entries fit in the cache, the eleventh does not
+constexpr uint64_t kCapacity = 10 * (kChunkSize + 256);
+const PixelsFooterCache::FileVersion kVersion{1, 1};
+
+std::shared_ptr<ByteBuffer> makeChunk(uint8_t fill)
+{
+    auto chunk = std::make_shared<ByteBuffer>(kChunkSize);
+    memset(chunk->getPointer(), fill, kChunkSize);
+    return chunk;
+}
+
+void putChunks(PixelsChunkCache &cache, int rgStart, int num)
+{
+    for (int rgId = rgStart; rgId < rgStart + num; rgId++)
+    {
+        cache.put("file", kVersion, rgId, 0, makeChunk((uint8_t) rgId));
+    }
+}
+}
+
+TEST(ChunkCacheTest, ChunkReadAgainEntersMainQueue)
+{
+    PixelsChunkCache cache(kCapacity, 1);
+    cache.put("hot", kVersion, 0, 0, makeChunk(7));
+    // a scan of ten chunks pushes the hot chunk out of the in queue
+    putChunks(cache, 0, 10);
+    EXPECT_EQ(cache.get("hot", kVersion, 0, 0), nullptr);
+    EXPECT_GT(cache.getEvictionCount(), 0);
+
+    // read again after it left the in queue, the chunk enters the main queue
+    cache.put("hot", kVersion, 0, 0, makeChunk(7));
+    putChunks(cache, 10, 30);
+    auto hot = cache.get("hot", kVersion, 0, 0);
+    ASSERT_NE(hot, nullptr);
+    EXPECT_EQ(hot->size(), kChunkSize);
+    EXPECT_EQ(hot->getPointer()[0], 7);
+    // the chunks of the scan are only read once, they do not stay
+    EXPECT_EQ(cache.get("file", kVersion, 10, 0), nullptr);
+    EXPECT_LE(cache.getUsedBytes(), kCapacity);
+}
+
+TEST(ChunkCacheTest, PinnedChunkIsNotEvicted)
+{
+    PixelsChunkCache cache(kCapacity, 1);
+    cache.put("pinned", kVersion, 0, 0, makeChunk(3));
+    {
+        auto pinned = cache.get("pinned", kVersion, 0, 0);
+        ASSERT_NE(pinned, nullptr);
+        putChunks(cache, 0, 30);
+        auto again = cache.get("pinned", kVersion, 0, 0);
+        ASSERT_NE(again, nullptr);
+        EXPECT_EQ(again->getPointer()[kChunkSize - 1], 3);
+        EXPECT_EQ(pinned->getPointer()[0], 3);
+    }
+    // once released, the chunk is the oldest of the in queue and the next put evicts it
+    putChunks(cache, 30, 10);
+    EXPECT_EQ(cache.get("pinned", kVersion, 0, 0), nullptr);
+}
+
+TEST(ChunkCacheTest, RewrittenFileMisses)
+{
+    PixelsChunkCache cache(kCapacity, 1);
+    cache.put("file", kVersion, 0, 0, makeChunk(1));
+    long misses = cache.getMissCount();
+    PixelsFooterCache::FileVersion rewritten{1, 2};
+    EXPECT_EQ(cache.get("file", rewritten, 0, 0), nullptr);
+    EXPECT_EQ(cache.getMissCount(), misses + 1);
+    // the stale chunk is dropped
+    EXPECT_EQ(cache.get("file", kVersion, 0, 0), nullptr);
+    EXPECT_EQ(cache.getHitCount(), 0);
+}
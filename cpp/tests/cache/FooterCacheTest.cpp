@@ -0,0 +1,108 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "PixelsFooterCache.h"
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+std::shared_ptr<FileTail> makeFileTail(uint64_t numberOfRows)
+{
+    auto fileTail = std::make_shared<FileTail>();
+    fileTail->mutable_postscript()->set_numberofrows(numberOfRows);
+    return fileTail;
+}
+
+void writeFile(const std::string &path, const std::string &content)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+}
+}
+
+TEST(FooterCacheTest, RewrittenFileInvalidatesTheTail)
+{
+    PixelsFooterCache cache(1024 * 1024, 1);
+    PixelsFooterCache::FileVersion version{100, 1};
+    cache.putFileTail("file", version, makeFileTail(42));
+    auto cached = cache.getFileTail("file", version);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(cached->postscript().numberofrows(), 42);
+    EXPECT_EQ(cache.getHitCount(), 1);
+
+    // the file is rewritten with the same length, only the modification time tells it apart
+    PixelsFooterCache::FileVersion rewritten{100, 2};
+    EXPECT_EQ(cache.getFileTail("file", rewritten), nullptr);
+    EXPECT_EQ(cache.getMissCount(), 1);
+    // the stale tail is dropped, not kept for the old version
+    EXPECT_EQ(cache.getFileTail("file", version), nullptr);
+    EXPECT_EQ(cache.getUsedBytes(), 0);
+}
+
+TEST(FooterCacheTest, RewrittenFileInvalidatesTheRowGroupFooters)
+{
+    PixelsFooterCache cache(1024 * 1024, 1);
+    PixelsFooterCache::FileVersion version{100, 1};
+    cache.putRGFooter("file", version, 0, std::make_shared<RowGroupFooter>());
+    cache.putRGFooter("file", version, 1, std::make_shared<RowGroupFooter>());
+    EXPECT_NE(cache.getRGFooter("file", version, 0), nullptr);
+
+    PixelsFooterCache::FileVersion longer{200, 1};
+    EXPECT_EQ(cache.getRGFooter("file", longer, 1), nullptr);
+    EXPECT_EQ(cache.getRGFooter("file", version, 1), nullptr);
+    // the footers of the other row groups are checked when they are read
+    EXPECT_NE(cache.getRGFooter("file", version, 0), nullptr);
+}
+
+TEST(FooterCacheTest, InaccessibleFileIsNotCached)
+{
+    PixelsFooterCache cache(1024 * 1024, 1);
+    PixelsFooterCache::FileVersion missing = PixelsFooterCache::getFileVersion("/nonexistent/file.pxl");
+    EXPECT_EQ(missing.length, -1);
+    cache.putFileTail("/nonexistent/file.pxl", missing, makeFileTail(1));
+    EXPECT_EQ(cache.getFileTail("/nonexistent/file.pxl", missing), nullptr);
+    EXPECT_EQ(cache.getUsedBytes(), 0);
+}
+
+TEST(FooterCacheTest, FileVersionChangesWhenTheFileIsRewritten)
+{
+    std::string path = (std::filesystem::temp_directory_path() / "FooterCacheTest.pxl").string();
+    writeFile(path, "tail");
+    PixelsFooterCache::FileVersion version = PixelsFooterCache::getFileVersion(path);
+    EXPECT_EQ(version.length, 4);
+    EXPECT_EQ(PixelsFooterCache::getFileVersion("file://" + path), version);
+
+    PixelsFooterCache cache(1024 * 1024, 1);
+    cache.putFileTail(path, version, makeFileTail(7));
+    writeFile(path, "longer tail");
+    PixelsFooterCache::FileVersion rewritten = PixelsFooterCache::getFileVersion(path);
+    EXPECT_FALSE(rewritten == version);
+    EXPECT_EQ(cache.getFileTail(path, rewritten), nullptr);
+    std::remove(path.c_str());
+}
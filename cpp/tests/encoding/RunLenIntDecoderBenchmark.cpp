@@ -0,0 +1,155 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "encoding/RunLenIntDecoder.h"
+#include "encoding/RunLenIntEncoder.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr int kPixelStride = 10000;
+constexpr int kRounds = 200;
+
+constexpr int kEncodeSlice = 256;
+
+std::shared_ptr<ByteBuffer> encode(std::vector<long> &values)
+{
+  // the encoder keeps its output in a small fixed buffer, so encode in slices
+  // and concatenate them, the runs of each slice are self-contained
+  auto encoder = std::make_unique<RunLenIntEncoder>();
+  std::vector<byte> encoded;
+  std::vector<byte> buffer(kEncodeSlice * sizeof(long) * 2);
+  for (size_t offset = 0; offset < values.size(); offset += kEncodeSlice) {
+    int num = std::min((size_t) kEncodeSlice, values.size() - offset);
+    int resLen = 0;
+    encoder->encode(values.data(), offset, num, buffer.data(), resLen);
+    encoded.insert(encoded.end(), buffer.begin(), buffer.begin() + resLen);
+  }
+  auto input = std::make_shared<ByteBuffer>(encoded.size());
+  input->putBytes(encoded.data(), encoded.size());
+  return input;
+}
+
+/**
+ * Decode the pixel kRounds times with the scalar next() and the bulk next(),
+ * check that both produce the input values and print the time per value.
+ */
+void compare(const std::string &name, std::vector<long> &values)
+{
+  auto input = encode(values);
+  int len = values.size();
+  std::vector<int64_t> scalar(len);
+  std::vector<int64_t> bulk(len);
+
+  auto scalarStart = std::chrono::steady_clock::now();
+  for (int r = 0; r < kRounds; r++) {
+    input->setReadPos(0);
+    RunLenIntDecoder decoder(input, true);
+    for (int i = 0; i < len; i++) {
+      scalar[i] = decoder.next();
+    }
+  }
+  auto scalarEnd = std::chrono::steady_clock::now();
+
+  auto bulkStart = std::chrono::steady_clock::now();
+  for (int r = 0; r < kRounds; r++) {
+    input->setReadPos(0);
+    RunLenIntDecoder decoder(input, true);
+    decoder.next(bulk.data(), len);
+  }
+  auto bulkEnd = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < len; i++) {
+    ASSERT_EQ(scalar[i], values[i]) << name << " scalar at " << i;
+    ASSERT_EQ(bulk[i], values[i]) << name << " bulk at " << i;
+  }
+  double scalarNs = std::chrono::duration<double, std::nano>(scalarEnd - scalarStart).count() / kRounds / len;
+  double bulkNs = std::chrono::duration<double, std::nano>(bulkEnd - bulkStart).count() / kRounds / len;
+  std::cerr << "[BENCH] " << name << ": scalar " << scalarNs << " ns/value, bulk "
+            << bulkNs << " ns/value, speedup " << scalarNs / bulkNs << "x" << std::endl;
+}
+
+std::vector<long> generate(const std::function<long(int)> &gen)
+{
+  std::vector<long> values(kPixelStride);
+  for (int i = 0; i < kPixelStride; i++) {
+    values[i] = gen(i);
+  }
+  return values;
+}
+} // namespace
+
+TEST(RunLenIntDecoderBenchmark, ShortRepeat) {
+  auto values = generate([](int i) { return (long) (i / 5) % 7; });
+  compare("short repeat", values);
+}
+
+TEST(RunLenIntDecoderBenchmark, FixedDelta) {
+  auto values = generate([](int i) { return 1000L + 3L * i; });
+  compare("fixed delta", values);
+}
+
+TEST(RunLenIntDecoderBenchmark, VariableDelta) {
+  std::mt19937_64 rng(7);
+  long current = 0;
+  auto values = generate([&](int) { current += rng() % 100; return current; });
+  compare("variable delta", values);
+}
+
+TEST(RunLenIntDecoderBenchmark, Direct8Bits) {
+  std::mt19937_64 rng(11);
+  auto values = generate([&](int) { return (long) (rng() % 100) - 50; });
+  compare("direct 8 bits", values);
+}
+
+TEST(RunLenIntDecoderBenchmark, Direct32Bits) {
+  std::mt19937_64 rng(13);
+  auto values = generate([&](int) { return (long) (int32_t) rng(); });
+  compare("direct 32 bits", values);
+}
+
+TEST(RunLenIntDecoderBenchmark, BulkIntoInt32) {
+  std::mt19937_64 rng(17);
+  auto values = generate([&](int) { return (long) (rng() % 60000) - 30000; });
+  auto input = encode(values);
+  std::vector<int32_t> result(values.size());
+  RunLenIntDecoder decoder(input, true);
+  // decode in uneven slices so that runs are split across calls
+  int pos = 0;
+  int slice = 1;
+  while (pos < (int) values.size()) {
+    int num = std::min(slice, (int) values.size() - pos);
+    decoder.next(result.data() + pos, num);
+    pos += num;
+    slice = slice * 3 % 1021 + 1;
+  }
+  for (size_t i = 0; i < values.size(); i++) {
+    ASSERT_EQ(result[i], values[i]) << "at " << i;
+  }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "encoding/RunLenIntDecoder.h"
+#include "encoding/RunLenIntEncoder.h"
+
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+std::shared_ptr<ByteBuffer> encode(std::vector<long> &values)
+{
+  auto encoder = std::make_unique<RunLenIntEncoder>();
+  std::vector<byte> buffer(values.size() * sizeof(long) * 2 + 64);
+  int resLen = 0;
+  encoder->encode(values.data(), buffer.data(), values.size(), resLen);
+  auto input = std::make_shared<ByteBuffer>(resLen);
+  input->putBytes(buffer.data(), resLen);
+  return input;
+}
+
+bool isPatchedBase(const std::shared_ptr<ByteBuffer> &input)
+{
+  return ((input->getPointer()[0] >> 6) & 0x03) == RunLenIntEncoder::PATCHED_BASE;
+}
+
+/**
+ * Small random values with a few large outliers, which makes the encoder
+ * choose PATCHED_BASE for the run.
+ */
+std::vector<long> outliers(int len, long base, const std::vector<int> &positions, long outlier)
+{
+  std::mt19937_64 rng(len + positions.size());
+  std::vector<long> values(len);
+  for (int i = 0; i < len; i++) {
+    values[i] = base + (long) (rng() % 100);
+  }
+  for (int pos : positions) {
+    values[pos] = base + outlier + pos;
+  }
+  return values;
+}
+
+void checkRoundTrip(std::vector<long> &values)
+{
+  auto input = encode(values);
+  ASSERT_TRUE(isPatchedBase(input));
+  int len = values.size();
+
+  // scalar path
+  {
+    input->setReadPos(0);
+    RunLenIntDecoder decoder(input, true);
+    for (int i = 0; i < len; i++) {
+      ASSERT_EQ(decoder.next(), values[i]) << "scalar at " << i;
+    }
+  }
+  // bulk path into long
+  {
+    input->setReadPos(0);
+    RunLenIntDecoder decoder(input, true);
+    std::vector<int64_t> result(len);
+    decoder.next(result.data(), len);
+    for (int i = 0; i < len; i++) {
+      ASSERT_EQ(result[i], values[i]) << "bulk at " << i;
+    }
+  }
+  // skipping the whole run
+  {
+    input->setReadPos(0);
+    RunLenIntDecoder decoder(input, true);
+    decoder.skip(len);
+    EXPECT_EQ(input->getReadPos(), input->size());
+  }
+}
+} // namespace
+
+TEST(RunLenIntDecoderTest, PatchedBase) {
+  auto values = outliers(512, 0, {7, 100, 250, 400, 500}, 1L << 20);
+  checkRoundTrip(values);
+}
+
+TEST(RunLenIntDecoderTest, PatchedBaseNegativeBase) {
+  auto values = outliers(512, -5000, {3, 200, 480}, 1L << 24);
+  checkRoundTrip(values);
+}
+
+TEST(RunLenIntDecoderTest, PatchedBaseLongGap) {
+  // the gaps longer than 255 are stored as several entries in the patch list
+  auto values = outliers(512, 10, {2, 300}, 1L << 30);
+  checkRoundTrip(values);
+}
+
+TEST(RunLenIntDecoderTest, PatchedBaseMaxGap) {
+  auto values = outliers(512, 10, {0, 511}, 1L << 18);
+  checkRoundTrip(values);
+}
+
+TEST(RunLenIntDecoderTest, PatchedBaseWideValues) {
+  auto values = outliers(512, 1L << 40, {50, 150, 250, 350, 450}, 1L << 50);
+  checkRoundTrip(values);
+}
+
+TEST(RunLenIntDecoderTest, PatchedBaseIntoInt32) {
+  auto values = outliers(512, -1000, {10, 20, 30, 270, 290}, 1L << 28);
+  auto input = encode(values);
+  ASSERT_TRUE(isPatchedBase(input));
+  RunLenIntDecoder decoder(input, true);
+  std::vector<int32_t> result(values.size());
+  // a partial read goes through the literals, the rest is decoded in bulk
+  decoder.next(result.data(), 100);
+  decoder.next(result.data() + 100, values.size() - 100);
+  for (size_t i = 0; i < values.size(); i++) {
+    ASSERT_EQ(result[i], values[i]) << "at " << i;
+  }
+}
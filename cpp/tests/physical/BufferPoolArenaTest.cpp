@@ -0,0 +1,141 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "physical/BufferPool/BufferPoolArena.h"
+#include "exception/InvalidArgumentException.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <future>
+#include <thread>
+
+namespace
+{
+constexpr size_t kSlabSize = BufferPoolArena::MIN_CLASS_SIZE;
+constexpr long kWaitMillis = 20;
+constexpr int kBlockSize = 4096;
+
+std::shared_ptr<BufferPoolArena> makeArena(size_t slabNum)
+{
+    return std::make_shared<BufferPoolArena>(slabNum * kSlabSize, kWaitMillis, kBlockSize);
+}
+
+void waitForWaiter(const std::shared_ptr<BufferPoolArena> &arena)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (arena->getWaiterNum() == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+}
+
+TEST(BufferPoolArenaTest, TryAllocateDoesNotWaitWhenBudgetIsUsedUp)
+{
+    auto arena = makeArena(2);
+    auto first = arena->tryAllocate(kSlabSize);
+    auto second = arena->tryAllocate(kSlabSize);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(arena->getReservedBytes(), 2 * kSlabSize);
+    EXPECT_EQ(arena->tryAllocate(kSlabSize), nullptr);
+    EXPECT_EQ(arena->getWaiterNum(), 0);
+
+    // a released slab is taken again without exceeding the budget
+    first.reset();
+    auto third = arena->tryAllocate(kSlabSize);
+    ASSERT_NE(third, nullptr);
+    EXPECT_EQ(arena->getReservedBytes(), 2 * kSlabSize);
+}
+
+TEST(BufferPoolArenaTest, BufferLargerThanBudgetThrows)
+{
+    auto arena = makeArena(2);
+    EXPECT_THROW(arena->allocate(3 * kSlabSize), InvalidArgumentException);
+    EXPECT_THROW(arena->tryAllocate(3 * kSlabSize), InvalidArgumentException);
+}
+
+TEST(BufferPoolArenaTest, AllocationWaitsUntilAnotherScanReleases)
+{
+    auto arena = makeArena(2);
+    auto first = arena->allocate(kSlabSize);
+    auto second = arena->allocate(kSlabSize);
+    auto waiting = std::async(std::launch::async, [&arena]()
+    {
+        return arena->allocate(kSlabSize);
+    });
+    waitForWaiter(arena);
+    ASSERT_EQ(arena->getWaiterNum(), 1);
+    EXPECT_EQ(waiting.wait_for(std::chrono::milliseconds(5 * kWaitMillis)), std::future_status::timeout);
+
+    // the waiter is woken by the release and takes the slab
+    first.reset();
+    ASSERT_EQ(waiting.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    auto buffer = waiting.get();
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(buffer->size(), kSlabSize);
+    EXPECT_EQ(arena->getWaiterNum(), 0);
+    EXPECT_EQ(arena->getReservedBytes(), 2 * kSlabSize);
+}
+
+TEST(BufferPoolArenaTest, AllocationDrainsTheMagazinesOfOtherThreads)
+{
+    auto arena = makeArena(2);
+    std::promise<void> released;
+    std::promise<void> done;
+    auto owner = std::thread([&arena, &released, &done]()
+    {
+        // the slabs released without a waiter stay idle in the magazine of this thread
+        {
+            auto first = arena->allocate(kSlabSize);
+            auto second = arena->allocate(kSlabSize);
+        }
+        released.set_value();
+        done.get_future().wait();
+    });
+    released.get_future().wait();
+    EXPECT_EQ(arena->getReservedBytes(), 2 * kSlabSize);
+
+    // the budget is used up by the idle slabs, the allocation takes them instead of waiting
+    auto first = arena->tryAllocate(kSlabSize);
+    auto second = arena->tryAllocate(kSlabSize);
+    EXPECT_NE(first, nullptr);
+    EXPECT_NE(second, nullptr);
+    EXPECT_EQ(arena->getReservedBytes(), 2 * kSlabSize);
+    done.set_value();
+    owner.join();
+}
+
+TEST(BufferPoolArenaTest, IdleSlabsOfOtherClassesAreFreed)
+{
+    auto arena = makeArena(4);
+    {
+        auto small = arena->allocate(kSlabSize);
+        auto other = arena->allocate(kSlabSize);
+    }
+    // the idle slabs of the smaller class make room for a larger buffer
+    auto large = arena->tryAllocate(3 * kSlabSize);
+    ASSERT_NE(large, nullptr);
+    EXPECT_LE(arena->getReservedBytes(), arena->getBudget());
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright 2026 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * @author gengdy
+ * @create 2026-10-16
+ */
+#include "stats/StatsRecorder.h"
+#include "stats/IntegerStatsRecorder.h"
+#include "stats/Integer128StatsRecorder.h"
+#include "stats/DoubleStatsRecorder.h"
+#include "stats/StringStatsRecorder.h"
+#include "vector/IntColumnVector.h"
+#include "vector/LongColumnVector.h"
+#include "writer/IntColumnWriter.h"
+#include "PixelsWriterImpl.h"
+#include "PixelsReaderBuilder.h"
+#include "physical/StorageFactory.h"
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+
+TEST(StatsRecorderTest, IntegerRoundTrip)
+{
+    int values[] = {7, -3, 12, 0, 5};
+    uint8_t isNull[] = {0, 0, 1, 0, 0};
+    auto recorder = StatsRecorder::create(*TypeDescription::createInt());
+    recorder->updateInteger(values, isNull, 5);
+
+    auto statistic = recorder->serialize();
+    EXPECT_EQ(statistic.numberofvalues(), 5);
+    EXPECT_EQ(statistic.intstatistics().minimum(), -3);
+    EXPECT_EQ(statistic.intstatistics().maximum(), 7);
+    EXPECT_EQ(statistic.intstatistics().sum(), 9);
+
+    auto restored = StatsRecorder::create(*TypeDescription::createInt(), statistic);
+    auto intStat = dynamic_cast<IntegerStatsRecorder *>(restored.get());
+    ASSERT_NE(intStat, nullptr);
+    EXPECT_EQ(intStat->getMinimum(), -3);
+    EXPECT_EQ(intStat->getMaximum(), 7);
+    EXPECT_TRUE(intStat->isSumDefined());
+    EXPECT_EQ(intStat->getSum(), 9);
+}
+
+TEST(StatsRecorderTest, IntegerSumOverflow)
+{
+    long values[] = {LONG_MAX, 1};
+    IntegerStatsRecorder recorder;
+    recorder.updateInteger(values, nullptr, 2);
+    EXPECT_FALSE(recorder.isSumDefined());
+    EXPECT_FALSE(recorder.serialize().intstatistics().has_sum());
+    EXPECT_EQ(recorder.getMinimum(), 1);
+    EXPECT_EQ(recorder.getMaximum(), LONG_MAX);
+}
+
+TEST(StatsRecorderTest, Integer128RoundTrip)
+{
+    // -1 (fits in 64 bits) and 2^64 + 5 (does not)
+    long values[] = {-1L, -1L, 1L, 5L};
+    auto type = TypeDescription::createDecimal(30, 2);
+    auto recorder = StatsRecorder::create(*type);
+    recorder->updateInteger128(values, nullptr, 2);
+
+    auto restored = StatsRecorder::create(*type, recorder->serialize());
+    auto int128Stat = dynamic_cast<Integer128StatsRecorder *>(restored.get());
+    ASSERT_NE(int128Stat, nullptr);
+    EXPECT_TRUE(int128Stat->getMinimum() == (__int128) -1);
+    EXPECT_TRUE(int128Stat->getMaximum() == (((__int128) 1) << 64) + 5);
+}
+
+TEST(StatsRecorderTest, DoubleAndStringRoundTrip)
+{
+    double doubles[] = {1.5, -2.25, 8.0};
+    auto doubleRecorder = StatsRecorder::create(*TypeDescription::createDouble());
+    doubleRecorder->updateDouble(doubles, nullptr, 3);
+    auto doubleStat = DoubleStatsRecorder(doubleRecorder->serialize());
+    EXPECT_DOUBLE_EQ(doubleStat.getMinimum(), -2.25);
+    EXPECT_DOUBLE_EQ(doubleStat.getMaximum(), 8.0);
+    EXPECT_DOUBLE_EQ(doubleStat.getSum(), 7.25);
+
+    std::string strings[] = {"pear", "apple", "zebra", "mango"};
+    uint8_t isNull[] = {0, 0, 1, 0};
+    auto stringRecorder = StatsRecorder::create(*TypeDescription::createString());
+    stringRecorder->updateString(strings, isNull, 4);
+    auto stringStat = StringStatsRecorder(stringRecorder->serialize());
+    EXPECT_EQ(stringStat.getMinimum(), "apple");
+    EXPECT_EQ(stringStat.getMaximum(), "pear");
+    EXPECT_EQ(stringStat.getSum(), 14);
+}
+
+TEST(StatsRecorderTest, MergeIncompatible)
+{
+    long values[] = {1L};
+    std::string strings[] = {"a"};
+    IntegerStatsRecorder intStat;
+    StringStatsRecorder stringStat;
+    Integer128StatsRecorder int128Stat;
+
+    // recorders without min/max accept anything, like the Java column stats
+    EXPECT_NO_THROW(stringStat.merge(intStat));
+    EXPECT_NO_THROW(int128Stat.merge(intStat));
+
+    intStat.updateInteger(values, nullptr, 1);
+    stringStat.updateString(strings, nullptr, 1);
+    int128Stat.updateInteger(values, nullptr, 1);
+    EXPECT_THROW(intStat.merge(stringStat), std::invalid_argument);
+    EXPECT_THROW(stringStat.merge(intStat), std::invalid_argument);
+    EXPECT_THROW(int128Stat.merge(intStat), std::invalid_argument);
+}
+
+TEST(StatsRecorderTest, ColumnWriterPixelStats)
+{
+    int len = 10;
+    int pixelStride = 4;
+    auto vector = std::make_shared<IntColumnVector>(len, true);
+    for (int i = 0; i < len; ++i)
+    {
+        vector->add(i * 10);
+    }
+    auto option = std::make_shared<PixelsWriterOption>();
+    option->setPixelsStride(pixelStride);
+    option->setNullsPadding(false);
+    option->setEncodingLevel(EncodingLevel(EncodingLevel::EL2));
+
+    auto writer = std::make_unique<IntColumnWriter>(TypeDescription::createInt(), option);
+    writer->write(vector, len);
+    writer->flush();
+
+    auto chunkIndex = writer->getColumnChunkIndexPtr();
+    ASSERT_EQ(chunkIndex->pixelstatistics_size(), 3);
+    int expectedMin[] = {0, 40, 80};
+    int expectedMax[] = {30, 70, 90};
+    for (int i = 0; i < 3; i++)
+    {
+        const auto &intStat = chunkIndex->pixelstatistics(i).statistic().intstatistics();
+        EXPECT_EQ(intStat.minimum(), expectedMin[i]);
+        EXPECT_EQ(intStat.maximum(), expectedMax[i]);
+    }
+    auto chunkStat = writer->getColumnChunkStat();
+    EXPECT_EQ(chunkStat.numberofvalues(), len);
+    EXPECT_EQ(chunkStat.intstatistics().minimum(), 0);
+    EXPECT_EQ(chunkStat.intstatistics().maximum(), 90);
+    EXPECT_EQ(chunkStat.intstatistics().sum(), 450);
+    writer->close();
+}
+
+TEST(StatsRecorderTest, FooterStats)
+{
+    std::string path = (std::filesystem::temp_directory_path() / "pixels_stats_recorder_test.pxl").string();
+    int rowNum = 20;
+    int rowGroupSize = 10;
+    auto schema = TypeDescription::fromString("struct<a:int>");
+    std::vector<bool> encodeVector(1, true);
+    auto rowBatch = schema->createRowBatch(rowGroupSize, encodeVector);
+    {
+        auto writer = std::make_unique<PixelsWriterImpl>(schema, 4, rowGroupSize, path, 1024, true,
+                                                         EncodingLevel(EncodingLevel::EL2), true, true, 16);
+        auto va = std::dynamic_pointer_cast<LongColumnVector>(rowBatch->cols[0]);
+        ASSERT_TRUE(va);
+        for (int i = 0; i < rowNum; ++i)
+        {
+            va->add(i);
+            if (rowBatch->rowCount == rowBatch->getMaxSize())
+            {
+                writer->addRowBatch(rowBatch);
+                rowBatch->reset();
+            }
+        }
+        writer->close();
+    }
+
+    auto footerCache = std::make_shared<PixelsFooterCache>();
+    auto builder = std::make_shared<PixelsReaderBuilder>();
+    std::shared_ptr<::Storage> storage = StorageFactory::getInstance()->getStorage(::Storage::file);
+    auto reader = builder->setPath(path)->setStorage(storage)->setPixelsFooterCache(footerCache)->build();
+
+    auto columnStats = reader->getColumnStats();
+    ASSERT_EQ(columnStats.size(), 1);
+    EXPECT_EQ(columnStats.Get(0).numberofvalues(), rowNum);
+    EXPECT_EQ(columnStats.Get(0).intstatistics().minimum(), 0);
+    EXPECT_EQ(columnStats.Get(0).intstatistics().maximum(), rowNum - 1);
+
+    ASSERT_EQ(reader->getRowGroupNum(), rowNum / rowGroupSize);
+    for (int rg = 0; rg < reader->getRowGroupNum(); rg++)
+    {
+        const auto &chunkStat = reader->getRowGroupStat(rg).columnchunkstats(0);
+        EXPECT_EQ(chunkStat.intstatistics().minimum(), rg * rowGroupSize);
+        EXPECT_EQ(chunkStat.intstatistics().maximum(), (rg + 1) * rowGroupSize - 1);
+    }
+    reader->close();
+    std::remove(path.c_str());
+}
@@ -191,6 +191,10 @@ public class PixelsReaderImpl implements PixelsReader
             {
                 throw new PixelsFileMagicInvalidException(fileMagic);
             }
+            if (postScript.getBlockCompressed())
+            {
+                throw new PixelsReaderException("block compressed column chunks are not supported");
+            }
 
             builderSchema = TypeDescription.createSchema(fileTail.getFooter().getTypesList());
 
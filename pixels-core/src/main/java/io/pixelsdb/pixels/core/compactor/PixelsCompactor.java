@@ -316,6 +316,11 @@ public class PixelsCompactor
                     fsReader.close();
                     throw new PixelsFileMagicInvalidException(fileMagic);
                 }
+                if (postScript.getBlockCompressed())
+                {
+                    fsReader.close();
+                    throw new PixelsReaderException("block compressed column chunks are not supported");
+                }
                 if (builderHasHiddenColumn && !hasHiddenColumn)
                 {
                     fsReader.close();